@@ -298,6 +298,33 @@ public class FabricUIManager implements UIManager, LifecycleEventListener {
         getYogaMeasureMode(minHeight, maxHeight));
   }
 
+  /**
+   * Measures several views of the same component at once. {@code localDataAndProps} contains the
+   * local data and props of every view (interleaved), {@code layoutConstraints} contains minimum
+   * width, maximum width, minimum height and maximum height of every view. The views are measured
+   * one after another with {@link #measure}; batching saves the round trips between C++ and Java.
+   */
+  @DoNotStrip
+  @SuppressWarnings("unused")
+  private long[] measureBatch(
+      String componentName, ReadableArray localDataAndProps, float[] layoutConstraints) {
+    int count = layoutConstraints.length / 4;
+    long[] measurements = new long[count];
+    for (int i = 0; i < count; i++) {
+      measurements[i] =
+          measure(
+              componentName,
+              localDataAndProps.getMap(i * 2),
+              localDataAndProps.getMap(i * 2 + 1),
+              null,
+              layoutConstraints[i * 4],
+              layoutConstraints[i * 4 + 1],
+              layoutConstraints[i * 4 + 2],
+              layoutConstraints[i * 4 + 3]);
+    }
+    return measurements;
+  }
+
   @Override
   public void synchronouslyUpdateViewOnUIThread(int reactTag, ReadableMap props) {
     long time = SystemClock.uptimeMillis();
@@ -12,6 +12,7 @@
 #include <jsi/JSIDynamic.h>
 #include <jsi/jsi.h>
 #include <react/components/scrollview/ScrollViewProps.h>
+#include <react/components/view/YogaLayoutThreadPool.h>
 #include <react/debug/SystraceSection.h>
 #include <react/core/EventBeat.h>
 #include <react/core/EventEmitter.h>
@@ -80,6 +81,7 @@ void Binding::setConstraints(
 
     LayoutContext context;
     context.pointScaleFactor = {pointScaleFactor_};
+    context.parallelLayout = parallelLayout_;
     LayoutConstraints constraints = {};
     constraints.minimumSize = minimumSize;
     constraints.maximumSize = maximumSize;
@@ -131,6 +133,16 @@ void Binding::installFabricUIManager(
 
   std::shared_ptr<const ReactNativeConfig> config = std::make_shared<const ReactNativeConfigHolder>(reactNativeConfig);
   contextContainer->registerInstance(config, "ReactNativeConfig");
+
+  // Independent subtrees are laid out on a pool of worker threads. Text is
+  // measured through JNI there, so the workers are attached to the JVM.
+  parallelLayout_ = config->getBool("react_fabric:enable_parallel_layout_android");
+  if (parallelLayout_) {
+    YogaLayoutThreadPool::setSharedWorkerRunner(
+        [](std::function<void()>&& workerLoop) {
+          jni::ThreadScope::WithClassLoader(std::move(workerLoop));
+        });
+  }
   contextContainer->registerInstance<EventBeatFactory>(
       synchronousBeatFactory, "synchronous");
   contextContainer->registerInstance<EventBeatFactory>(
@@ -31,6 +31,7 @@ class Binding : public jni::HybridClass<Binding>, public SchedulerDelegate {
   std::shared_ptr<Scheduler> scheduler_;
 
   float pointScaleFactor_ = 1;
+  bool parallelLayout_ = false;
 
  private:
   void setConstraints(
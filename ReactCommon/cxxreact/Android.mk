@@ -38,6 +38,8 @@ LOCAL_SHARED_LIBRARIES := jsinspector libfb libfolly_json libglog
 LOCAL_V8_FILES := \
     File.cpp \
     V8NativeModules.cpp \
+    V8ScriptCacheStore.cpp \
+    V8StartupProfile.cpp \
     V8Executor.cpp 
     
 ifeq ($(JS_ENGINE), V8)
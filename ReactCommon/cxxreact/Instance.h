@@ -46,6 +46,11 @@ struct JSEConfigParams {
   std::string cachePath;
   CachingType cacheType;
   int loggingLevel;
+  // When non zero, the code cache is created this long after the script is first compiled,
+  // and written to disk off the JS thread, instead of inline before the script runs.
+  int cacheCreationDelayInMs = 0;
+  // Upper bound for the size of the cache directory. Least recently used caches are evicted beyond it. 0 means no limit.
+  uint64_t cacheSizeLimitInBytes = 0;
 };
 
 class RN_EXPORT Instance {
@@ -6,50 +6,69 @@
 #include "JSIndexedRAMBundle.h"
 
 #include <glog/logging.h>
+#include <cstring>
 #include <fstream>
-#include <sstream>
 #include <folly/Memory.h>
+#include <folly/portability/SysMman.h>
+#include <folly/portability/Unistd.h>
 
 namespace facebook {
 namespace react {
 
+namespace {
+
+std::unique_ptr<const JSBigString> loadBundle(const char *sourcePath) {
+#ifdef _WIN32
+  // JSBigFileString is not available here, read the whole file up front.
+  std::ifstream file(sourcePath, std::ifstream::binary | std::ifstream::ate);
+  if (!file) {
+    throw std::ios_base::failure(
+      folly::to<std::string>("Bundle ", sourcePath,
+                             "cannot be opened: ", file.rdstate()));
+  }
+  const size_t size = static_cast<size_t>(file.tellg());
+  auto buffer = folly::make_unique<JSBigBufferString>(size);
+  if (!file.seekg(0) || !file.read(buffer->data(), size)) {
+    throw std::ios_base::failure(
+      folly::to<std::string>("Error reading RAM Bundle: ", file.rdstate()));
+  }
+  return std::move(buffer);
+#else
+  return JSBigFileString::fromPath(sourcePath);
+#endif
+}
+
+}
+
 std::function<std::unique_ptr<JSModulesUnbundle>(std::string)> JSIndexedRAMBundle::buildFactory() {
   return [](const std::string& bundlePath){
     return folly::make_unique<JSIndexedRAMBundle>(bundlePath.c_str());
   };
 }
 
-JSIndexedRAMBundle::JSIndexedRAMBundle(const char *sourcePath) {
-  m_bundle = std::make_unique<std::ifstream>(sourcePath, std::ifstream::binary);
-  if (!m_bundle) {
-    throw std::ios_base::failure(
-      folly::to<std::string>("Bundle ", sourcePath,
-                             "cannot be opened: ", m_bundle->rdstate()));
-  }
+JSIndexedRAMBundle::JSIndexedRAMBundle(const char *sourcePath) :
+  m_bundle(loadBundle(sourcePath)) {
   init();
 }
 
-JSIndexedRAMBundle::JSIndexedRAMBundle(std::unique_ptr<const JSBigString> script) {
-  // tmpStream is needed because m_bundle is std::istream type
-  // which has no member 'write'
-  std::unique_ptr<std::stringstream> tmpStream = std::make_unique<std::stringstream>();
-  tmpStream->write(script->c_str(), script->size());
-  m_bundle = std::move(tmpStream);
-  if (!m_bundle) {
-    throw std::ios_base::failure(
-      folly::to<std::string>("Bundle from string cannot be opened: ", m_bundle->rdstate()));
-  }
+JSIndexedRAMBundle::JSIndexedRAMBundle(std::unique_ptr<const JSBigString> script) :
+  m_bundle(std::move(script)) {
   init();
 }
 
 void JSIndexedRAMBundle::init() {
+  // Resolve the data pointer once, JSBigFileString maps the file lazily and
+  // the lookups below must not race on that.
+  m_bundleData = m_bundle->c_str();
+  m_bundleSize = m_bundle->size();
+
   // read in magic header, number of entries, and length of the startup section
   uint32_t header[3];
   static_assert(
     sizeof(header) == 12,
     "header size must exactly match the input file format");
 
-  readBundle(reinterpret_cast<char *>(header), sizeof(header));
+  readBundle(reinterpret_cast<char *>(header), sizeof(header), 0);
   const size_t numTableEntries = folly::Endian::little(header[1]);
   const size_t startupCodeSize = folly::Endian::little(header[2]);
 
@@ -59,27 +78,55 @@ void JSIndexedRAMBundle::init() {
 
   // read the lookup table from the file
   readBundle(
-    reinterpret_cast<char *>(m_table.data.get()), m_table.byteLength());
+    reinterpret_cast<char *>(m_table.data.get()), m_table.byteLength(), sizeof(header));
 
   // read the startup code
   m_startupCode = std::unique_ptr<JSBigBufferString>(new JSBigBufferString{startupCodeSize - 1});
 
-  readBundle(m_startupCode->data(), startupCodeSize - 1);
+  readBundle(m_startupCode->data(), startupCodeSize - 1, m_baseOffset);
 }
 
 JSIndexedRAMBundle::Module JSIndexedRAMBundle::getModule(uint32_t moduleId) const {
   Module ret;
   ret.name = folly::to<std::string>(moduleId, ".js");
+  ret.code = getModuleCode(moduleId).str();
+  return ret;
+}
+
+JSIndexedRAMBundle::ModuleView JSIndexedRAMBundle::getModuleView(uint32_t moduleId) const {
+  ModuleView ret;
+  ret.name = folly::to<std::string>(moduleId, ".js");
   ret.code = getModuleCode(moduleId);
   return ret;
 }
 
+void JSIndexedRAMBundle::prefetchModules(const std::vector<uint32_t>& moduleIds) const {
+#ifdef MADV_WILLNEED
+  const static uintptr_t pageSize = getpagesize();
+  for (auto moduleId : moduleIds) {
+    folly::StringPiece code;
+    try {
+      code = getModuleCode(moduleId);
+    } catch (const std::exception&) {
+      // Prefetching is only a hint, a module the bundle doesn't have will
+      // fail properly once it is actually required.
+      continue;
+    }
+
+    // madvise needs a page aligned start address.
+    const auto begin = reinterpret_cast<uintptr_t>(code.begin()) & ~(pageSize - 1);
+    const auto end = reinterpret_cast<uintptr_t>(code.end());
+    madvise(reinterpret_cast<void *>(begin), end - begin, MADV_WILLNEED);
+  }
+#endif
+}
+
 std::unique_ptr<const JSBigString> JSIndexedRAMBundle::getStartupCode() {
   CHECK(m_startupCode) << "startup code for a RAM Bundle can only be retrieved once";
   return std::move(m_startupCode);
 }
 
-std::string JSIndexedRAMBundle::getModuleCode(const uint32_t id) const {
+folly::StringPiece JSIndexedRAMBundle::getModuleCode(const uint32_t id) const {
   const auto moduleData = id < m_table.numEntries ? &m_table.data[id] : nullptr;
 
   // entries without associated code have offset = 0 and length = 0
@@ -89,31 +136,22 @@ std::string JSIndexedRAMBundle::getModuleCode(const uint32_t id) const {
       folly::to<std::string>("Error loading module", id, "from RAM Bundle"));
   }
 
-  std::string ret(length - 1, '\0');
-  readBundle(&ret.front(), length - 1, m_baseOffset + folly::Endian::little(moduleData->offset));
-  return ret;
-}
-
-void JSIndexedRAMBundle::readBundle(char *buffer, const std::streamsize bytes) const {
-  if (!m_bundle->read(buffer, bytes)) {
-    if (m_bundle->rdstate() & std::ios::eofbit) {
-      throw std::ios_base::failure("Unexpected end of RAM Bundle file");
-    }
-    throw std::ios_base::failure(
-      folly::to<std::string>("Error reading RAM Bundle: ", m_bundle->rdstate()));
+  // length includes the trailing NULL byte
+  const size_t position = m_baseOffset + folly::Endian::little(moduleData->offset);
+  if (position > m_bundleSize || length - 1 > m_bundleSize - position) {
+    throw std::ios_base::failure("Unexpected end of RAM Bundle file");
   }
+  return folly::StringPiece(m_bundleData + position, length - 1);
 }
 
 void JSIndexedRAMBundle::readBundle(
     char *buffer,
-    const std::streamsize bytes,
-    const std::ifstream::pos_type position) const {
-
-  if (!m_bundle->seekg(position)) {
-    throw std::ios_base::failure(
-      folly::to<std::string>("Error reading RAM Bundle: ", m_bundle->rdstate()));
+    const size_t bytes,
+    const size_t position) const {
+  if (position > m_bundleSize || bytes > m_bundleSize - position) {
+    throw std::ios_base::failure("Unexpected end of RAM Bundle file");
   }
-  readBundle(buffer, bytes);
+  ::memcpy(buffer, m_bundleData + position, bytes);
 }
 
 }  // namespace react
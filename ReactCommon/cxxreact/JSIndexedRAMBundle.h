@@ -5,7 +5,6 @@
 
 #pragma once
 
-#include <istream>
 #include <memory>
 
 #include <cxxreact/JSBigString.h>
@@ -30,6 +29,11 @@ public:
   std::unique_ptr<const JSBigString> getStartupCode();
   // Throws std::runtime_error on failure.
   Module getModule(uint32_t moduleId) const override;
+  // Throws std::runtime_error on failure. The code points into the bundle,
+  // which is never modified after construction, so this is safe to call from
+  // any thread without locking.
+  ModuleView getModuleView(uint32_t moduleId) const override;
+  void prefetchModules(const std::vector<uint32_t>& moduleIds) const override;
 
 private:
   struct ModuleData {
@@ -53,14 +57,14 @@ private:
   };
 
   void init();
-  std::string getModuleCode(const uint32_t id) const;
-  void readBundle(char *buffer, const std::streamsize bytes) const;
-  void readBundle(
-    char *buffer, const
-    std::streamsize bytes,
-    const std::istream::pos_type position) const;
+  folly::StringPiece getModuleCode(const uint32_t id) const;
+  void readBundle(char *buffer, const size_t bytes, const size_t position) const;
 
-  mutable std::unique_ptr<std::istream> m_bundle;
+  // Memory mapped when loaded from a file, so modules are only paged in when
+  // they are required.
+  std::unique_ptr<const JSBigString> m_bundle;
+  const char *m_bundleData;
+  size_t m_bundleSize;
   ModuleTable m_table;
   size_t m_baseOffset;
   std::unique_ptr<JSBigBufferString> m_startupCode;
@@ -8,8 +8,10 @@
 #include <cstdint>
 #include <string>
 #include <stdexcept>
+#include <vector>
 
 #include <folly/Conv.h>
+#include <folly/Range.h>
 
 namespace facebook {
 namespace react {
@@ -33,10 +35,29 @@ public:
     std::string name;
     std::string code;
   };
+  struct ModuleView {
+    std::string name;
+    folly::StringPiece code;
+  };
   JSModulesUnbundle() {}
   virtual ~JSModulesUnbundle() {}
   virtual Module getModule(uint32_t moduleId) const = 0;
 
+  /**
+   * Like getModule, but refers to the code in place instead of copying it.
+   * The code stays valid for the lifetime of the bundle. Bundles which can't
+   * provide that return a view with empty code.
+   */
+  virtual ModuleView getModuleView(uint32_t /*moduleId*/) const {
+    return {};
+  }
+
+  /**
+   * Hints that the given modules are about to be required, so that their
+   * code can be paged in ahead of time.
+   */
+  virtual void prefetchModules(const std::vector<uint32_t>& /*moduleIds*/) const {}
+
 private:
   JSModulesUnbundle(const JSModulesUnbundle&) = delete;
 };
@@ -39,6 +39,28 @@ void RAMBundleRegistry::registerBundle(
 
 JSModulesUnbundle::Module RAMBundleRegistry::getModule(
     uint32_t bundleId, uint32_t moduleId) {
+  auto module = getOrLoadBundle(bundleId)->getModule(moduleId);
+  return {
+    getModuleName(bundleId, std::move(module.name)),
+    std::move(module.code),
+  };
+}
+
+JSModulesUnbundle::ModuleView RAMBundleRegistry::getModuleView(
+    uint32_t bundleId, uint32_t moduleId) {
+  auto module = getOrLoadBundle(bundleId)->getModuleView(moduleId);
+  return {
+    getModuleName(bundleId, std::move(module.name)),
+    module.code,
+  };
+}
+
+void RAMBundleRegistry::prefetchModules(
+    uint32_t bundleId, const std::vector<uint32_t>& moduleIds) {
+  getOrLoadBundle(bundleId)->prefetchModules(moduleIds);
+}
+
+JSModulesUnbundle* RAMBundleRegistry::getOrLoadBundle(uint32_t bundleId) {
   if (m_bundles.find(bundleId) == m_bundles.end()) {
     if (!m_factory) {
       throw std::runtime_error(
@@ -57,14 +79,15 @@ JSModulesUnbundle::Module RAMBundleRegistry::getModule(
     m_bundles.emplace(bundleId, m_factory(bundlePath->second));
   }
 
-  auto module = getBundle(bundleId)->getModule(moduleId);
+  return getBundle(bundleId);
+}
+
+std::string RAMBundleRegistry::getModuleName(
+    uint32_t bundleId, std::string name) {
   if (bundleId == MAIN_BUNDLE_ID) {
-    return module;
+    return name;
   }
-  return {
-    folly::to<std::string>("seg-", bundleId, '_', std::move(module.name)),
-    std::move(module.code),
-  };
+  return folly::to<std::string>("seg-", bundleId, '_', std::move(name));
 }
 
 JSModulesUnbundle* RAMBundleRegistry::getBundle(uint32_t bundleId) const {
@@ -10,6 +10,7 @@
 #include <memory>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <cxxreact/JSModulesUnbundle.h>
 
@@ -40,9 +41,15 @@ public:
 
   void registerBundle(uint32_t bundleId, std::string bundlePath);
   JSModulesUnbundle::Module getModule(uint32_t bundleId, uint32_t moduleId);
+  // The code is empty if the bundle can't refer to it in place, callers
+  // then have to fall back to getModule.
+  JSModulesUnbundle::ModuleView getModuleView(uint32_t bundleId, uint32_t moduleId);
+  void prefetchModules(uint32_t bundleId, const std::vector<uint32_t>& moduleIds);
   virtual ~RAMBundleRegistry() {};
 private:
   JSModulesUnbundle* getBundle(uint32_t bundleId) const;
+  JSModulesUnbundle* getOrLoadBundle(uint32_t bundleId);
+  static std::string getModuleName(uint32_t bundleId, std::string name);
 
   std::function<std::unique_ptr<JSModulesUnbundle>(std::string)> m_factory;
   std::unordered_map<uint32_t, std::string> m_bundlePaths;
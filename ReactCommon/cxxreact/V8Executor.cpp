@@ -1,8 +1,10 @@
 #include <algorithm>
 #include <condition_variable>
+#include <map>
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <folly/json.h>
 #include <folly/Exception.h>
 #include <folly/Memory.h>
@@ -31,9 +33,6 @@
 
 using namespace rnv8;
 
-const char* MODULE_PROLOGUE = "(function(module, exports, require, __filename, __dirname){ ";
-const char* MODULE_EPILOGUE = "\n})";
-
 namespace v8 {
 
 #define THROW_RUNTIME_ERROR(INFO) do { \
@@ -53,6 +52,65 @@ namespace v8 {
 static int s_NumberOfIsolates = 0;
 static bool s_PlatformInitialized = false;
 
+namespace {
+
+/*
+ * External string resources let V8 reference the script source in place instead of copying it onto its heap.
+ * V8 deletes the resource, and with it the source, once the string is collected.
+ */
+class JSBigStringResource : public String::ExternalOneByteStringResource {
+public:
+  explicit JSBigStringResource(std::unique_ptr<const JSBigString> string) : m_string(std::move(string)) {}
+  const char* data() const override { return m_string->c_str(); }
+  size_t length() const override { return m_string->size(); }
+
+private:
+  std::unique_ptr<const JSBigString> m_string;
+};
+
+class StdStringResource : public String::ExternalOneByteStringResource {
+public:
+  explicit StdStringResource(std::string&& string) : m_string(std::move(string)) {}
+  const char* data() const override { return m_string.data(); }
+  size_t length() const override { return m_string.size(); }
+
+private:
+  std::string m_string;
+};
+
+// Does not own the source, which has to outlive the isolate.
+class StringPieceResource : public String::ExternalOneByteStringResource {
+public:
+  explicit StringPieceResource(folly::StringPiece string) : m_string(string) {}
+  const char* data() const override { return m_string.data(); }
+  size_t length() const override { return m_string.size(); }
+
+private:
+  folly::StringPiece m_string;
+};
+
+// One byte strings are Latin-1, hence only ASCII sources can be handed to V8 without decoding the UTF-8.
+bool isAscii(folly::StringPiece string) {
+  for (unsigned char c : string) {
+    if (c & 0x80) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename Resource>
+Local<String> newExternalOneByteString(Isolate* isolate, Resource* resource) {
+  Local<String> result;
+  if (!String::NewExternalOneByte(isolate, resource).ToLocal(&result)) {
+    // Fallback, e.g. for sources beyond String::kMaxLength.
+    result = String::NewFromUtf8(isolate, resource->data(), NewStringType::kNormal, static_cast<int>(resource->length())).ToLocalChecked();
+    delete resource;
+  }
+  return result;
+}
+}
+
 #if DEBUG
 static void nativeInjectHMRUpdate(const FunctionCallbackInfo<Value> &args) {
   LOGV("V8Executor::nativeInjectHMRUpdate entry");
@@ -225,6 +283,11 @@ void V8Executor::TrySetJSEConfigFromEnv(){
       m_jseConfigParams->cachePath = std::string(localPath);
       m_jseConfigParams->cacheType = CachingType::FullCachingWithNoLazy;
       m_jseConfigParams->loggingLevel = 50; // deafult logging 10 = Logging::LoggingLevel::ERROR
+
+      const char* cacheDelay = getenv("V8_JSCACHE_DELAY_MS");
+      if (cacheDelay != NULL) {
+        m_jseConfigParams->cacheCreationDelayInMs = atoi(cacheDelay);
+      }
     }
   }
 }
@@ -239,6 +302,7 @@ bool V8Executor::IsCacheEnabled() {
   }
 
   m_jseLocalPath = m_jseConfigParams->cachePath;
+  m_scriptCacheStore = std::make_shared<V8ScriptCacheStore>(m_jseLocalPath, m_jseConfigParams->cacheSizeLimitInBytes);
   LOGV("V8Executor::IsCacheEnabled cachePath: %s", m_jseLocalPath.c_str());
 
   return true;
@@ -254,6 +318,18 @@ bool V8Executor::ShouldProduceFullCache() {
     (m_jseConfigParams->cacheType == CachingType::FullCaching || m_jseConfigParams->cacheType == CachingType::FullCachingWithNoLazy));
 }
 
+bool V8Executor::ShouldDeferCacheCreation() {
+  // Deferring needs the JS queue to come back to the isolate once the delay elapses.
+  return (m_jseConfigParams != nullptr && m_jseConfigParams->cacheCreationDelayInMs > 0 && m_messageQueueThread);
+}
+
+void V8Executor::SetNoLazyFlagIfNeeded() {
+  if (ShouldSetNoLazyFlag()) {
+    const char* lazy = "--nolazy";
+    V8::SetFlagsFromString(lazy, strlen(lazy));
+  }
+}
+
 V8Executor::V8Executor(std::shared_ptr<ExecutorDelegate> delegate,
                         std::shared_ptr<MessageQueueThread> messageQueueThread,
                         const folly::dynamic& jscConfig,
@@ -348,6 +424,14 @@ void V8Executor::terminateOnJSVMThread() {
   m_callFunctionReturnFlushedQueueJS.Reset();
   m_flushedQueueJS.Reset();
   m_callFunctionReturnResultAndFlushedQueueJS.Reset();
+  m_deferredScriptCaches.clear();
+  // The prefetch thread reads module code straight from the bundles, which go away with the executor.
+  if (m_prefetchedScriptCaches) {
+    m_prefetchedScriptCaches->isCancelled = true;
+  }
+  if (m_startupPrefetchThread.joinable()) {
+    m_startupPrefetchThread.join();
+  }
   m_context.Reset();
   m_isolate->TerminateExecution();
   m_isolate->Dispose();
@@ -368,7 +452,7 @@ static std::string simpleBasename(const std::string &path) {
   LOGV("V8Executor::simpleBasename exit");
 }
 
-void V8Executor::loadApplicationScript(std::unique_ptr<const JSBigString> script, uint64_t /*scriptVersion*/, std::string sourceURL, std::string&& bytecodeFileName) {
+void V8Executor::loadApplicationScript(std::unique_ptr<const JSBigString> script, uint64_t scriptVersion, std::string sourceURL, std::string&& bytecodeFileName) {
 
   LOGV("V8Executor::loadApplicationScript entry sourceURL = %s, bytecodeFileName = %s", sourceURL.c_str(), bytecodeFileName.c_str());
   SystraceSection s("V8Executor::loadApplicationScript", "sourceURL", sourceURL);
@@ -376,7 +460,17 @@ void V8Executor::loadApplicationScript(std::unique_ptr<const JSBigString> script
   ReactMarker::logTaggedMarker(ReactMarker::RUN_JS_BUNDLE_START, scriptName.c_str());
   _ISOLATE_CONTEXT_ENTER;
   TryCatch try_catch(isolate);
-  Local<Script> compiled_script = LoadScript(std::move(toLocalString(isolate, std::move(script->c_str()))), scriptName, context);
+  // Hashing the bundle is only needed to key its cache, and can be skipped if the host versions the bundle.
+  // Bundles loaded from files are keyed by their path, size and modification time, so only bundles which
+  // have neither are hashed in full.
+  uint64_t scriptHash = 0;
+  if (IsCacheEnabled()) {
+    scriptHash = scriptVersion != 0 ? scriptVersion : V8ScriptCacheStore::HashFileIdentity(sourceURL, script->size());
+    if (scriptHash == 0) {
+      scriptHash = V8ScriptCacheStore::Hash(script->c_str(), script->size());
+    }
+  }
+  Local<Script> compiled_script = LoadScript(adoptString(std::move(script)), scriptName, scriptHash, context);
   // 	LOGV("V8Executor::loadApplicationScript after LoadScript;");
  // Run the script!
   Local<Value> result;
@@ -389,6 +483,7 @@ void V8Executor::loadApplicationScript(std::unique_ptr<const JSBigString> script
 
   flush();
   ReactMarker::logMarker(ReactMarker::CREATE_REACT_CONTEXT_STOP);
+  FinishStartupProfile();
   ReactMarker::logTaggedMarker(ReactMarker::RUN_JS_BUNDLE_STOP, scriptName.c_str());
   LOGV("V8Executor::loadApplicationScript exit");
 }
@@ -398,7 +493,12 @@ void V8Executor::registerBundle(uint32_t bundleId, const std::string& bundlePath
   std::terminate();
 }
 
-void V8Executor::SaveScriptCache(std::unique_ptr<ScriptCompiler::CachedData> cached_data, const std::string& path) {
+ScriptCacheKey V8Executor::GetScriptCacheKey(uint64_t scriptHash) {
+  // The version tag also covers the V8 flags, so it must be computed after --nolazy is set.
+  return { scriptHash, ScriptCompiler::CachedDataVersionTag(), ShouldProduceFullCache() };
+}
+
+void V8Executor::SaveScriptCache(std::unique_ptr<ScriptCompiler::CachedData> cached_data, const std::string& name, const ScriptCacheKey& key) {
   LOGV("V8Executor::SaveScriptCache entry");
   if (!cached_data) {
     ReactMarker::logMarker(ReactMarker::BYTECODE_CREATION_FAILED);
@@ -407,9 +507,9 @@ void V8Executor::SaveScriptCache(std::unique_ptr<ScriptCompiler::CachedData> cac
   }
 
   int length = cached_data->length;
-  LOGV("V8Executor::SaveScriptCache entry %s ", path.c_str());
+  LOGV("V8Executor::SaveScriptCache entry %s ", name.c_str());
 
-  bool result = File::WriteBinary(path, cached_data->data, length);
+  bool result = m_scriptCacheStore->Save(name, key, cached_data->data, length);
 
   if (!result) {
     ReactMarker::logMarker(ReactMarker::BYTECODE_WRITE_FAILED);
@@ -418,42 +518,217 @@ void V8Executor::SaveScriptCache(std::unique_ptr<ScriptCompiler::CachedData> cac
   LOGV("V8Executor::SaveScriptCache exit");
 }
 
-ScriptCompiler::CachedData* V8Executor::TryLoadScriptCache(const std::string& path) {
-  LOGV("V8Executor::TryLoadScriptCache entry");
-  long length = 0;
-  auto data = File::ReadBinary(path, length);
-  if (!data) {
+void V8Executor::SaveScriptCacheAsync(std::unique_ptr<ScriptCompiler::CachedData> cached_data, const std::string& name, const ScriptCacheKey& key) {
+  if (!cached_data) {
+    ReactMarker::logMarker(ReactMarker::BYTECODE_CREATION_FAILED);
+    return;
+  }
+
+  // The cache data owns its buffer, hence the write doesn't need the isolate.
+  std::shared_ptr<V8ScriptCacheStore> scriptCacheStore = m_scriptCacheStore;
+  std::thread([cached_data = std::move(cached_data), scriptCacheStore, name, key]() {
+    if (!scriptCacheStore->Save(name, key, cached_data->data, cached_data->length)) {
+      ReactMarker::logMarker(ReactMarker::BYTECODE_WRITE_FAILED);
+    }
+  }).detach();
+}
+
+void V8Executor::DeferScriptCache(Local<UnboundScript> script, const std::string& name, const ScriptCacheKey& key) {
+  LOGV("V8Executor::DeferScriptCache %s", name.c_str());
+  m_deferredScriptCaches.push_back({ Global<UnboundScript>(GetIsolate(), script), name, key });
+
+  if (m_isDeferredScriptCacheScheduled) {
+    return;
+  }
+  m_isDeferredScriptCacheScheduled = true;
+
+  // MessageQueueThread has no delayed dispatch; wait on a helper thread and hop back to the JS thread.
+  std::shared_ptr<MessageQueueThread> messageQueueThread = m_messageQueueThread;
+  std::shared_ptr<bool> isDestroyed = m_isDestroyed;
+  int delayInMs = m_jseConfigParams->cacheCreationDelayInMs;
+  std::thread([this, messageQueueThread, isDestroyed, delayInMs]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(delayInMs));
+    messageQueueThread->runOnQueue([this, isDestroyed]() {
+      if (*isDestroyed) {
+        return;
+      }
+      CreateDeferredScriptCaches();
+    });
+  }).detach();
+}
+
+void V8Executor::CreateDeferredScriptCaches() {
+  SystraceSection s("V8Executor::CreateDeferredScriptCaches");
+  m_isDeferredScriptCacheScheduled = false;
+
+  Isolate *isolate = GetIsolate();
+  Isolate::Scope isolate_scope(isolate);
+  HandleScope handle_scope(isolate);
+
+  // The scripts have run by now, so the cache also covers the functions which were lazily compiled during startup.
+  for (auto& deferred : m_deferredScriptCaches) {
+    std::unique_ptr<ScriptCompiler::CachedData> cacheData{ ScriptCompiler::CreateCodeCache(deferred.script.Get(isolate)) };
+    SaveScriptCacheAsync(std::move(cacheData), deferred.name, deferred.key);
+  }
+  m_deferredScriptCaches.clear();
+}
+
+void V8Executor::PrefetchStartupModules() {
+  if (m_startupProfile || !m_bundleRegistry || !IsCacheEnabled()) {
+    return;
+  }
+
+  // The profile lives next to the caches, which it is only useful with.
+  m_startupProfile = folly::make_unique<V8StartupProfile>(m_jseLocalPath + "/startup.v8profile");
+  const auto& modules = m_startupProfile->GetPreviousModules();
+  if (modules.empty()) {
+    return;
+  }
+
+  SystraceSection s("V8Executor::PrefetchStartupModules");
+  std::map<uint32_t, std::vector<uint32_t>> moduleIdsByBundle;
+  for (const auto& module : modules) {
+    moduleIdsByBundle[module.bundleId].push_back(module.moduleId);
+  }
+
+  // Page the code in ahead of the requires, they would otherwise fault it in one module at a time.
+  for (const auto& bundle : moduleIdsByBundle) {
+    try {
+      m_bundleRegistry->prefetchModules(bundle.first, bundle.second);
+    } catch (const std::exception& e) {
+      LOGI("V8Executor::PrefetchStartupModules skipping bundle %u: %s", bundle.first, e.what());
+    }
+  }
+
+  // Only modules served in place can be read off the JS thread, and they stay valid until the isolate is gone.
+  std::vector<std::pair<std::string, folly::StringPiece>> sources;
+  for (const auto& module : modules) {
+    try {
+      auto moduleView = m_bundleRegistry->getModuleView(module.bundleId, module.moduleId);
+      if (!moduleView.code.empty()) {
+        sources.emplace_back(std::move(moduleView.name), moduleView.code);
+      }
+    } catch (const std::exception&) {
+      // The bundle changed since the profile was recorded, the module fails properly once it is actually required.
+    }
+  }
+  if (sources.empty()) {
+    return;
+  }
+
+  // The version tag covers the flags, which have to be set before it is computed.
+  SetNoLazyFlagIfNeeded();
+  ScriptCacheKey key = GetScriptCacheKey(0);
+
+  // V8 can only compile on the isolate's thread. Hashing the sources and reading and validating their caches is most
+  // of what is left, so that is done ahead in profile order, and the requires just consume the caches.
+  m_prefetchedScriptCaches = std::make_shared<PrefetchedScriptCaches>();
+  m_startupPrefetchThread = std::thread([prefetched = m_prefetchedScriptCaches, scriptCacheStore = m_scriptCacheStore, sources = std::move(sources), key]() {
+    for (const auto& source : sources) {
+      if (prefetched->isCancelled) {
+        return;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(prefetched->mutex);
+        if (prefetched->requiredModules.count(source.first)) {
+          continue;
+        }
+      }
+
+      ScriptCacheKey moduleKey = key;
+      moduleKey.scriptHash = V8ScriptCacheStore::Hash(source.second.data(), source.second.size());
+      std::unique_ptr<ScriptCompiler::CachedData> cacheData{ scriptCacheStore->TryLoad(source.first, moduleKey) };
+      if (!cacheData) {
+        continue;
+      }
+
+      std::lock_guard<std::mutex> lock(prefetched->mutex);
+      if (!prefetched->isCancelled && !prefetched->requiredModules.count(source.first)) {
+        prefetched->caches.emplace(source.first, std::make_pair(moduleKey, std::move(cacheData)));
+      }
+    }
+  });
+}
+
+void V8Executor::FinishStartupProfile() {
+  if (!m_startupProfile || !m_startupProfile->IsRecording()) {
+    return;
+  }
+
+  m_startupProfile->StopRecordingAndSaveAsync();
+
+  // Startup is over, caches which were prefetched but not required are not worth holding on to.
+  if (m_prefetchedScriptCaches) {
+    std::lock_guard<std::mutex> lock(m_prefetchedScriptCaches->mutex);
+    m_prefetchedScriptCaches->isCancelled = true;
+    m_prefetchedScriptCaches->caches.clear();
+    m_prefetchedScriptCaches->requiredModules.clear();
+  }
+}
+
+ScriptCompiler::CachedData* V8Executor::TakePrefetchedScriptCache(const std::string& name, const ScriptCacheKey& key) {
+  if (!m_prefetchedScriptCaches) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(m_prefetchedScriptCaches->mutex);
+  if (m_prefetchedScriptCaches->isCancelled) {
     return nullptr;
   }
 
-  LOGV("V8Executor::TryLoadScriptCache exit");
-  return new ScriptCompiler::CachedData(reinterpret_cast<uint8_t*>(data), length, ScriptCompiler::CachedData::BufferOwned);
+  auto it = m_prefetchedScriptCaches->caches.find(name);
+  if (it == m_prefetchedScriptCaches->caches.end()) {
+    m_prefetchedScriptCaches->requiredModules.insert(name);
+    return nullptr;
+  }
 
+  ScriptCacheKey prefetchedKey = it->second.first;
+  std::unique_ptr<ScriptCompiler::CachedData> cacheData = std::move(it->second.second);
+  m_prefetchedScriptCaches->caches.erase(it);
+  if (prefetchedKey.scriptHash != key.scriptHash || prefetchedKey.versionTag != key.versionTag || prefetchedKey.isFullCache != key.isFullCache) {
+    return nullptr;
+  }
+  return cacheData.release();
+}
+
+Local<String> V8Executor::adoptString(std::unique_ptr<const JSBigString> string) {
+  Isolate *isolate = GetIsolate();
+  if (!string->isAscii()) {
+    return String::NewFromUtf8(isolate, string->c_str(), NewStringType::kNormal, static_cast<int>(string->size())).ToLocalChecked();
+  }
+
+  return newExternalOneByteString(isolate, new JSBigStringResource(std::move(string)));
 }
 
-Local<String> V8Executor::ConvertToV8String(Isolate* isolate, const string& s) {
-  LOGV("V8Executor::ConvertToV8String entry");
-  Local<String> str = String::NewFromUtf8(isolate, s.c_str(), NewStringType::kNormal, s.length()).ToLocalChecked();
-  LOGV("V8Executor::ConvertToV8String exit");
-  return str;
+Local<String> V8Executor::adoptString(std::string&& string) {
+  Isolate *isolate = GetIsolate();
+  if (!isAscii(string)) {
+    return toLocalString(isolate, string);
+  }
+
+  return newExternalOneByteString(isolate, new StdStringResource(std::move(string)));
 }
 
-Local<String> V8Executor::WrapModuleContent(const string& path) {
-  LOGV("V8Executor::WrapModuleContent entry");
-  string content = File::ReadText(path);
-  // TODO: Use statically allocated buffer for better performance
-  string result(MODULE_PROLOGUE);
-  result.reserve(content.length() + 1024);
-  result += content;
-  result += MODULE_EPILOGUE;
-  return ConvertToV8String(m_isolate, result);
-  LOGV("V8Executor::WrapModuleContent exit");
+Local<String> V8Executor::adoptString(folly::StringPiece string) {
+  Isolate *isolate = GetIsolate();
+  if (!isAscii(string)) {
+    return String::NewFromUtf8(isolate, string.data(), NewStringType::kNormal, static_cast<int>(string.size())).ToLocalChecked();
+  }
+
+  return newExternalOneByteString(isolate, new StringPieceResource(string));
 }
 
 
-Local<Script> V8Executor::createAndGetScript(const Local<String> &scriptData, const string& path, Local<Context> context) {
-  string fullPath = m_jseLocalPath + string("/") + path + ".v8cache";
-  auto cacheData = TryLoadScriptCache(fullPath);
+Local<Script> V8Executor::createAndGetScript(const Local<String> &scriptData, const string& path, uint64_t scriptHash, Local<Context> context) {
+  SetNoLazyFlagIfNeeded();
+
+  // The store validates the key and checksums, so a stale or corrupt cache never reaches V8.
+  ScriptCacheKey key = GetScriptCacheKey(scriptHash);
+  auto cacheData = TakePrefetchedScriptCache(path, key);
+  if (cacheData == nullptr) {
+    cacheData = m_scriptCacheStore->TryLoad(path, key);
+  }
 
   // No need to delete cacheData as ScriptCompiler::Source will take its ownership.
   ScriptCompiler::Source source(scriptData, cacheData);
@@ -462,14 +737,9 @@ Local<Script> V8Executor::createAndGetScript(const Local<String> &scriptData, co
   TryCatch tc(isolate);
   ScriptCompiler::CompileOptions option = ScriptCompiler::kNoCompileOptions;
 
-  if (ShouldSetNoLazyFlag()) {
-    const char* lazy = "--nolazy";
-    V8::SetFlagsFromString(lazy, strlen(lazy));
-  }
-
   if (cacheData != nullptr) {
     //SystraceSection s("V8Executor::LoadScript Compile, cached");
-    LOGV("V8Executor::createAndGetScript cached path :%s", fullPath.c_str());
+    LOGV("V8Executor::createAndGetScript cached name :%s", path.c_str());
 
     option = ScriptCompiler::kConsumeCodeCache;
     auto maybeScript = ScriptCompiler::Compile(context, &source, option);
@@ -479,8 +749,8 @@ Local<Script> V8Executor::createAndGetScript(const Local<String> &scriptData, co
     }
 
     if (cacheData->rejected) {
-      int status = remove(fullPath.c_str());
-      LOGI("V8Executor::createAndGetScript cache was rejected. Cache delete status: %d ", status);
+      m_scriptCacheStore->Remove(path);
+      LOGI("V8Executor::createAndGetScript cache was rejected and deleted.");
     }
 
     script = maybeScript.ToLocalChecked();
@@ -488,6 +758,21 @@ Local<Script> V8Executor::createAndGetScript(const Local<String> &scriptData, co
     //SystraceSection s("V8Executor::LoadScript Compile, no cached");
     LOGV("V8Executor::createAndGetScript no cached");
 
+    if (ShouldDeferCacheCreation()) {
+      // Eager compilation is what the full code cache amounts to, and has to happen now as the cache is created later.
+      option = ShouldProduceFullCache() ? ScriptCompiler::kEagerCompile : ScriptCompiler::kNoCompileOptions;
+      auto maybeScript = ScriptCompiler::Compile(context, &source, option);
+
+      if (maybeScript.IsEmpty() || tc.HasCaught()) {
+        THROW_RUNTIME_ERROR("Error ExecuteScript while compile script!");
+      }
+
+      script = maybeScript.ToLocalChecked();
+      DeferScriptCache(script->GetUnboundScript(), path, key);
+      LOGV("V8Executor::createAndGetScript exit, cache deferred");
+      return script;
+    }
+
     if (ShouldProduceFullCache()) {
       option = ScriptCompiler::kProduceFullCodeCache;
     } else {
@@ -510,7 +795,7 @@ Local<Script> V8Executor::createAndGetScript(const Local<String> &scriptData, co
     std::unique_ptr<ScriptCompiler::CachedData> cacheData{ ScriptCompiler::CreateCodeCache(uScript) };
 
     LOGV("V8Executor::createAndGetScript, after ToLocalChecked");
-    SaveScriptCache(std::move(cacheData), fullPath);
+    SaveScriptCache(std::move(cacheData), path, key);
     LOGV("V8Executor::createAndGetScript, after save");
   }
 
@@ -518,7 +803,7 @@ Local<Script> V8Executor::createAndGetScript(const Local<String> &scriptData, co
   return script;
 }
 
-Local<Script> V8Executor::LoadScript(const Local<String> &scriptData, const string& path, Local<Context> context) {
+Local<Script> V8Executor::LoadScript(const Local<String> &scriptData, const string& path, uint64_t scriptHash, Local<Context> context) {
   LOGV("V8Executor::LoadScript entry %s", path.c_str());
   string frameName("LoadScript " + path);
   Isolate *isolate = GetIsolate();
@@ -537,12 +822,16 @@ Local<Script> V8Executor::LoadScript(const Local<String> &scriptData, const stri
     return maybeScript.ToLocalChecked();
   }
 
-  return createAndGetScript(scriptData, path, context);
+  return createAndGetScript(scriptData, path, scriptHash, context);
 }
 
 void V8Executor::setBundleRegistry(std::unique_ptr<RAMBundleRegistry> bundleRegistry) {
   LOGV("V8Executor::setBundleRegistry entry");
+  if (m_bundleRegistry) {
+    m_retiredBundleRegistries.push_back(std::move(m_bundleRegistry));
+  }
   m_bundleRegistry = std::move(bundleRegistry);
+  PrefetchStartupModules();
   LOGV("V8Executor::setBundleRegistry exit");
 }
 
@@ -584,12 +873,9 @@ void V8Executor::callNativeModules(Local<Context> context, Local<Value> value) {
   CHECK(m_delegate) << "Attempting to use native modules without a delegate";
   try {
     if (!value.IsEmpty() && value->IsObject()) {
-      Local<Object> obj = Local<Object>::Cast(value);
-      const std::string &arg = toJsonStdString(context, std::move(obj));
-      LOGV("callNativeModules arg: %s", arg.c_str());
-      m_delegate->callNativeModules(*this, folly::parseJson(std::move(arg)), true);
+      m_delegate->callNativeModules(*this, toDynamic(context->GetIsolate(), context, value), true);
     } else {
-      m_delegate->callNativeModules(*this, folly::parseJson("null"), true);
+      m_delegate->callNativeModules(*this, nullptr, true);
     }
   } catch (...) {
     std::string message = "Error in callNativeModules()";
@@ -640,9 +926,7 @@ void V8Executor::callFunction(const std::string &moduleId, const std::string &me
   Local<Function> localFunc = Local<Function>::New(isolate, m_callFunctionReturnFlushedQueueJS);
   Local<String> localModuleId = toLocalString(isolate, moduleId);
   Local<String> localMethodId = toLocalString(isolate, methodId);
-  const std::string &json = folly::toJson(arguments);
-  Local<String> json_str = toLocalString(isolate, std::move(json));
-  Local<Value> localArguments = safeToLocal(JSON::Parse(context, json_str));
+  Local<Value> localArguments = fromDynamic(isolate, context, arguments);
   Local<Value> argv[3] = { localModuleId, localMethodId, localArguments };
   Local<Value> result = safeToLocal(localFunc->Call(context, context->Global(), 3, argv)); // TODO, catch exception
   callNativeModules(context, result);
@@ -699,15 +983,27 @@ void V8Executor::loadModule(uint32_t bundleId, uint32_t moduleId) {
     return;
   }
   _ISOLATE_CONTEXT_ENTER;
-  auto module = m_bundleRegistry->getModule(bundleId, moduleId);
-  auto source = toLocalString(isolate, module.code);
-  std::string path = module.name;
+  // Memory mapped bundles hand out the code in place, which saves a read and a copy per require.
+  auto moduleView = m_bundleRegistry->getModuleView(bundleId, moduleId);
+  std::string path;
+  uint64_t scriptHash = 0;
+  Local<String> source;
+  if (!moduleView.code.empty()) {
+    path = std::move(moduleView.name);
+    scriptHash = IsCacheEnabled() ? V8ScriptCacheStore::Hash(moduleView.code.data(), moduleView.code.size()) : 0;
+    source = adoptString(moduleView.code);
+  } else {
+    auto module = m_bundleRegistry->getModule(bundleId, moduleId);
+    path = std::move(module.name);
+    scriptHash = IsCacheEnabled() ? V8ScriptCacheStore::Hash(module.code.data(), module.code.size()) : 0;
+    source = adoptString(std::move(module.code));
+  }
   // TODO
   //_ISOLATE_CONTEXT_ENTER;
   //executeScript(context, std::move(toLocalString(isolate, std::move(script->c_str()))));
   TryCatch try_catch(isolate);
   LOGV("V8Executor::loadModule before LoadScript");
-  Local<Script> compiled_script = LoadScript(source, path, context);
+  Local<Script> compiled_script = LoadScript(source, path, scriptHash, context);
   // Run the script!
   Local<Value> result;
   if (!compiled_script->Run(context).ToLocal(&result)) {
@@ -742,6 +1038,9 @@ void V8Executor::nativeRequire(const v8::FunctionCallbackInfo<v8::Value> &args)
   LOGV("V8Executor::nativeRequire bundleId %d, moduleId %d", bundleId->Value(), moduleId->Value());
 
   ReactMarker::logMarker(ReactMarker::NATIVE_REQUIRE_START);
+  if (m_startupProfile) {
+    m_startupProfile->RecordRequire(bundleId->Value(), moduleId->Value());
+  }
   loadModule(bundleId->Value(), moduleId->Value());
   ReactMarker::logMarker(ReactMarker::NATIVE_REQUIRE_STOP);
 }
@@ -756,10 +1055,7 @@ void V8Executor::nativeFlushQueueImmediate(const v8::FunctionCallbackInfo<v8::Va
   }
   _ISOLATE_CONTEXT_ENTER;
 
-
-  auto queueStr = toJsonStdString(context, Local<Object>::Cast(args[0]));
-  LOGV("V8Executor::nativeFlushQueueImmediate %s", queueStr.c_str());
-  m_delegate->callNativeModules(*this, folly::parseJson(queueStr), false);
+  m_delegate->callNativeModules(*this, toDynamic(isolate, context, args[0]), false);
 }
 
 void V8Executor::nativeCallSyncHook(const v8::FunctionCallbackInfo<v8::Value> &args) {
@@ -773,8 +1069,7 @@ void V8Executor::nativeCallSyncHook(const v8::FunctionCallbackInfo<v8::Value> &a
   unsigned int moduleId = (unsigned int) Number::Cast(*(args[0]))->Value();
   unsigned int methodId = (unsigned int) Number::Cast(*(args[1]))->Value();
   LOGV("V8Executor::nativeCallSyncHook moduleId %d, methodId %d", moduleId, methodId);
-  const std::string &argsJson = toJsonStdString(context, Local<Object>::Cast(args[2]));
-  folly::dynamic dynamicArgs = folly::parseJson(std::move(argsJson));
+  folly::dynamic dynamicArgs = toDynamic(isolate, context, args[2]);
   if (!dynamicArgs.isArray()) {
     throw std::invalid_argument(
       folly::to<std::string>("method parameters should be array, but are ", dynamicArgs.typeName()));
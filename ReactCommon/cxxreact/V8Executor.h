@@ -5,12 +5,20 @@
 
 #include <cxxreact/JSExecutor.h>
 #include <cxxreact/V8NativeModules.h>
+#include <cxxreact/V8ScriptCacheStore.h>
+#include <cxxreact/V8StartupProfile.h>
 #include <cxxreact/RAMBundleRegistry.h>
 #include <folly/Optional.h>
 #include <folly/json.h>
 #include "MessageQueueThread.h"
 #include <privatedata/PrivateDataBase.h>
+#include <atomic>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include "v8.h"
 #include <v8helpers/V8Utils.h>
 
@@ -108,6 +116,8 @@ private:
   std::shared_ptr<bool> m_isDestroyed = std::shared_ptr<bool>(new bool(false));
   std::shared_ptr<MessageQueueThread> m_messageQueueThread;
   std::unique_ptr<RAMBundleRegistry> m_bundleRegistry;
+  // Module sources are handed to V8 in place, so replaced registries have to outlive the isolate.
+  std::vector<std::unique_ptr<RAMBundleRegistry>> m_retiredBundleRegistries;
   V8NativeModules m_nativeModules;
   folly::dynamic m_jscConfig;
   std::once_flag m_bindFlag;
@@ -132,18 +142,26 @@ private:
   bool IsCacheEnabled();
   bool ShouldSetNoLazyFlag();
   bool ShouldProduceFullCache();
+  bool ShouldDeferCacheCreation();
+  void SetNoLazyFlagIfNeeded();
 
   // Added to Save Cache
-  void SaveScriptCache(std::unique_ptr<ScriptCompiler::CachedData> cached_data, const std::string& path);
-  Local<String> ConvertToV8String(Isolate* isolate, const string& s);
-  Local<String> WrapModuleContent(const string& path);
-  Local<Script> LoadScript(const Local<String> &scriptData, const string& path, Local<Context> context);
-  Local<Script> createAndGetScript(const Local<String> &scriptData, const string& path, Local<Context> context);
+  ScriptCacheKey GetScriptCacheKey(uint64_t scriptHash);
+  void SaveScriptCache(std::unique_ptr<ScriptCompiler::CachedData> cached_data, const std::string& name, const ScriptCacheKey& key);
+  void SaveScriptCacheAsync(std::unique_ptr<ScriptCompiler::CachedData> cached_data, const std::string& name, const ScriptCacheKey& key);
+  void DeferScriptCache(Local<UnboundScript> script, const std::string& name, const ScriptCacheKey& key);
+  void CreateDeferredScriptCaches();
+  void PrefetchStartupModules();
+  void FinishStartupProfile();
+  ScriptCompiler::CachedData* TakePrefetchedScriptCache(const std::string& name, const ScriptCacheKey& key);
+  Local<Script> LoadScript(const Local<String> &scriptData, const string& path, uint64_t scriptHash, Local<Context> context);
+  Local<Script> createAndGetScript(const Local<String> &scriptData, const string& path, uint64_t scriptHash, Local<Context> context);
   void executeScript(Local<Context> context, const Local<String> &script);
-  ScriptCompiler::CachedData* TryLoadScriptCache(const std::string& path);
   Global<Value> getNativeModule(Local<String> property, const PropertyCallbackInfo<Value> &info);
 
-  String adoptString(std::unique_ptr<const JSBigString>);
+  Local<String> adoptString(std::unique_ptr<const JSBigString> string);
+  Local<String> adoptString(std::string&& string);
+  Local<String> adoptString(folly::StringPiece string);
 
   template<void (V8Executor::*method)(const v8::FunctionCallbackInfo<v8::Value> &args)>
   void installNativeFunctionHook(Local<ObjectTemplate> global, const char *name);
@@ -157,9 +175,32 @@ private:
   void TrySetJSEConfigFromEnv();
 
   Isolate *m_isolate = nullptr; // shared on global
+
+  struct DeferredScriptCache {
+    Global<UnboundScript> script;
+    std::string name;
+    ScriptCacheKey key;
+  };
+  // Scripts compiled without cache, waiting for the cache creation delay to elapse. Only accessed on the JS thread.
+  std::vector<DeferredScriptCache> m_deferredScriptCaches;
+  bool m_isDeferredScriptCacheScheduled = false;
   std::string m_jseLocalPath;
+  // Shared with the background cache writers.
+  std::shared_ptr<V8ScriptCacheStore> m_scriptCacheStore;
   std::shared_ptr<JSEConfigParams> m_jseConfigParams;
 
+  struct PrefetchedScriptCaches {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::pair<ScriptCacheKey, std::unique_ptr<ScriptCompiler::CachedData>>> caches;
+    // Modules JS required before their cache was prefetched, the prefetch thread skips them.
+    std::unordered_set<std::string> requiredModules;
+    std::atomic<bool> isCancelled{false};
+  };
+  // Modules required during the previous launch's startup, their caches are loaded on m_startupPrefetchThread.
+  std::unique_ptr<V8StartupProfile> m_startupProfile;
+  std::shared_ptr<PrefetchedScriptCaches> m_prefetchedScriptCaches;
+  std::thread m_startupPrefetchThread;
+
 };
 }
 #endif //V8_DEMO_V8EXECUTOR_H
@@ -60,8 +60,7 @@ Local<Value> V8NativeModules::createModule(Isolate *isolate, Local<Context> cont
 
   Local<Function> genNativeModuleJS = Local<Function>::New(isolate, m_genNativeModuleJS);
   Local<Integer> moduleId = Integer::NewFromUnsigned(isolate, result->index);
-  Local<String> config = toLocalString(isolate, std::move(folly::toJson(result->config)));
-  Local<Value> configArguments = JSON::Parse(context, config).ToLocalChecked();
+  Local<Value> configArguments = fromDynamic(isolate, context, result->config);
   Local<Value> argv[2] = {configArguments, moduleId};
   Local<Value> res ;
   if(genNativeModuleJS->Call(context, context->Global(), 2, argv).ToLocal(&res)) {
@@ -0,0 +1,222 @@
+#include "V8ScriptCacheStore.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <utime.h>
+#include <v8helpers/V8Utils.h>
+
+namespace v8 {
+
+namespace {
+
+const char* CACHE_FILE_SUFFIX = ".v8cache";
+const uint32_t CACHE_MAGIC = 0x38564e52; // "RNV8"
+const uint32_t CACHE_FORMAT_VERSION = 1;
+
+struct CacheHeader {
+  uint32_t magic;
+  uint32_t formatVersion;
+  uint64_t scriptHash;
+  uint32_t versionTag;
+  uint32_t isFullCache;
+  uint64_t payloadLength;
+  uint64_t payloadChecksum;
+  uint64_t headerChecksum; // Covers all the fields above.
+};
+
+uint64_t HeaderChecksum(const CacheHeader& header) {
+  return V8ScriptCacheStore::Hash(reinterpret_cast<const char*>(&header), offsetof(CacheHeader, headerChecksum));
+}
+
+bool IsCacheFileName(const std::string& fileName) {
+  size_t suffixLength = strlen(CACHE_FILE_SUFFIX);
+  return fileName.size() > suffixLength &&
+    fileName.compare(fileName.size() - suffixLength, suffixLength, CACHE_FILE_SUFFIX) == 0;
+}
+}
+
+V8ScriptCacheStore::V8ScriptCacheStore(std::string directory, uint64_t sizeLimitInBytes) :
+  m_directory(std::move(directory)),
+  m_sizeLimitInBytes(sizeLimitInBytes) {
+}
+
+// FNV-1a over 8 byte words. It only has to catch content changes and corruption, not adversarial input.
+uint64_t V8ScriptCacheStore::Hash(const char* data, size_t length) {
+  const uint64_t prime = 0x100000001b3ULL;
+  uint64_t hash = 0xcbf29ce484222325ULL ^ length;
+
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data + i, sizeof(word));
+    hash = (hash ^ word) * prime;
+  }
+
+  for (; i < length; i++) {
+    hash = (hash ^ static_cast<uint8_t>(data[i])) * prime;
+  }
+
+  // Fold the high bits down, the word wise multiplication only propagates changes upwards.
+  return hash ^ (hash >> 32);
+}
+
+uint64_t V8ScriptCacheStore::HashFileIdentity(const std::string& path, size_t size) {
+  struct stat fileStat;
+  if (stat(path.c_str(), &fileStat) != 0 || !S_ISREG(fileStat.st_mode) || static_cast<uint64_t>(fileStat.st_size) != size) {
+    return 0;
+  }
+
+  std::string identity = path;
+  uint64_t fields[] = { static_cast<uint64_t>(fileStat.st_size), static_cast<uint64_t>(fileStat.st_mtime) };
+  identity.append(reinterpret_cast<const char*>(fields), sizeof(fields));
+  return Hash(identity.data(), identity.size());
+}
+
+std::string V8ScriptCacheStore::PathFor(const std::string& name) const {
+  return m_directory + "/" + name + CACHE_FILE_SUFFIX;
+}
+
+ScriptCompiler::CachedData* V8ScriptCacheStore::TryLoad(const std::string& name, const ScriptCacheKey& key) {
+  // Save and the eviction may run on another thread; they could delete the entry while it's read.
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  std::string path = PathFor(name);
+  FILE* file = fopen(path.c_str(), "rb");
+  if (!file) {
+    return nullptr;
+  }
+
+  CacheHeader header;
+  bool isValid = fread(&header, sizeof(header), 1, file) == 1 &&
+    header.magic == CACHE_MAGIC &&
+    header.formatVersion == CACHE_FORMAT_VERSION &&
+    header.headerChecksum == HeaderChecksum(header) &&
+    header.scriptHash == key.scriptHash &&
+    header.versionTag == key.versionTag &&
+    header.isFullCache == (key.isFullCache ? 1u : 0u) &&
+    header.payloadLength > 0 &&
+    header.payloadLength <= INT_MAX;
+
+  // CachedData::BufferOwned releases the buffer with delete[].
+  uint8_t* payload = nullptr;
+  if (isValid) {
+    payload = new uint8_t[header.payloadLength];
+    isValid = fread(payload, 1, header.payloadLength, file) == header.payloadLength &&
+      Hash(reinterpret_cast<const char*>(payload), header.payloadLength) == header.payloadChecksum;
+  }
+  fclose(file);
+
+  if (!isValid) {
+    delete[] payload;
+    int status = remove(path.c_str());
+    LOGI("V8ScriptCacheStore::TryLoad stale or corrupt cache %s. Cache delete status: %d", path.c_str(), status);
+    return nullptr;
+  }
+
+  // The modification time doubles as the last use time for the eviction.
+  utime(path.c_str(), nullptr);
+
+  return new ScriptCompiler::CachedData(payload, static_cast<int>(header.payloadLength), ScriptCompiler::CachedData::BufferOwned);
+}
+
+bool V8ScriptCacheStore::Save(const std::string& name, const ScriptCacheKey& key, const uint8_t* data, int length) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  CacheHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = CACHE_MAGIC;
+  header.formatVersion = CACHE_FORMAT_VERSION;
+  header.scriptHash = key.scriptHash;
+  header.versionTag = key.versionTag;
+  header.isFullCache = key.isFullCache ? 1u : 0u;
+  header.payloadLength = static_cast<uint64_t>(length);
+  header.payloadChecksum = Hash(reinterpret_cast<const char*>(data), length);
+  header.headerChecksum = HeaderChecksum(header);
+
+  // Write to a temporary file and rename, so readers never see a partially written entry.
+  std::string path = PathFor(name);
+  std::string tempPath = path + ".tmp";
+  FILE* file = fopen(tempPath.c_str(), "wb");
+  if (!file) {
+    return false;
+  }
+
+  bool isWritten = fwrite(&header, sizeof(header), 1, file) == 1 &&
+    fwrite(data, 1, length, file) == static_cast<size_t>(length);
+  isWritten = (fclose(file) == 0) && isWritten;
+
+  if (!isWritten || rename(tempPath.c_str(), path.c_str()) != 0) {
+    remove(tempPath.c_str());
+    return false;
+  }
+
+  EnforceSizeLimit();
+  return true;
+}
+
+void V8ScriptCacheStore::Remove(const std::string& name) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  remove(PathFor(name).c_str());
+}
+
+void V8ScriptCacheStore::EnforceSizeLimit() {
+  if (m_sizeLimitInBytes == 0) {
+    return;
+  }
+
+  DIR* dir = opendir(m_directory.c_str());
+  if (!dir) {
+    return;
+  }
+
+  struct Entry {
+    std::string path;
+    uint64_t size;
+    time_t lastUsed;
+  };
+
+  std::vector<Entry> entries;
+  uint64_t totalSize = 0;
+  while (dirent* dirEntry = readdir(dir)) {
+    std::string fileName(dirEntry->d_name);
+    if (!IsCacheFileName(fileName)) {
+      continue;
+    }
+
+    std::string path = m_directory + "/" + fileName;
+    struct stat fileStat;
+    if (stat(path.c_str(), &fileStat) != 0) {
+      continue;
+    }
+
+    entries.push_back({ path, static_cast<uint64_t>(fileStat.st_size), fileStat.st_mtime });
+    totalSize += fileStat.st_size;
+  }
+  closedir(dir);
+
+  if (totalSize <= m_sizeLimitInBytes) {
+    return;
+  }
+
+  std::sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) {
+    return lhs.lastUsed < rhs.lastUsed;
+  });
+
+  for (const auto& entry : entries) {
+    if (totalSize <= m_sizeLimitInBytes) {
+      break;
+    }
+
+    if (remove(entry.path.c_str()) == 0) {
+      LOGI("V8ScriptCacheStore::EnforceSizeLimit evicted %s", entry.path.c_str());
+      totalSize -= entry.size;
+    }
+  }
+}
+}
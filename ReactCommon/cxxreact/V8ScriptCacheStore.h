@@ -0,0 +1,58 @@
+#ifndef V8_V8SCRIPTCACHESTORE_H
+#define V8_V8SCRIPTCACHESTORE_H
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include "v8.h"
+
+namespace v8 {
+
+/*
+ * Identifies the inputs a code cache was produced from. V8 rejects a cache produced
+ * for a different source, V8 build or set of flags, so all of them go into the key.
+ */
+struct ScriptCacheKey {
+  uint64_t scriptHash;
+  uint32_t versionTag; // ScriptCompiler::CachedDataVersionTag(), covers V8 version and flags.
+  bool isFullCache;
+};
+
+/*
+ * Stores one code cache file per script name in a directory. Each file starts with a header
+ * holding the key, the payload length and checksums, which are validated before the payload
+ * is handed to V8, so stale or partially written entries never cost a failed deserialization.
+ * When a size limit is set, the least recently used entries are evicted to stay under it.
+ * All the methods may be called from any thread.
+ */
+class V8ScriptCacheStore {
+public:
+  // A sizeLimitInBytes of 0 means no limit.
+  V8ScriptCacheStore(std::string directory, uint64_t sizeLimitInBytes);
+
+  // Returns null if there is no valid entry for the key. Invalid entries are deleted.
+  ScriptCompiler::CachedData* TryLoad(const std::string& name, const ScriptCacheKey& key);
+
+  bool Save(const std::string& name, const ScriptCacheKey& key, const uint8_t* data, int length);
+
+  void Remove(const std::string& name);
+
+  static uint64_t Hash(const char* data, size_t length);
+
+  // Hashes the path, size and modification time of a file, which is much cheaper than hashing the
+  // content of a large bundle on every launch. Returns 0 if the path is not a file of the given size.
+  static uint64_t HashFileIdentity(const std::string& path, size_t size);
+
+private:
+  std::string PathFor(const std::string& name) const;
+  void EnforceSizeLimit();
+
+  std::string m_directory;
+  uint64_t m_sizeLimitInBytes;
+  std::mutex m_mutex;
+};
+}
+
+#endif //V8_V8SCRIPTCACHESTORE_H
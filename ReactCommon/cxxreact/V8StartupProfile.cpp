@@ -0,0 +1,124 @@
+#include "V8StartupProfile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include "V8ScriptCacheStore.h"
+#include <v8helpers/V8Utils.h>
+
+namespace v8 {
+
+namespace {
+
+const uint32_t PROFILE_MAGIC = 0x50534e52; // "RNSP"
+const uint32_t PROFILE_FORMAT_VERSION = 1;
+// Startup requires a few hundred modules, anything far beyond that is not a profile worth trusting.
+const uint32_t MAX_PROFILE_MODULES = 1 << 16;
+
+struct ProfileHeader {
+  uint32_t magic;
+  uint32_t formatVersion;
+  uint32_t moduleCount;
+  uint32_t reserved;
+  uint64_t modulesChecksum;
+};
+
+uint64_t ModulesChecksum(const std::vector<StartupModule>& modules) {
+  return V8ScriptCacheStore::Hash(reinterpret_cast<const char*>(modules.data()), modules.size() * sizeof(StartupModule));
+}
+
+bool AreEqual(const std::vector<StartupModule>& lhs, const std::vector<StartupModule>& rhs) {
+  return lhs.size() == rhs.size() &&
+    std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](const StartupModule& l, const StartupModule& r) {
+      return l.bundleId == r.bundleId && l.moduleId == r.moduleId;
+    });
+}
+}
+
+V8StartupProfile::V8StartupProfile(std::string path) :
+  m_path(std::move(path)),
+  m_previousModules(Load(m_path)) {
+}
+
+void V8StartupProfile::RecordRequire(uint32_t bundleId, uint32_t moduleId) {
+  if (!m_isRecording || m_modules.size() >= MAX_PROFILE_MODULES) {
+    return;
+  }
+
+  if (m_recordedModules.insert((static_cast<uint64_t>(bundleId) << 32) | moduleId).second) {
+    m_modules.push_back({ bundleId, moduleId });
+  }
+}
+
+void V8StartupProfile::StopRecordingAndSaveAsync() {
+  if (!m_isRecording) {
+    return;
+  }
+  m_isRecording = false;
+  m_recordedModules.clear();
+
+  if (AreEqual(m_modules, m_previousModules)) {
+    return;
+  }
+
+  std::thread([path = m_path, modules = std::move(m_modules)]() {
+    if (!Save(path, modules)) {
+      LOGI("V8StartupProfile::SaveAsync failed to write %s", path.c_str());
+    }
+  }).detach();
+}
+
+std::vector<StartupModule> V8StartupProfile::Load(const std::string& path) {
+  std::vector<StartupModule> modules;
+  FILE* file = fopen(path.c_str(), "rb");
+  if (!file) {
+    return modules;
+  }
+
+  ProfileHeader header;
+  bool isValid = fread(&header, sizeof(header), 1, file) == 1 &&
+    header.magic == PROFILE_MAGIC &&
+    header.formatVersion == PROFILE_FORMAT_VERSION &&
+    header.moduleCount <= MAX_PROFILE_MODULES;
+
+  if (isValid) {
+    modules.resize(header.moduleCount);
+    isValid = fread(modules.data(), sizeof(StartupModule), modules.size(), file) == modules.size() &&
+      ModulesChecksum(modules) == header.modulesChecksum;
+  }
+  fclose(file);
+
+  if (!isValid) {
+    LOGI("V8StartupProfile::Load ignoring corrupt profile %s", path.c_str());
+    modules.clear();
+  }
+  return modules;
+}
+
+bool V8StartupProfile::Save(const std::string& path, const std::vector<StartupModule>& modules) {
+  ProfileHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = PROFILE_MAGIC;
+  header.formatVersion = PROFILE_FORMAT_VERSION;
+  header.moduleCount = static_cast<uint32_t>(modules.size());
+  header.modulesChecksum = ModulesChecksum(modules);
+
+  // Same as the code caches, write to a temporary file and rename so the next launch never reads a partial profile.
+  std::string tempPath = path + ".tmp";
+  FILE* file = fopen(tempPath.c_str(), "wb");
+  if (!file) {
+    return false;
+  }
+
+  bool isWritten = fwrite(&header, sizeof(header), 1, file) == 1 &&
+    fwrite(modules.data(), sizeof(StartupModule), modules.size(), file) == modules.size();
+  isWritten = (fclose(file) == 0) && isWritten;
+
+  if (!isWritten || rename(tempPath.c_str(), path.c_str()) != 0) {
+    remove(tempPath.c_str());
+    return false;
+  }
+  return true;
+}
+}
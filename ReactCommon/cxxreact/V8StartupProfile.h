@@ -0,0 +1,51 @@
+#ifndef V8_V8STARTUPPROFILE_H
+#define V8_V8STARTUPPROFILE_H
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace v8 {
+
+struct StartupModule {
+  uint32_t bundleId;
+  uint32_t moduleId;
+};
+
+/*
+ * Records the RAM bundle modules required while the React context is created, in the order
+ * they were first required, and persists them so that the next launch knows which modules
+ * startup needs before JS asks for them. The file carries a checksum, a missing or corrupt
+ * profile reads as empty. Only accessed on the JS thread, except for SaveAsync's writer.
+ */
+class V8StartupProfile {
+public:
+  // Loads the profile recorded by the previous launch, if any, and starts recording a new one.
+  explicit V8StartupProfile(std::string path);
+
+  const std::vector<StartupModule>& GetPreviousModules() const { return m_previousModules; }
+
+  bool IsRecording() const { return m_isRecording; }
+
+  // Ignored once recording stopped, or if the module was already recorded.
+  void RecordRequire(uint32_t bundleId, uint32_t moduleId);
+
+  // Stops recording and writes the profile off the JS thread, unless it matches the previous one.
+  void StopRecordingAndSaveAsync();
+
+private:
+  static std::vector<StartupModule> Load(const std::string& path);
+  static bool Save(const std::string& path, const std::vector<StartupModule>& modules);
+
+  std::string m_path;
+  std::vector<StartupModule> m_previousModules;
+  std::vector<StartupModule> m_modules;
+  std::unordered_set<uint64_t> m_recordedModules;
+  bool m_isRecording = true;
+};
+}
+
+#endif //V8_V8STARTUPPROFILE_H
@@ -0,0 +1,112 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <cstring>
+#include <vector>
+
+#include <folly/Memory.h>
+#include <gtest/gtest.h>
+#include <cxxreact/JSIndexedRAMBundle.h>
+
+using namespace facebook;
+using namespace facebook::react;
+
+namespace {
+
+// Lays out a bundle the way the indexed RAM bundle format expects it: a
+// header, the module table, then NULL terminated startup code and modules.
+// Modules with empty code get an empty table entry.
+std::unique_ptr<const JSBigString> makeBundle(
+    const std::string& startupCode,
+    const std::vector<std::string>& modules) {
+  std::string body = startupCode + '\0';
+  std::vector<uint32_t> table;
+  for (const auto& code : modules) {
+    if (code.empty()) {
+      table.push_back(0);
+      table.push_back(0);
+    } else {
+      table.push_back(body.size());
+      table.push_back(code.size() + 1);
+      body += code + '\0';
+    }
+  }
+
+  uint32_t header[] = {
+    0xFB0BD1E5,
+    static_cast<uint32_t>(modules.size()),
+    static_cast<uint32_t>(startupCode.size() + 1),
+  };
+  std::string bundle(reinterpret_cast<const char *>(header), sizeof(header));
+  bundle.append(
+    reinterpret_cast<const char *>(table.data()),
+    table.size() * sizeof(uint32_t));
+  bundle += body;
+  return folly::make_unique<JSBigStdString>(bundle);
+}
+
+}
+
+TEST(JSIndexedRAMBundle, ReadsStartupCode) {
+  JSIndexedRAMBundle bundle(makeBundle("startup();", {"a();"}));
+
+  auto startupCode = bundle.getStartupCode();
+  EXPECT_EQ("startup();", std::string(startupCode->c_str(), startupCode->size()));
+}
+
+TEST(JSIndexedRAMBundle, GetModule) {
+  JSIndexedRAMBundle bundle(makeBundle("startup();", {"a();", "", "c();"}));
+
+  auto module = bundle.getModule(2);
+  EXPECT_EQ("2.js", module.name);
+  EXPECT_EQ("c();", module.code);
+}
+
+TEST(JSIndexedRAMBundle, GetModuleViewMatchesGetModule) {
+  JSIndexedRAMBundle bundle(makeBundle("startup();", {"a();", "", "c();"}));
+
+  for (uint32_t moduleId : {0, 2}) {
+    auto module = bundle.getModule(moduleId);
+    auto view = bundle.getModuleView(moduleId);
+    EXPECT_EQ(module.name, view.name);
+    EXPECT_EQ(module.code, view.code.str());
+  }
+}
+
+TEST(JSIndexedRAMBundle, GetModuleViewIsStable) {
+  JSIndexedRAMBundle bundle(makeBundle("startup();", {"a();"}));
+
+  auto first = bundle.getModuleView(0);
+  auto second = bundle.getModuleView(0);
+  EXPECT_EQ(first.code.data(), second.code.data());
+}
+
+TEST(JSIndexedRAMBundle, MissingModulesThrow) {
+  JSIndexedRAMBundle bundle(makeBundle("startup();", {"a();", ""}));
+
+  EXPECT_THROW(bundle.getModule(1), std::exception);
+  EXPECT_THROW(bundle.getModuleView(1), std::exception);
+  EXPECT_THROW(bundle.getModuleView(2), std::exception);
+}
+
+TEST(JSIndexedRAMBundle, PrefetchIgnoresMissingModules) {
+  JSIndexedRAMBundle bundle(makeBundle("startup();", {"a();", ""}));
+
+  bundle.prefetchModules({0, 1, 2});
+  EXPECT_EQ("a();", bundle.getModule(0).code);
+}
+
+TEST(JSIndexedRAMBundle, TruncatedBundleThrows) {
+  auto complete = makeBundle("startup();", {"a();"});
+
+  std::string truncatedModule(complete->c_str(), complete->size() - 2);
+  JSIndexedRAMBundle bundle(folly::make_unique<JSBigStdString>(truncatedModule));
+  EXPECT_THROW(bundle.getModuleView(0), std::exception);
+
+  std::string truncatedHeader(complete->c_str(), 8);
+  EXPECT_THROW(
+    JSIndexedRAMBundle(folly::make_unique<JSBigStdString>(truncatedHeader)),
+    std::exception);
+}
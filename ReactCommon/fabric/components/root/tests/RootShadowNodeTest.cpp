@@ -6,9 +6,313 @@
  */
 
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
+#include <react/components/root/RootComponentDescriptor.h>
+#include <react/components/view/ViewComponentDescriptor.h>
+
+using namespace facebook::react;
 
 TEST(RootShadowNodeTest, testSomething) {
   // TODO
 }
+
+/*
+ * Builds a small flexbox tree whose layout depends on `seed`. Every call
+ * creates new nodes, so trees built on different threads share nothing.
+ */
+static std::shared_ptr<RootShadowNode> treeWithSeed(
+    int seed,
+    RootComponentDescriptor const &rootComponentDescriptor,
+    ViewComponentDescriptor const &viewComponentDescriptor,
+    LayoutContext const &layoutContext = {}) {
+  auto tag = Tag{2};
+  auto view = [&](folly::dynamic const &style, SharedShadowNodeList children) {
+    return std::make_shared<ViewShadowNode>(
+        ShadowNodeFragment{
+            /* .tag = */ tag++,
+            /* .surfaceId = */ seed,
+            /* .props = */
+            std::make_shared<ViewProps const>(ViewProps(), RawProps(style)),
+            /* .eventEmitter = */ ShadowNodeFragment::eventEmitterPlaceholder(),
+            /* .children = */
+            std::make_shared<SharedShadowNodeList>(std::move(children)),
+        },
+        viewComponentDescriptor);
+  };
+
+  auto rows = SharedShadowNodeList{};
+  for (int row = 0; row < 10; row++) {
+    auto cells = SharedShadowNodeList{};
+    for (int cell = 0; cell < 5; cell++) {
+      cells.push_back(view(
+          folly::dynamic::object("flexGrow", (seed + row + cell) % 3)(
+              "flexBasis", 10 * cell)("margin", seed % 4),
+          {}));
+    }
+    rows.push_back(view(
+        folly::dynamic::object("flexDirection", "row")(
+            "height", 20 + (seed * row) % 7)("padding", row % 3),
+        std::move(cells)));
+  }
+
+  auto layoutConstraints = LayoutConstraints{};
+  layoutConstraints.minimumSize = Size{100.0f + seed, 0};
+  layoutConstraints.maximumSize = Size{100.0f + seed, 1000};
+
+  return std::make_shared<RootShadowNode>(
+      ShadowNodeFragment{
+          /* .tag = */ 1,
+          /* .surfaceId = */ seed,
+          /* .props = */
+          std::make_shared<RootProps const>(
+              *RootShadowNode::defaultSharedProps(),
+              layoutConstraints,
+              layoutContext),
+          /* .eventEmitter = */ ShadowNodeFragment::eventEmitterPlaceholder(),
+          /* .children = */
+          std::make_shared<SharedShadowNodeList>(std::move(rows)),
+      },
+      rootComponentDescriptor);
+}
+
+static void collectFrames(
+    ShadowNode const &shadowNode,
+    std::vector<Rect> &frames) {
+  auto layoutableShadowNode =
+      dynamic_cast<LayoutableShadowNode const *>(&shadowNode);
+  frames.push_back(layoutableShadowNode->getLayoutMetrics().frame);
+  for (auto const &child : shadowNode.getChildren()) {
+    collectFrames(*child, frames);
+  }
+}
+
+/*
+ * Independent surfaces are laid out concurrently; every tree must get the
+ * same layout as when it is laid out alone.
+ */
+TEST(RootShadowNodeTest, concurrentLayoutOfIndependentTrees) {
+  auto const threadCount = 8;
+  auto const iterationCount = 50;
+
+  auto rootComponentDescriptor = RootComponentDescriptor{nullptr};
+  auto viewComponentDescriptor = ViewComponentDescriptor{nullptr};
+
+  auto expectedFrames = std::vector<std::vector<Rect>>(threadCount);
+  for (int seed = 0; seed < threadCount; seed++) {
+    auto rootShadowNode = treeWithSeed(
+        seed, rootComponentDescriptor, viewComponentDescriptor);
+    rootShadowNode->layout();
+    collectFrames(*rootShadowNode, expectedFrames[seed]);
+  }
+
+  auto actualFrames = std::vector<std::vector<std::vector<Rect>>>(
+      threadCount, std::vector<std::vector<Rect>>(iterationCount));
+  auto threads = std::vector<std::thread>{};
+  for (int seed = 0; seed < threadCount; seed++) {
+    threads.emplace_back([&, seed]() {
+      for (int iteration = 0; iteration < iterationCount; iteration++) {
+        auto rootShadowNode = treeWithSeed(
+            seed, rootComponentDescriptor, viewComponentDescriptor);
+        rootShadowNode->layout();
+        collectFrames(*rootShadowNode, actualFrames[seed][iteration]);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  for (int seed = 0; seed < threadCount; seed++) {
+    for (auto const &frames : actualFrames[seed]) {
+      EXPECT_EQ(frames, expectedFrames[seed]);
+    }
+  }
+}
+
+/*
+ * Layout which runs subtrees on several threads must produce exactly the same
+ * result as the serial one.
+ */
+TEST(RootShadowNodeTest, parallelLayoutMatchesSerialLayout) {
+  auto rootComponentDescriptor = RootComponentDescriptor{nullptr};
+  auto viewComponentDescriptor = ViewComponentDescriptor{nullptr};
+
+  auto parallelLayoutContext = LayoutContext{};
+  parallelLayoutContext.parallelLayout = true;
+
+  for (int seed = 0; seed < 16; seed++) {
+    auto serialRootShadowNode = treeWithSeed(
+        seed, rootComponentDescriptor, viewComponentDescriptor);
+    serialRootShadowNode->layout();
+    auto serialFrames = std::vector<Rect>{};
+    collectFrames(*serialRootShadowNode, serialFrames);
+
+    auto parallelRootShadowNode = treeWithSeed(
+        seed,
+        rootComponentDescriptor,
+        viewComponentDescriptor,
+        parallelLayoutContext);
+    parallelRootShadowNode->layout();
+    auto parallelFrames = std::vector<Rect>{};
+    collectFrames(*parallelRootShadowNode, parallelFrames);
+
+    EXPECT_EQ(parallelFrames, serialFrames);
+  }
+}
+
+struct IncrementalLayout {
+  std::vector<Tag> affectedTags;
+  std::vector<Rect> frames;
+  std::vector<Rect> expectedFrames;
+  bool cardIsRelayoutBoundary;
+};
+
+/*
+ * Lays out a tree with a card, changes the height of the content of the card
+ * and lays the tree out again. Returns what the second layout affected, and
+ * its frames along with the frames of a full layout of the same tree.
+ */
+static IncrementalLayout layOutChangedCard(
+    folly::dynamic const &cardStyle,
+    double headerHeight,
+    double contentHeight,
+    double newContentHeight,
+    Float pointScaleFactor = 1) {
+  auto rootComponentDescriptor = RootComponentDescriptor{nullptr};
+  auto viewComponentDescriptor = ViewComponentDescriptor{nullptr};
+
+  auto viewProps = [](folly::dynamic const &style) {
+    return std::make_shared<ViewProps const>(ViewProps(), RawProps(style));
+  };
+  auto view = [&](Tag tag,
+                  folly::dynamic const &style,
+                  SharedShadowNodeList children) {
+    return std::make_shared<ViewShadowNode>(
+        ShadowNodeFragment{
+            /* .tag = */ tag,
+            /* .surfaceId = */ 1,
+            /* .props = */ viewProps(style),
+            /* .eventEmitter = */ ShadowNodeFragment::eventEmitterPlaceholder(),
+            /* .children = */
+            std::make_shared<SharedShadowNodeList>(std::move(children)),
+        },
+        viewComponentDescriptor);
+  };
+  auto contentStyle = [](double height) {
+    return folly::dynamic::object("height", height)("margin", 3);
+  };
+  auto tree = [&](SharedShadowNode const &content) {
+    auto layoutConstraints = LayoutConstraints{};
+    layoutConstraints.minimumSize = Size{200, 0};
+    layoutConstraints.maximumSize = Size{200, 1000};
+    auto layoutContext = LayoutContext{};
+    layoutContext.pointScaleFactor = pointScaleFactor;
+
+    return std::make_shared<RootShadowNode>(
+        ShadowNodeFragment{
+            /* .tag = */ 1,
+            /* .surfaceId = */ 1,
+            /* .props = */
+            std::make_shared<RootProps const>(
+                *RootShadowNode::defaultSharedProps(),
+                layoutConstraints,
+                layoutContext),
+            /* .eventEmitter = */ ShadowNodeFragment::eventEmitterPlaceholder(),
+            /* .children = */
+            std::make_shared<SharedShadowNodeList>(SharedShadowNodeList{
+                view(2, folly::dynamic::object("height", headerHeight), {}),
+                view(3, cardStyle, {content}),
+                view(5, folly::dynamic::object("flexGrow", 1), {}),
+            }),
+        },
+        rootComponentDescriptor);
+  };
+
+  auto content = view(4, contentStyle(contentHeight), {});
+  auto rootShadowNode = tree(content);
+  rootShadowNode->layout();
+  rootShadowNode->sealRecursive();
+
+  auto result = IncrementalLayout{};
+  result.cardIsRelayoutBoundary =
+      dynamic_cast<LayoutableShadowNode const &>(
+          *rootShadowNode->getChildren().at(1))
+          .isRelayoutBoundary();
+
+  auto newContent = content->clone(ShadowNodeFragment{
+      /* .tag = */ ShadowNodeFragment::tagPlaceholder(),
+      /* .surfaceId = */ ShadowNodeFragment::surfaceIdPlaceholder(),
+      /* .props = */ viewProps(contentStyle(newContentHeight)),
+  });
+  auto newRootShadowNode = rootShadowNode->clone(content, newContent);
+
+  auto affectedNodes = std::vector<LayoutableShadowNode const *>{};
+  newRootShadowNode->layout(&affectedNodes);
+  for (auto affectedNode : affectedNodes) {
+    result.affectedTags.push_back(
+        dynamic_cast<ShadowNode const *>(affectedNode)->getTag());
+  }
+  collectFrames(*newRootShadowNode, result.frames);
+
+  auto expectedRootShadowNode =
+      tree(view(4, contentStyle(newContentHeight), {}));
+  expectedRootShadowNode->layout();
+  collectFrames(*expectedRootShadowNode, result.expectedFrames);
+
+  return result;
+}
+
+/*
+ * A change inside of a node with a fixed size must not relayout the rest of
+ * the tree, but the result must be the same as a full layout.
+ */
+TEST(RootShadowNodeTest, relayoutBoundaryIsLaidOutOnItsOwn) {
+  auto const result = layOutChangedCard(
+      folly::dynamic::object("width", 100)("height", 80)("padding", 5)(
+          "alignSelf", "center"),
+      30,
+      10,
+      40);
+
+  EXPECT_TRUE(result.cardIsRelayoutBoundary);
+  // Only the content changed its frame.
+  EXPECT_EQ(result.affectedTags, std::vector<Tag>{4});
+  EXPECT_EQ(result.frames, result.expectedFrames);
+}
+
+/*
+ * The content of a relayout boundary which is not aligned to the pixel grid
+ * is rounded relative to the root, as in a full layout.
+ */
+TEST(RootShadowNodeTest, relayoutBoundaryIsRoundedLikeFullLayout) {
+  for (auto pointScaleFactor : {1.0, 2.0, 3.0}) {
+    auto const result = layOutChangedCard(
+        folly::dynamic::object("width", 100.5)("height", 80)("padding", 5),
+        10.3,
+        10.4,
+        40.4,
+        pointScaleFactor);
+
+    EXPECT_TRUE(result.cardIsRelayoutBoundary);
+    EXPECT_EQ(result.affectedTags, std::vector<Tag>{4});
+    EXPECT_EQ(result.frames, result.expectedFrames);
+  }
+}
+
+/*
+ * Percentages of margins and positions depend on the parent, so such nodes
+ * are laid out along with it.
+ */
+TEST(RootShadowNodeTest, percentMarginsAndPositionsAreNotRelayoutBoundaries) {
+  for (auto edge : {"margin", "marginTop", "left"}) {
+    folly::dynamic cardStyle =
+        folly::dynamic::object("width", 100)("height", 80)(edge, "10%");
+    auto const result = layOutChangedCard(cardStyle, 30, 10, 40);
+
+    EXPECT_FALSE(result.cardIsRelayoutBoundary);
+    EXPECT_EQ(result.frames, result.expectedFrames);
+  }
+}
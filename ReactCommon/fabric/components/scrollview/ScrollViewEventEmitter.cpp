@@ -60,7 +60,10 @@ static jsi::Value scrollViewMetricsPayload(
 
 void ScrollViewEventEmitter::onScroll(
     const ScrollViewMetrics &scrollViewMetrics) const {
-  dispatchScrollViewEvent("scroll", scrollViewMetrics);
+  // Only the latest scroll position matters.
+  dispatchContinuousEvent("scroll", [scrollViewMetrics](jsi::Runtime &runtime) {
+    return scrollViewMetricsPayload(runtime, scrollViewMetrics);
+  });
 }
 
 void ScrollViewEventEmitter::onScrollBeginDrag(
@@ -33,9 +33,35 @@ class ParagraphComponentDescriptor final
     // a shared `TextLayoutManager`.
     textLayoutManager_ = std::make_shared<TextLayoutManager>(contextContainer);
     // Every single `ParagraphShadowNode` will have a reference to
-    // a shared `EvictingCacheMap`, a simple LRU cache for Paragraph
+    // a shared `ParagraphMeasurementCache`, a simple LRU cache for Paragraph
     // measurements.
-    measureCache_ = std::make_unique<ParagraphMeasurementCache>();
+    auto capacity = int64_t{0};
+    auto widthBucket = double{0};
+    auto reactNativeConfig = std::shared_ptr<const ReactNativeConfig>{};
+    if (contextContainer) {
+      reactNativeConfig =
+          contextContainer
+              ->findInstance<std::shared_ptr<const ReactNativeConfig>>(
+                  "ReactNativeConfig")
+              .value_or(nullptr);
+    }
+    if (reactNativeConfig) {
+      capacity = reactNativeConfig->getInt64(
+          "react_fabric:paragraph_measurement_cache_capacity");
+      widthBucket = reactNativeConfig->getDouble(
+          "react_fabric:paragraph_measurement_cache_width_bucket");
+    }
+    // Paragraphs which are going to be measured during a layout pass are
+    // measured all at once, with a single call to the platform.
+    measureCache_ = std::make_unique<ParagraphMeasurementCache>(
+        capacity > 0 ? (int)capacity
+                     : ParagraphMeasurementCache::DefaultCapacity,
+        widthBucket > 0 ? (Float)widthBucket
+                        : ParagraphMeasurementCache::DefaultWidthBucket,
+        [textLayoutManager = textLayoutManager_](
+            TextMeasureRequestList const &requests) {
+          return textLayoutManager->measureBatch(requests);
+        });
   }
 
  protected:
@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "ParagraphMeasurementCache.h"
+
+#include <cmath>
+#include <utility>
+
+namespace facebook {
+namespace react {
+
+#pragma mark - ParagraphMeasurementContent
+
+ParagraphMeasurementContent::ParagraphMeasurementContent(
+    AttributedString const &attributedString,
+    ParagraphAttributes const &paragraphAttributes)
+    : paragraphAttributes_(paragraphAttributes),
+      hash_(std::hash<ParagraphAttributes>{}(paragraphAttributes)) {
+  for (auto const &fragment : attributedString.getFragments()) {
+    auto attachmentSize = fragment.shadowView.componentHandle
+        ? fragment.shadowView.layoutMetrics.frame.size
+        : Size{};
+    fragments_.push_back(
+        {fragment.string, fragment.textAttributes, attachmentSize});
+    hash_ = folly::hash::hash_combine(
+        hash_, fragment.string, fragment.textAttributes, attachmentSize);
+  }
+}
+
+size_t ParagraphMeasurementContent::getHash() const {
+  return hash_;
+}
+
+bool ParagraphMeasurementContent::Fragment::operator==(
+    Fragment const &rhs) const {
+  return std::tie(string, textAttributes, attachmentSize) ==
+      std::tie(rhs.string, rhs.textAttributes, rhs.attachmentSize);
+}
+
+bool ParagraphMeasurementContent::operator==(
+    ParagraphMeasurementContent const &rhs) const {
+  return hash_ == rhs.hash_ && fragments_ == rhs.fragments_ &&
+      paragraphAttributes_ == rhs.paragraphAttributes_;
+}
+
+bool ParagraphMeasurementContent::operator!=(
+    ParagraphMeasurementContent const &rhs) const {
+  return !(*this == rhs);
+}
+
+#pragma mark - ParagraphMeasurementCacheKey
+
+bool ParagraphMeasurementCacheKey::operator==(
+    ParagraphMeasurementCacheKey const &rhs) const {
+  return layoutConstraints == rhs.layoutConstraints &&
+      (content == rhs.content || *content == *rhs.content);
+}
+
+#pragma mark - ParagraphMeasurementCache
+
+constexpr int ParagraphMeasurementCache::DefaultCapacity;
+constexpr Float ParagraphMeasurementCache::DefaultWidthBucket;
+
+ParagraphMeasurementCache::ParagraphMeasurementCache(
+    int capacity,
+    Float widthBucket,
+    MeasureBatchFunction measureBatch)
+    : widthBucket_(widthBucket),
+      cache_(capacity),
+      measureBatch_(std::move(measureBatch)) {
+  assert(capacity > 0 && "Capacity must be positive.");
+  assert(widthBucket >= 0 && "Width bucket must not be negative.");
+}
+
+Size ParagraphMeasurementCache::get(
+    ParagraphMeasurementContent::Shared const &content,
+    LayoutConstraints const &layoutConstraints,
+    std::function<Size(LayoutConstraints const &layoutConstraints)> const
+        &measure) const {
+  if (hasScheduledRequests_) {
+    measureScheduledRequests();
+  }
+
+  auto key = ParagraphMeasurementCacheKey{
+      content, bucketLayoutConstraints(layoutConstraints)};
+  auto size = cache_.get(key, [&](ParagraphMeasurementCacheKey const &key) {
+    return measure(key.layoutConstraints);
+  });
+  return layoutConstraints.clamp(size);
+}
+
+void ParagraphMeasurementCache::schedule(
+    ParagraphMeasurementContent::Shared const &content,
+    TextMeasureRequest request) const {
+  if (!measureBatch_) {
+    return;
+  }
+
+  request.layoutConstraints =
+      bucketLayoutConstraints(request.layoutConstraints);
+  auto key = ParagraphMeasurementCacheKey{content, request.layoutConstraints};
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  scheduledRequests_.emplace(std::move(key), std::move(request));
+  hasScheduledRequests_ = true;
+}
+
+void ParagraphMeasurementCache::measureScheduledRequests() const {
+  auto scheduledRequests =
+      std::unordered_map<ParagraphMeasurementCacheKey, TextMeasureRequest>{};
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::swap(scheduledRequests, scheduledRequests_);
+    hasScheduledRequests_ = false;
+  }
+
+  auto keys = std::vector<ParagraphMeasurementCacheKey>{};
+  keys.reserve(scheduledRequests.size());
+  for (auto const &pair : scheduledRequests) {
+    keys.push_back(pair.first);
+  }
+
+  cache_.generate(
+      keys, [&](std::vector<ParagraphMeasurementCacheKey> const &keys) {
+        auto requests = TextMeasureRequestList{};
+        requests.reserve(keys.size());
+        for (auto const &key : keys) {
+          requests.push_back(std::move(scheduledRequests.at(key)));
+        }
+        return measureBatch_(requests);
+      });
+}
+
+ParagraphMeasurementCache::Cache::Statistics
+ParagraphMeasurementCache::getStatistics() const {
+  return cache_.getStatistics();
+}
+
+LayoutConstraints ParagraphMeasurementCache::bucketLayoutConstraints(
+    LayoutConstraints const &layoutConstraints) const {
+  auto maximumWidth = layoutConstraints.maximumSize.width;
+  if (widthBucket_ == 0 || !std::isfinite(maximumWidth)) {
+    return layoutConstraints;
+  }
+
+  // Rounding up never makes the text wrap earlier than it would in the
+  // original width; `get` clamps the result back to the original constraints.
+  // The small tolerance keeps values like `375.00003` (a result of floating
+  // point arithmetic in Yoga) in the same bucket as `375`.
+  auto const tolerance = Float{0.001};
+  auto bucketedConstraints = layoutConstraints;
+  bucketedConstraints.maximumSize.width =
+      std::ceil(maximumWidth / widthBucket_ - tolerance) * widthBucket_;
+  return bucketedConstraints;
+}
+
+} // namespace react
+} // namespace facebook
@@ -7,21 +7,160 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <better/small_vector.h>
 #include <react/attributedstring/AttributedString.h>
 #include <react/attributedstring/ParagraphAttributes.h>
 #include <react/core/LayoutConstraints.h>
+#include <react/graphics/Geometry.h>
+#include <react/textlayoutmanager/TextMeasureRequest.h>
 #include <react/utils/SimpleThreadSafeCache.h>
 
 namespace facebook {
 namespace react {
 
-using ParagraphMeasurementCacheKey =
-    std::tuple<AttributedString, ParagraphAttributes, LayoutConstraints>;
-using ParagraphMeasurementCacheValue = Size;
-using ParagraphMeasurementCache = SimpleThreadSafeCache<
-    ParagraphMeasurementCacheKey,
-    ParagraphMeasurementCacheValue,
-    256>;
+/*
+ * Everything that affects the size of a paragraph: strings and text
+ * attributes of all fragments, sizes of attachments, and paragraph attributes.
+ * Unlike `AttributedString`, it does not refer to shadow views, so the same
+ * text in two different views (or in two revisions of the same view) is
+ * equal. The hash is computed once, on construction.
+ */
+class ParagraphMeasurementContent final {
+ public:
+  using Shared = std::shared_ptr<ParagraphMeasurementContent const>;
+
+  ParagraphMeasurementContent(
+      AttributedString const &attributedString,
+      ParagraphAttributes const &paragraphAttributes);
+
+  size_t getHash() const;
+
+  bool operator==(ParagraphMeasurementContent const &rhs) const;
+  bool operator!=(ParagraphMeasurementContent const &rhs) const;
+
+ private:
+  struct Fragment {
+    std::string string;
+    TextAttributes textAttributes;
+    Size attachmentSize;
+
+    bool operator==(Fragment const &rhs) const;
+  };
+
+  better::small_vector<Fragment, 1> fragments_;
+  ParagraphAttributes paragraphAttributes_;
+  size_t hash_;
+};
+
+struct ParagraphMeasurementCacheKey {
+  ParagraphMeasurementContent::Shared content;
+  LayoutConstraints layoutConstraints;
+
+  bool operator==(ParagraphMeasurementCacheKey const &rhs) const;
+};
+
+} // namespace react
+} // namespace facebook
+
+namespace std {
+template <>
+struct hash<facebook::react::ParagraphMeasurementCacheKey> {
+  size_t operator()(
+      facebook::react::ParagraphMeasurementCacheKey const &key) const {
+    return folly::hash::hash_combine(
+        key.content->getHash(), key.layoutConstraints);
+  }
+};
+} // namespace std
+
+namespace facebook {
+namespace react {
+
+/*
+ * Thread-safe LRU cache of paragraph sizes.
+ * If `widthBucket` is positive, maximum widths are rounded up to a multiple
+ * of it before measuring, so paragraphs with the same content laid out in
+ * slightly different widths share a single measurement. Bucketing is off by
+ * default.
+ * Paragraphs which are about to be measured can be scheduled in advance;
+ * they are measured all at once (with a single `measureBatch` call), which
+ * amortizes the cost of calling into platform text layout.
+ */
+class ParagraphMeasurementCache final {
+ public:
+  using Cache = SimpleThreadSafeCache<ParagraphMeasurementCacheKey, Size, 256>;
+  using MeasureBatchFunction =
+      std::function<std::vector<Size>(TextMeasureRequestList const &requests)>;
+
+  static constexpr int DefaultCapacity = 256;
+  static constexpr Float DefaultWidthBucket = 0;
+
+  ParagraphMeasurementCache(
+      int capacity = DefaultCapacity,
+      Float widthBucket = DefaultWidthBucket,
+      MeasureBatchFunction measureBatch = nullptr);
+
+  /*
+   * Returns the size of the paragraph with given content.
+   * If the size wasn't found in the cache, calls `measure` with adjusted
+   * constraints and stores the result. The returned size is clamped to
+   * given constraints.
+   * Can be called from any thread; other threads are not blocked while
+   * `measure` is running, except those which need the same measurement.
+   */
+  Size get(
+      ParagraphMeasurementContent::Shared const &content,
+      LayoutConstraints const &layoutConstraints,
+      std::function<Size(LayoutConstraints const &layoutConstraints)> const
+          &measure) const;
+
+  /*
+   * Schedules measurement of the paragraph with given content which is
+   * likely to be requested soon. All scheduled paragraphs which are not in
+   * the cache yet are measured at once on the next `get` call.
+   * Does nothing if the cache was created without `measureBatch` function.
+   * Can be called from any thread.
+   */
+  void schedule(
+      ParagraphMeasurementContent::Shared const &content,
+      TextMeasureRequest request) const;
+
+  /*
+   * Returns the constraints which are used for measuring (and as a part of a
+   * cache key) instead of given ones.
+   */
+  LayoutConstraints bucketLayoutConstraints(
+      LayoutConstraints const &layoutConstraints) const;
+
+  /*
+   * Returns the counters of cache hits, misses and evictions.
+   */
+  Cache::Statistics getStatistics() const;
+
+ private:
+  /*
+   * Measures all scheduled paragraphs which are not in the cache yet.
+   */
+  void measureScheduledRequests() const;
+
+  Float widthBucket_;
+  Cache cache_;
+  MeasureBatchFunction measureBatch_;
+
+  mutable std::mutex mutex_;
+  // Protected by `mutex_`.
+  mutable std::unordered_map<ParagraphMeasurementCacheKey, TextMeasureRequest>
+      scheduledRequests_;
+  // Allows `get` to skip locking `mutex_` when nothing is scheduled.
+  mutable std::atomic<bool> hasScheduledRequests_{false};
+};
 
 } // namespace react
 } // namespace facebook
@@ -26,6 +26,16 @@ AttributedString ParagraphShadowNode::getAttributedString() const {
   return cachedAttributedString_.value();
 }
 
+ParagraphMeasurementContent::Shared
+ParagraphShadowNode::getMeasurementContent() const {
+  if (!cachedMeasurementContent_) {
+    cachedMeasurementContent_ = std::make_shared<ParagraphMeasurementContent>(
+        getAttributedString(), getProps()->paragraphAttributes);
+  }
+
+  return cachedMeasurementContent_;
+}
+
 void ParagraphShadowNode::setTextLayoutManager(
     SharedTextLayoutManager textLayoutManager) {
   ensureUnsealed();
@@ -68,11 +78,12 @@ Size ParagraphShadowNode::measure(LayoutConstraints layoutConstraints) const {
       getProps()->paragraphAttributes;
 
   // Cache results of this function so we don't need to call measure()
-  // repeatedly.
+  // repeatedly. Paragraphs with the same content share cached results.
   if (measureCache_) {
     return measureCache_->get(
-        ParagraphMeasurementCacheKey{attributedString, paragraphAttributes, layoutConstraints},
-        [&](const ParagraphMeasurementCacheKey &key) {
+        getMeasurementContent(),
+        layoutConstraints,
+        [&](const LayoutConstraints &layoutConstraints) {
           return textLayoutManager_->measure(
               attributedString, paragraphAttributes, layoutConstraints);
         });
@@ -82,6 +93,27 @@ Size ParagraphShadowNode::measure(LayoutConstraints layoutConstraints) const {
       attributedString, paragraphAttributes, layoutConstraints);
 }
 
+void ParagraphShadowNode::prepareMeasurement(
+    better::optional<LayoutConstraints> const &layoutConstraints) const {
+  // Constraints are predicted only from the paragraph's own previous
+  // measurement; a paragraph which has never been laid out is measured
+  // during the layout pass as usual.
+  if (!measureCache_ || !layoutConstraints.has_value()) {
+    return;
+  }
+
+  auto attributedString = getAttributedString();
+  if (attributedString.isEmpty()) {
+    return;
+  }
+
+  measureCache_->schedule(
+      getMeasurementContent(),
+      {std::move(attributedString),
+       getProps()->paragraphAttributes,
+       layoutConstraints.value()});
+}
+
 void ParagraphShadowNode::layout(LayoutContext layoutContext) {
   updateLocalDataIfNeeded();
   ConcreteViewShadowNode::layout(layoutContext);
@@ -42,6 +42,12 @@ class ParagraphShadowNode : public ConcreteViewShadowNode<
    */
   AttributedString getAttributedString() const;
 
+  /*
+   * Returns layout-relevant content of the node which is used as a key for
+   * cached measurements.
+   */
+  ParagraphMeasurementContent::Shared getMeasurementContent() const;
+
   /*
    * Associates a shared TextLayoutManager with the node.
    * `ParagraphShadowNode` uses the manager to measure text content
@@ -62,6 +68,8 @@ class ParagraphShadowNode : public ConcreteViewShadowNode<
 
   void layout(LayoutContext layoutContext) override;
   Size measure(LayoutConstraints layoutConstraints) const override;
+  void prepareMeasurement(better::optional<LayoutConstraints> const
+                              &layoutConstraints) const override;
 
  private:
   /*
@@ -78,6 +86,11 @@ class ParagraphShadowNode : public ConcreteViewShadowNode<
    * from the node.
    */
   mutable folly::Optional<AttributedString> cachedAttributedString_{};
+
+  /*
+   * Cached layout-relevant content of the node; its hash is computed once.
+   */
+  mutable ParagraphMeasurementContent::Shared cachedMeasurementContent_{};
 };
 
 } // namespace react
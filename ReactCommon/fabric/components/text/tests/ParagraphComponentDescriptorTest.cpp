@@ -0,0 +1,54 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <memory>
+
+#include <gtest/gtest.h>
+#include <react/components/text/ParagraphComponentDescriptor.h>
+#include <react/components/text/RawTextComponentDescriptor.h>
+
+using namespace facebook::react;
+
+TEST(ParagraphComponentDescriptorTest, contextContainerIsOptional) {
+  auto rawTextComponentDescriptor = RawTextComponentDescriptor{nullptr};
+  auto rawText = rawTextComponentDescriptor.createShadowNode(
+      ShadowNodeFragment{
+          /* .tag = */ 2,
+          /* .surfaceId = */ 1,
+          /* .props = */
+          rawTextComponentDescriptor.cloneProps(
+              nullptr, RawProps(folly::dynamic::object("text", "Hello"))),
+          /* .eventEmitter = */
+          rawTextComponentDescriptor.createEventEmitter(nullptr, 2),
+      });
+
+  for (auto const &contextContainer :
+       {ContextContainer::Shared{},
+        std::make_shared<ContextContainer const>()}) {
+    // The measurement cache falls back to its default configuration.
+    auto paragraphComponentDescriptor =
+        ParagraphComponentDescriptor{nullptr, contextContainer};
+    auto paragraph = std::static_pointer_cast<ParagraphShadowNode const>(
+        paragraphComponentDescriptor.createShadowNode(ShadowNodeFragment{
+            /* .tag = */ 1,
+            /* .surfaceId = */ 1,
+            /* .props = */
+            paragraphComponentDescriptor.cloneProps(nullptr, RawProps()),
+            /* .eventEmitter = */
+            paragraphComponentDescriptor.createEventEmitter(nullptr, 1),
+            /* .children = */
+            std::make_shared<SharedShadowNodeList>(
+                SharedShadowNodeList{rawText}),
+        }));
+
+    auto layoutConstraints = LayoutConstraints{};
+    layoutConstraints.maximumSize = Size{200, 200};
+    auto size = paragraph->measure(layoutConstraints);
+    EXPECT_GT(size.width, 0);
+    EXPECT_GT(size.height, 0);
+  }
+}
@@ -0,0 +1,201 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <react/components/text/ParagraphComponentDescriptor.h>
+#include <react/components/text/RawTextComponentDescriptor.h>
+#include <react/components/view/ViewComponentDescriptor.h>
+
+using namespace facebook::react;
+
+namespace {
+
+/*
+ * Builds a container with paragraphs which are measured with a cache whose
+ * batch measurements are recorded.
+ */
+class ParagraphLayoutTest : public ::testing::Test {
+ protected:
+  ParagraphLayoutTest()
+      : textLayoutManager_(std::make_shared<TextLayoutManager>(nullptr)),
+        measureCache_(
+            ParagraphMeasurementCache::DefaultCapacity,
+            ParagraphMeasurementCache::DefaultWidthBucket,
+            [this](TextMeasureRequestList const &requests) {
+              batches_.push_back(requests);
+              auto sizes = std::vector<Size>{};
+              for (auto const &request : requests) {
+                sizes.push_back(
+                    {request.layoutConstraints.maximumSize.width,
+                     kBatchMeasuredHeight});
+              }
+              return sizes;
+            }) {}
+
+  // Does what `ParagraphComponentDescriptor` does, with the recording cache.
+  void adopt(ParagraphShadowNode &paragraph) {
+    paragraph.setTextLayoutManager(textLayoutManager_);
+    paragraph.setMeasureCache(&measureCache_);
+    paragraph.dirtyLayout();
+    paragraph.enableMeasurement();
+  }
+
+  SharedShadowNodeList rawText(Tag tag, std::string const &text) {
+    return {rawTextComponentDescriptor_.createShadowNode(ShadowNodeFragment{
+        /* .tag = */ tag,
+        /* .surfaceId = */ 1,
+        /* .props = */
+        rawTextComponentDescriptor_.cloneProps(
+            nullptr, RawProps(folly::dynamic::object("text", text))),
+        /* .eventEmitter = */
+        rawTextComponentDescriptor_.createEventEmitter(nullptr, tag),
+    })};
+  }
+
+  std::shared_ptr<ParagraphShadowNode> paragraph(
+      Tag tag,
+      folly::dynamic const &style,
+      std::string const &text) {
+    auto paragraph = std::make_shared<ParagraphShadowNode>(
+        ShadowNodeFragment{
+            /* .tag = */ tag,
+            /* .surfaceId = */ 1,
+            /* .props = */
+            paragraphComponentDescriptor_.cloneProps(nullptr, RawProps(style)),
+            /* .eventEmitter = */
+            paragraphComponentDescriptor_.createEventEmitter(nullptr, tag),
+            /* .children = */
+            std::make_shared<SharedShadowNodeList>(rawText(tag + 100, text)),
+        },
+        paragraphComponentDescriptor_);
+    adopt(*paragraph);
+    return paragraph;
+  }
+
+  // Returns a new revision of the paragraph with another text, the way
+  // React updates a paragraph.
+  std::shared_ptr<ParagraphShadowNode> changeText(
+      SharedShadowNode const &shadowNode,
+      std::string const &text) {
+    auto paragraph = std::make_shared<ParagraphShadowNode>(
+        *shadowNode,
+        ShadowNodeFragment{
+            /* .tag = */ ShadowNodeFragment::tagPlaceholder(),
+            /* .surfaceId = */ ShadowNodeFragment::surfaceIdPlaceholder(),
+            /* .props = */ ShadowNodeFragment::propsPlaceholder(),
+            /* .eventEmitter = */
+            ShadowNodeFragment::eventEmitterPlaceholder(),
+            /* .children = */
+            std::make_shared<SharedShadowNodeList>(
+                rawText(shadowNode->getTag() + 100, text)),
+        });
+    adopt(*paragraph);
+    return paragraph;
+  }
+
+  std::shared_ptr<ViewShadowNode> container(SharedShadowNodeList children) {
+    return std::make_shared<ViewShadowNode>(
+        ShadowNodeFragment{
+            /* .tag = */ 1,
+            /* .surfaceId = */ 1,
+            /* .props = */
+            std::make_shared<ViewProps const>(
+                ViewProps(),
+                RawProps(
+                    folly::dynamic::object("width", kContainerWidth)(
+                        "padding", kContainerPadding))),
+            /* .eventEmitter = */ ShadowNodeFragment::eventEmitterPlaceholder(),
+            /* .children = */
+            std::make_shared<SharedShadowNodeList>(std::move(children)),
+        },
+        viewComponentDescriptor_);
+  }
+
+  static constexpr Float kContainerWidth = 300;
+  static constexpr Float kContainerPadding = 10;
+  static constexpr Float kBatchMeasuredHeight = 33;
+
+  RawTextComponentDescriptor rawTextComponentDescriptor_{nullptr};
+  ParagraphComponentDescriptor paragraphComponentDescriptor_{nullptr, nullptr};
+  ViewComponentDescriptor viewComponentDescriptor_{nullptr};
+  SharedTextLayoutManager textLayoutManager_;
+  std::vector<TextMeasureRequestList> batches_;
+  ParagraphMeasurementCache measureCache_;
+};
+
+} // namespace
+
+TEST_F(ParagraphLayoutTest, dirtyParagraphsAreMeasuredInOneBatch) {
+  auto rootShadowNode = container({
+      paragraph(2, folly::dynamic::object("margin", 5)("padding", 4), "A"),
+      paragraph(
+          3, folly::dynamic::object("marginLeft", 20)("borderWidth", 2), "B"),
+      paragraph(4, folly::dynamic::object("width", 50)("height", 20), "C"),
+      paragraph(5, folly::dynamic::object(), "D"),
+  });
+  rootShadowNode->layout(LayoutContext{});
+  rootShadowNode->sealRecursive();
+
+  // Nothing was laid out before, so there was nothing to predict.
+  EXPECT_EQ(batches_.size(), 0);
+
+  auto const &children = rootShadowNode->getChildren();
+  auto newRootShadowNode =
+      std::static_pointer_cast<ViewShadowNode>(rootShadowNode->clone({
+          /* .tag = */ ShadowNodeFragment::tagPlaceholder(),
+          /* .surfaceId = */ ShadowNodeFragment::surfaceIdPlaceholder(),
+          /* .props = */ ShadowNodeFragment::propsPlaceholder(),
+          /* .eventEmitter = */ ShadowNodeFragment::eventEmitterPlaceholder(),
+          /* .children = */
+          std::make_shared<SharedShadowNodeList>(SharedShadowNodeList{
+              changeText(children.at(0), "A, changed"),
+              changeText(children.at(1), "B, changed"),
+              changeText(children.at(2), "C, changed"),
+              children.at(3),
+              paragraph(6, folly::dynamic::object(), "E, new"),
+          }),
+      }));
+  newRootShadowNode->layout(LayoutContext{});
+
+  // The paragraphs with new texts were measured at once with the constraints
+  // of their previous layout: the available width minus margins, borders and
+  // paddings. The one with an exact size isn't measured at all, and the new
+  // one has no constraints of its own to predict from.
+  auto const availableWidth = kContainerWidth - 2 * kContainerPadding;
+  ASSERT_EQ(batches_.size(), 1);
+  ASSERT_EQ(batches_[0].size(), 2);
+
+  auto widthOf = [&](std::string const &string) {
+    for (auto const &request : batches_[0]) {
+      if (request.attributedString.getString() == string) {
+        EXPECT_EQ(
+            request.layoutConstraints.minimumSize.width,
+            request.layoutConstraints.maximumSize.width);
+        return request.layoutConstraints.maximumSize.width;
+      }
+    }
+    ADD_FAILURE() << "No request for " << string;
+    return Float{0};
+  };
+  EXPECT_EQ(widthOf("A, changed"), availableWidth - 2 * 5 - 2 * 4);
+  EXPECT_EQ(widthOf("B, changed"), availableWidth - 20 - 2 * 2);
+
+  // Layout used the results of the batch.
+  auto const &newChildren = newRootShadowNode->getChildren();
+  auto heightOf = [&](int index) {
+    return dynamic_cast<LayoutableShadowNode const &>(*newChildren.at(index))
+        .getLayoutMetrics()
+        .frame.size.height;
+  };
+  EXPECT_EQ(heightOf(0), kBatchMeasuredHeight + 2 * 4);
+  EXPECT_EQ(heightOf(1), kBatchMeasuredHeight + 2 * 2);
+  EXPECT_EQ(heightOf(2), 20);
+}
@@ -0,0 +1,298 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <react/attributedstring/AttributedString.h>
+#include <react/attributedstring/ParagraphAttributes.h>
+#include <react/components/text/ParagraphMeasurementCache.h>
+
+using namespace facebook::react;
+
+namespace {
+
+AttributedString makeAttributedString(std::string string, Tag parentTag) {
+  auto fragment = AttributedString::Fragment{};
+  fragment.string = std::move(string);
+  fragment.textAttributes.fontSize = 14;
+  fragment.parentShadowView.tag = parentTag;
+
+  auto attributedString = AttributedString{};
+  attributedString.appendFragment(fragment);
+  return attributedString;
+}
+
+ParagraphMeasurementContent::Shared makeContent(
+    std::string string,
+    Tag parentTag) {
+  return std::make_shared<ParagraphMeasurementContent>(
+      makeAttributedString(std::move(string), parentTag),
+      ParagraphAttributes{});
+}
+
+LayoutConstraints makeConstraints(Float maximumWidth) {
+  auto layoutConstraints = LayoutConstraints{};
+  layoutConstraints.maximumSize.width = maximumWidth;
+  return layoutConstraints;
+}
+
+} // namespace
+
+TEST(ParagraphMeasurementCacheTest, contentIgnoresShadowViews) {
+  auto content = makeContent("Hello", 1);
+
+  EXPECT_EQ(*content, *makeContent("Hello", 2));
+  EXPECT_EQ(content->getHash(), makeContent("Hello", 2)->getHash());
+  EXPECT_NE(*content, *makeContent("Hello!", 1));
+
+  auto otherParagraphAttributes = ParagraphAttributes{};
+  otherParagraphAttributes.maximumNumberOfLines = 1;
+  EXPECT_NE(
+      *content,
+      ParagraphMeasurementContent(
+          makeAttributedString("Hello", 1), otherParagraphAttributes));
+}
+
+TEST(ParagraphMeasurementCacheTest, sameTextInDifferentViewsIsMeasuredOnce) {
+  ParagraphMeasurementCache cache;
+  auto measureCount = 0;
+  auto measure = [&](LayoutConstraints const &layoutConstraints) {
+    measureCount++;
+    return Size{layoutConstraints.maximumSize.width, 20};
+  };
+
+  // Rows of a list, each with its own views.
+  for (Tag tag = 1; tag <= 10; tag++) {
+    auto size =
+        cache.get(makeContent("Row", tag), makeConstraints(375), measure);
+    EXPECT_EQ(size, (Size{375, 20}));
+  }
+  EXPECT_EQ(measureCount, 1);
+
+  cache.get(makeContent("Row", 1), makeConstraints(320), measure);
+  cache.get(makeContent("Another row", 1), makeConstraints(375), measure);
+  EXPECT_EQ(measureCount, 3);
+}
+
+TEST(ParagraphMeasurementCacheTest, widthsAreBucketed) {
+  ParagraphMeasurementCache cache{
+      ParagraphMeasurementCache::DefaultCapacity, /* widthBucket */ 2};
+  auto measuredConstraints = std::vector<LayoutConstraints>{};
+  auto measure = [&](LayoutConstraints const &layoutConstraints) {
+    measuredConstraints.push_back(layoutConstraints);
+    return Size{layoutConstraints.maximumSize.width, 20};
+  };
+  auto content = makeContent("Row", 1);
+
+  EXPECT_EQ(cache.get(content, makeConstraints(375), measure), (Size{375, 20}));
+  cache.get(content, makeConstraints(375.00003), measure);
+  cache.get(content, makeConstraints(376), measure);
+  cache.get(content, makeConstraints(374), measure);
+
+  // The text is measured in widths which are never smaller than requested,
+  // and the results never exceed the requested widths.
+  ASSERT_EQ(measuredConstraints.size(), 2);
+  EXPECT_EQ(measuredConstraints[0].maximumSize.width, 376);
+  EXPECT_EQ(measuredConstraints[1].maximumSize.width, 374);
+  EXPECT_EQ(cache.get(content, makeConstraints(375), measure), (Size{375, 20}));
+
+  // Unconstrained widths are kept as they are.
+  auto unconstrained = LayoutConstraints{};
+  EXPECT_EQ(cache.bucketLayoutConstraints(unconstrained), unconstrained);
+}
+
+TEST(ParagraphMeasurementCacheTest, capacityIsConfigurable) {
+  ParagraphMeasurementCache cache{2};
+  auto measureCount = 0;
+  auto measure = [&](LayoutConstraints const &) {
+    measureCount++;
+    return Size{};
+  };
+
+  cache.get(makeContent("A", 1), makeConstraints(100), measure);
+  cache.get(makeContent("B", 1), makeConstraints(100), measure);
+  cache.get(makeContent("C", 1), makeConstraints(100), measure);
+  EXPECT_EQ(measureCount, 3);
+
+  // "A" was evicted to make room for "C".
+  cache.get(makeContent("C", 1), makeConstraints(100), measure);
+  cache.get(makeContent("A", 1), makeConstraints(100), measure);
+  EXPECT_EQ(measureCount, 4);
+
+  auto statistics = cache.getStatistics();
+  EXPECT_EQ(statistics.hits, 1);
+  EXPECT_EQ(statistics.misses, 4);
+  EXPECT_EQ(statistics.evictions, 2);
+}
+
+TEST(ParagraphMeasurementCacheTest, concurrentMissesMeasureOnce) {
+  ParagraphMeasurementCache cache;
+  std::atomic<int> measureCount{0};
+  auto measure = [&](LayoutConstraints const &) {
+    measureCount++;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    return Size{100, 20};
+  };
+
+  auto const threadCount = 4;
+  auto threads = std::vector<std::thread>{};
+  for (int index = 0; index < threadCount; index++) {
+    threads.emplace_back([&, index]() {
+      auto size =
+          cache.get(makeContent("Row", index), makeConstraints(375), measure);
+      EXPECT_EQ(size, (Size{100, 20}));
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(measureCount, 1);
+  auto statistics = cache.getStatistics();
+  EXPECT_EQ(statistics.hits, threadCount - 1);
+  EXPECT_EQ(statistics.misses, 1);
+}
+
+TEST(ParagraphMeasurementCacheTest, differentContentIsMeasuredConcurrently) {
+  ParagraphMeasurementCache cache;
+  std::atomic<int> activeMeasureCount{0};
+  std::atomic<int> maximumActiveMeasureCount{0};
+  auto measure = [&](LayoutConstraints const &) {
+    auto activeCount = ++activeMeasureCount;
+    auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    // Waits for the other measurement to start; this would time out if the
+    // cache were locked while measuring.
+    while (activeMeasureCount < 2 &&
+           std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    activeCount = std::max(activeCount, activeMeasureCount.load());
+    auto maximum = maximumActiveMeasureCount.load();
+    while (maximum < activeCount &&
+           !maximumActiveMeasureCount.compare_exchange_weak(
+               maximum, activeCount)) {
+    }
+    return Size{};
+  };
+
+  auto first = std::thread([&]() {
+    cache.get(makeContent("First", 1), makeConstraints(375), measure);
+  });
+  auto second = std::thread([&]() {
+    cache.get(makeContent("Second", 1), makeConstraints(375), measure);
+  });
+  first.join();
+  second.join();
+
+  EXPECT_EQ(maximumActiveMeasureCount, 2);
+}
+
+TEST(ParagraphMeasurementCacheTest, scheduledRequestsAreMeasuredInOneBatch) {
+  auto batches = std::vector<TextMeasureRequestList>{};
+  ParagraphMeasurementCache cache{
+      ParagraphMeasurementCache::DefaultCapacity,
+      ParagraphMeasurementCache::DefaultWidthBucket,
+      [&](TextMeasureRequestList const &requests) {
+        batches.push_back(requests);
+        auto sizes = std::vector<Size>{};
+        for (auto const &request : requests) {
+          sizes.push_back({request.layoutConstraints.maximumSize.width, 20});
+        }
+        return sizes;
+      }};
+  auto measureCount = 0;
+  auto measure = [&](LayoutConstraints const &) {
+    measureCount++;
+    return Size{};
+  };
+  auto schedule = [&](std::string string, Float maximumWidth) {
+    cache.schedule(
+        makeContent(string, 1),
+        {makeAttributedString(string, 1), {}, makeConstraints(maximumWidth)});
+  };
+
+  schedule("A", 100);
+  schedule("B", 100);
+  // The same request is measured once.
+  schedule("B", 100);
+  schedule("C", 100.5);
+
+  EXPECT_EQ(
+      cache.get(makeContent("A", 2), makeConstraints(100), measure),
+      (Size{100, 20}));
+  EXPECT_EQ(
+      cache.get(makeContent("B", 2), makeConstraints(100), measure),
+      (Size{100, 20}));
+  EXPECT_EQ(
+      cache.get(makeContent("C", 2), makeConstraints(100.5), measure),
+      (Size{100.5, 20}));
+  EXPECT_EQ(measureCount, 0);
+  ASSERT_EQ(batches.size(), 1);
+  EXPECT_EQ(batches[0].size(), 3);
+
+  // Mispredicted constraints are measured separately.
+  EXPECT_EQ(
+      cache.get(makeContent("A", 2), makeConstraints(50), measure), Size{});
+  EXPECT_EQ(measureCount, 1);
+
+  // Paragraphs which are already in the cache are not measured again.
+  schedule("A", 100);
+  schedule("D", 100);
+  cache.get(makeContent("D", 1), makeConstraints(100), measure);
+  ASSERT_EQ(batches.size(), 2);
+  ASSERT_EQ(batches[1].size(), 1);
+  EXPECT_EQ(batches[1][0].attributedString, makeAttributedString("D", 1));
+  EXPECT_EQ(measureCount, 1);
+}
+
+TEST(ParagraphMeasurementCacheTest, failedBatchLeavesRequestsUnmeasured) {
+  // A broken batch measurement which returns no sizes at all.
+  ParagraphMeasurementCache cache{
+      ParagraphMeasurementCache::DefaultCapacity,
+      ParagraphMeasurementCache::DefaultWidthBucket,
+      [](TextMeasureRequestList const &) { return std::vector<Size>{}; }};
+  auto measureCount = 0;
+  auto measure = [&](LayoutConstraints const &) {
+    measureCount++;
+    return Size{10, 20};
+  };
+
+  cache.schedule(
+      makeContent("A", 1),
+      {makeAttributedString("A", 1), {}, makeConstraints(100)});
+  EXPECT_THROW(
+      cache.get(makeContent("A", 1), makeConstraints(100), measure),
+      std::length_error);
+
+  // Nothing was stored and nothing is left waiting for the batch.
+  EXPECT_EQ(
+      cache.get(makeContent("A", 1), makeConstraints(100), measure),
+      (Size{10, 20}));
+  EXPECT_EQ(measureCount, 1);
+}
+
+TEST(ParagraphMeasurementCacheTest, schedulingRequiresBatchMeasurement) {
+  ParagraphMeasurementCache cache;
+  auto measureCount = 0;
+  auto measure = [&](LayoutConstraints const &) {
+    measureCount++;
+    return Size{};
+  };
+
+  cache.schedule(
+      makeContent("A", 1),
+      {makeAttributedString("A", 1), {}, makeConstraints(100)});
+  cache.get(makeContent("A", 1), makeConstraints(100), measure);
+  EXPECT_EQ(measureCount, 1);
+}
@@ -68,7 +68,14 @@ void TouchEventEmitter::onTouchStart(const TouchEvent &event) const {
 }
 
 void TouchEventEmitter::onTouchMove(const TouchEvent &event) const {
-  dispatchTouchEvent("touchMove", event, EventPriority::SynchronousBatched);
+  // Every move event carries the current position of all touches, so only the
+  // latest one matters.
+  dispatchContinuousEvent(
+      "touchMove",
+      [event](jsi::Runtime &runtime) {
+        return touchEventPayload(runtime, event);
+      },
+      EventPriority::SynchronousBatched);
 }
 
 void TouchEventEmitter::onTouchEnd(const TouchEvent &event) const {
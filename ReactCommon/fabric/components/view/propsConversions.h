@@ -15,8 +15,8 @@ namespace react {
 
 static inline YGStyle::Dimensions convertRawProp(
     const RawProps &rawProps,
-    const std::string &widthName,
-    const std::string &heightName,
+    char const *widthName,
+    char const *heightName,
     const YGStyle::Dimensions &sourceValue,
     const YGStyle::Dimensions &defaultValue) {
   auto dimensions = defaultValue;
@@ -35,56 +35,74 @@ static inline YGStyle::Dimensions convertRawProp(
 
 static inline YGStyle::Edges convertRawProp(
     const RawProps &rawProps,
-    const std::string &prefix,
-    const std::string &suffix,
+    char const *prefix,
+    char const *suffix,
     const YGStyle::Edges &sourceValue,
     const YGStyle::Edges &defaultValue) {
   auto result = defaultValue;
   result[YGEdgeLeft] = convertRawProp(
       rawProps,
-      prefix + "Left" + suffix,
+      "Left",
       sourceValue[YGEdgeLeft],
-      defaultValue[YGEdgeLeft]);
+      defaultValue[YGEdgeLeft],
+      prefix,
+      suffix);
   result[YGEdgeTop] = convertRawProp(
       rawProps,
-      prefix + "Top" + suffix,
+      "Top",
       sourceValue[YGEdgeTop],
-      defaultValue[YGEdgeTop]);
+      defaultValue[YGEdgeTop],
+      prefix,
+      suffix);
   result[YGEdgeRight] = convertRawProp(
       rawProps,
-      prefix + "Right" + suffix,
+      "Right",
       sourceValue[YGEdgeRight],
-      defaultValue[YGEdgeRight]);
+      defaultValue[YGEdgeRight],
+      prefix,
+      suffix);
   result[YGEdgeBottom] = convertRawProp(
       rawProps,
-      prefix + "Bottom" + suffix,
+      "Bottom",
       sourceValue[YGEdgeBottom],
-      defaultValue[YGEdgeBottom]);
+      defaultValue[YGEdgeBottom],
+      prefix,
+      suffix);
   result[YGEdgeStart] = convertRawProp(
       rawProps,
-      prefix + "Start" + suffix,
+      "Start",
       sourceValue[YGEdgeStart],
-      defaultValue[YGEdgeStart]);
+      defaultValue[YGEdgeStart],
+      prefix,
+      suffix);
   result[YGEdgeEnd] = convertRawProp(
       rawProps,
-      prefix + "End" + suffix,
+      "End",
       sourceValue[YGEdgeEnd],
-      defaultValue[YGEdgeEnd]);
+      defaultValue[YGEdgeEnd],
+      prefix,
+      suffix);
   result[YGEdgeHorizontal] = convertRawProp(
       rawProps,
-      prefix + "Horizontal" + suffix,
+      "Horizontal",
       sourceValue[YGEdgeHorizontal],
-      defaultValue[YGEdgeHorizontal]);
+      defaultValue[YGEdgeHorizontal],
+      prefix,
+      suffix);
   result[YGEdgeVertical] = convertRawProp(
       rawProps,
-      prefix + "Vertical" + suffix,
+      "Vertical",
       sourceValue[YGEdgeVertical],
-      defaultValue[YGEdgeVertical]);
+      defaultValue[YGEdgeVertical],
+      prefix,
+      suffix);
   result[YGEdgeAll] = convertRawProp(
       rawProps,
-      prefix + suffix,
+      "",
       sourceValue[YGEdgeAll],
-      defaultValue[YGEdgeAll]);
+      defaultValue[YGEdgeAll],
+      prefix,
+      suffix);
   return result;
 }
 
@@ -192,30 +210,31 @@ static inline YGStyle convertRawProp(
 template <typename T>
 static inline CascadedRectangleCorners<T> convertRawProp(
     const RawProps &rawProps,
-    const std::string &prefix,
-    const std::string &suffix,
+    char const *prefix,
+    char const *suffix,
     const CascadedRectangleCorners<T> &sourceValue) {
   CascadedRectangleCorners<T> result;
 
   result.topLeft = convertRawProp(
-      rawProps, prefix + "TopLeft" + suffix, sourceValue.topLeft);
+      rawProps, "TopLeft", sourceValue.topLeft, {}, prefix, suffix);
   result.topRight = convertRawProp(
-      rawProps, prefix + "TopRight" + suffix, sourceValue.topRight);
+      rawProps, "TopRight", sourceValue.topRight, {}, prefix, suffix);
   result.bottomLeft = convertRawProp(
-      rawProps, prefix + "BottomLeft" + suffix, sourceValue.bottomLeft);
+      rawProps, "BottomLeft", sourceValue.bottomLeft, {}, prefix, suffix);
   result.bottomRight = convertRawProp(
-      rawProps, prefix + "BottomRight" + suffix, sourceValue.bottomRight);
+      rawProps, "BottomRight", sourceValue.bottomRight, {}, prefix, suffix);
 
   result.topStart = convertRawProp(
-      rawProps, prefix + "TopStart" + suffix, sourceValue.topStart);
-  result.topEnd =
-      convertRawProp(rawProps, prefix + "TopEnd" + suffix, sourceValue.topEnd);
+      rawProps, "TopStart", sourceValue.topStart, {}, prefix, suffix);
+  result.topEnd = convertRawProp(
+      rawProps, "TopEnd", sourceValue.topEnd, {}, prefix, suffix);
   result.bottomStart = convertRawProp(
-      rawProps, prefix + "BottomStart" + suffix, sourceValue.bottomStart);
+      rawProps, "BottomStart", sourceValue.bottomStart, {}, prefix, suffix);
   result.bottomEnd = convertRawProp(
-      rawProps, prefix + "BottomEnd" + suffix, sourceValue.bottomEnd);
+      rawProps, "BottomEnd", sourceValue.bottomEnd, {}, prefix, suffix);
 
-  result.all = convertRawProp(rawProps, prefix + suffix, sourceValue.all);
+  result.all =
+      convertRawProp(rawProps, "", sourceValue.all, {}, prefix, suffix);
 
   return result;
 }
@@ -223,30 +242,31 @@ static inline CascadedRectangleCorners<T> convertRawProp(
 template <typename T>
 static inline CascadedRectangleEdges<T> convertRawProp(
     const RawProps &rawProps,
-    const std::string &prefix,
-    const std::string &suffix,
+    char const *prefix,
+    char const *suffix,
     const CascadedRectangleEdges<T> &sourceValue) {
   CascadedRectangleEdges<T> result;
 
-  result.left =
-      convertRawProp(rawProps, prefix + "Left" + suffix, sourceValue.left);
-  result.right =
-      convertRawProp(rawProps, prefix + "Right" + suffix, sourceValue.right);
-  result.top =
-      convertRawProp(rawProps, prefix + "Top" + suffix, sourceValue.top);
-  result.bottom =
-      convertRawProp(rawProps, prefix + "Bottom" + suffix, sourceValue.bottom);
-
-  result.start =
-      convertRawProp(rawProps, prefix + "Start" + suffix, sourceValue.start);
-  result.end =
-      convertRawProp(rawProps, prefix + "End" + suffix, sourceValue.end);
+  result.left = convertRawProp(
+      rawProps, "Left", sourceValue.left, {}, prefix, suffix);
+  result.right = convertRawProp(
+      rawProps, "Right", sourceValue.right, {}, prefix, suffix);
+  result.top = convertRawProp(
+      rawProps, "Top", sourceValue.top, {}, prefix, suffix);
+  result.bottom = convertRawProp(
+      rawProps, "Bottom", sourceValue.bottom, {}, prefix, suffix);
+
+  result.start = convertRawProp(
+      rawProps, "Start", sourceValue.start, {}, prefix, suffix);
+  result.end = convertRawProp(
+      rawProps, "End", sourceValue.end, {}, prefix, suffix);
   result.horizontal = convertRawProp(
-      rawProps, prefix + "Horizontal" + suffix, sourceValue.horizontal);
+      rawProps, "Horizontal", sourceValue.horizontal, {}, prefix, suffix);
   result.vertical = convertRawProp(
-      rawProps, prefix + "Vertical" + suffix, sourceValue.vertical);
+      rawProps, "Vertical", sourceValue.vertical, {}, prefix, suffix);
 
-  result.all = convertRawProp(rawProps, prefix + suffix, sourceValue.all);
+  result.all =
+      convertRawProp(rawProps, "", sourceValue.all, {}, prefix, suffix);
 
   return result;
 }
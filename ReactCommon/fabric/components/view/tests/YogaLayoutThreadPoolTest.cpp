@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <react/components/view/YogaLayoutThreadPool.h>
+
+using namespace facebook::react;
+
+namespace {
+
+struct Counters {
+  YogaLayoutThreadPool &pool;
+  std::vector<std::atomic<int>> calls;
+  std::atomic<int> running{0};
+  size_t throwingTaskIndex{static_cast<size_t>(-1)};
+  size_t nestedTaskCount{0};
+
+  Counters(YogaLayoutThreadPool &pool, size_t taskCount)
+      : pool(pool), calls(taskCount) {}
+};
+
+void countingTask(size_t taskIndex, void *taskContext) {
+  auto &counters = *static_cast<Counters *>(taskContext);
+  counters.running++;
+  counters.calls[taskIndex]++;
+  std::this_thread::sleep_for(std::chrono::microseconds(100));
+  counters.running--;
+
+  if (taskIndex == counters.throwingTaskIndex) {
+    throw std::runtime_error("Task failed.");
+  }
+}
+
+void nestingTask(size_t taskIndex, void *taskContext) {
+  auto &counters = *static_cast<Counters *>(taskContext);
+  counters.calls[taskIndex]++;
+
+  Counters nestedCounters{counters.pool, counters.nestedTaskCount};
+  nestedCounters.throwingTaskIndex = counters.throwingTaskIndex;
+  counters.pool.run(counters.nestedTaskCount, countingTask, &nestedCounters);
+
+  for (auto const &calls : nestedCounters.calls) {
+    EXPECT_EQ(calls.load(), 1);
+  }
+}
+
+} // namespace
+
+TEST(YogaLayoutThreadPoolTest, runsEveryTaskOnce) {
+  YogaLayoutThreadPool pool{3};
+
+  for (auto taskCount : {0, 1, 2, 100}) {
+    Counters counters{pool, static_cast<size_t>(taskCount)};
+    pool.run(taskCount, countingTask, &counters);
+    for (auto const &calls : counters.calls) {
+      EXPECT_EQ(calls.load(), 1);
+    }
+  }
+}
+
+TEST(YogaLayoutThreadPoolTest, runsWorkersThroughTheRunner) {
+  std::atomic<int> startedWorkerCount{0};
+  std::atomic<int> finishedWorkerCount{0};
+  {
+    YogaLayoutThreadPool pool{
+        3, [&](std::function<void()> &&workerLoop) {
+          startedWorkerCount++;
+          workerLoop();
+          finishedWorkerCount++;
+        }};
+
+    Counters counters{pool, 100};
+    pool.run(100, countingTask, &counters);
+    for (auto const &calls : counters.calls) {
+      EXPECT_EQ(calls.load(), 1);
+    }
+  }
+
+  // Every worker ran its loop through the runner, and the loops returned
+  // when the pool was destroyed.
+  EXPECT_EQ(startedWorkerCount.load(), 3);
+  EXPECT_EQ(finishedWorkerCount.load(), 3);
+}
+
+TEST(YogaLayoutThreadPoolTest, runsNestedBatches) {
+  // More nested batches than threads, so threads which wait for their own
+  // batches have to run tasks of others.
+  YogaLayoutThreadPool pool{2};
+  Counters counters{pool, 16};
+  counters.nestedTaskCount = 16;
+
+  pool.run(16, nestingTask, &counters);
+
+  for (auto const &calls : counters.calls) {
+    EXPECT_EQ(calls.load(), 1);
+  }
+}
+
+TEST(YogaLayoutThreadPoolTest, rethrowsExceptionsFromTasks) {
+  YogaLayoutThreadPool pool{3};
+
+  Counters counters{pool, 100};
+  counters.throwingTaskIndex = 10;
+  EXPECT_THROW(pool.run(100, countingTask, &counters), std::runtime_error);
+
+  // No task is running anymore, none ran twice, and the throwing one ran.
+  EXPECT_EQ(counters.running.load(), 0);
+  for (auto const &calls : counters.calls) {
+    EXPECT_LE(calls.load(), 1);
+  }
+  EXPECT_EQ(counters.calls[10].load(), 1);
+
+  // The pool keeps working.
+  Counters otherCounters{pool, 100};
+  pool.run(100, countingTask, &otherCounters);
+  for (auto const &calls : otherCounters.calls) {
+    EXPECT_EQ(calls.load(), 1);
+  }
+}
+
+TEST(YogaLayoutThreadPoolTest, rethrowsExceptionsFromNestedBatches) {
+  YogaLayoutThreadPool pool{2};
+  Counters counters{pool, 8};
+  counters.nestedTaskCount = 8;
+  counters.throwingTaskIndex = 3;
+
+  EXPECT_THROW(pool.run(8, nestingTask, &counters), std::runtime_error);
+
+  Counters otherCounters{pool, 8};
+  otherCounters.nestedTaskCount = 8;
+  pool.run(8, nestingTask, &otherCounters);
+  for (auto const &calls : otherCounters.calls) {
+    EXPECT_EQ(calls.load(), 1);
+  }
+}
@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+
+namespace {
+
+// Takes all of the available width, so a measurement for one width can't be
+// reused for another one.
+YGSize measureFillingLeaf(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode,
+    float,
+    YGMeasureMode) {
+  (*static_cast<int *>(node->getContext()))++;
+  return {width, 10};
+}
+
+/*
+ * A column with a measured leaf, laid out with different widths the way
+ * a text is laid out when its container resizes.
+ */
+class YogaMeasurementCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    config_ = YGConfigNew();
+    root_ = YGNodeNewWithConfig(config_);
+    YGNodeStyleSetAlignItems(root_, YGAlignFlexStart);
+
+    leaf_ = YGNodeNewWithConfig(config_);
+    leaf_->setContext(&measureCount_);
+    leaf_->setMeasureFunc(measureFillingLeaf);
+    YGNodeInsertChild(root_, leaf_, 0);
+  }
+
+  void TearDown() override {
+    YGNodeFreeRecursive(root_);
+    YGConfigFree(config_);
+  }
+
+  // Lays out the tree with every width and returns the number of leaf
+  // measurements it took.
+  int layOut(std::vector<float> const &widths) {
+    auto measureCount = measureCount_;
+    for (auto width : widths) {
+      YGNodeCalculateLayout(root_, width, YGUndefined, YGDirectionLTR);
+      EXPECT_EQ(YGNodeLayoutGetWidth(leaf_), width);
+    }
+    return measureCount_ - measureCount;
+  }
+
+  static std::vector<float> widths(int from, int to) {
+    auto widths = std::vector<float>{};
+    for (auto width = from; width < to; width++) {
+      widths.push_back(100 + width);
+    }
+    return widths;
+  }
+
+  YGConfigRef config_;
+  YGNodeRef root_;
+  YGNodeRef leaf_;
+  int measureCount_{0};
+};
+
+} // namespace
+
+TEST_F(YogaMeasurementCacheTest, everyConstraintIsMeasuredOnce) {
+  EXPECT_EQ(layOut(widths(0, 8)), 8);
+  EXPECT_EQ(layOut(widths(0, 8)), 0);
+}
+
+TEST_F(YogaMeasurementCacheTest, fullCacheReplacesOnlyTheOldestEntry) {
+  // Fills all of the (by default 8) entries, and one more.
+  EXPECT_EQ(layOut(widths(0, 9)), 9);
+
+  // Only the measurement of the first width was replaced.
+  EXPECT_EQ(layOut(widths(1, 9)), 0);
+  EXPECT_EQ(layOut(widths(0, 1)), 1);
+}
+
+TEST_F(YogaMeasurementCacheTest, maxCachedMeasurementsLimitsEntries) {
+  YGConfigSetMaxCachedMeasurements(config_, 2);
+
+  EXPECT_EQ(layOut(widths(0, 3)), 3);
+  EXPECT_EQ(layOut(widths(1, 3)), 0);
+  EXPECT_EQ(layOut(widths(0, 1)), 1);
+}
+
+TEST_F(YogaMeasurementCacheTest, maxCachedMeasurementsExtendsEntries) {
+  // More constraints than the default number of entries.
+  auto const manyWidths = widths(0, 12);
+
+  EXPECT_EQ(layOut(manyWidths), 12);
+  // Cycling through them evicts every entry before it's used again.
+  EXPECT_EQ(layOut(manyWidths), 12);
+
+  // The last 8 measurements stay, the others get the new entries.
+  YGConfigSetMaxCachedMeasurements(config_, 12);
+  EXPECT_EQ(layOut(manyWidths), 4);
+  EXPECT_EQ(layOut(manyWidths), 0);
+  EXPECT_EQ(layOut(manyWidths), 0);
+}
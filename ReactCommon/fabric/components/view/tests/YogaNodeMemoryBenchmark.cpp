@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <unordered_set>
+
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+
+#include "YogaTrees.h"
+
+using namespace facebook::react;
+
+namespace {
+
+struct MemoryUsage {
+  size_t nodeCount{0};
+  size_t bytes{0};
+};
+
+// Counts the node itself and the out-of-line blocks it references. Blocks
+// shared by several nodes are only counted once.
+void collectMemoryUsage(
+    YGNodeConstRef node,
+    MemoryUsage &usage,
+    std::unordered_set<const void *> &visited) {
+  if (!visited.insert(node).second) {
+    return;
+  }
+  usage.nodeCount++;
+  usage.bytes += sizeof(YGNode) +
+      node->getChildren().capacity() * sizeof(YGNodeRef);
+
+  if (visited.insert(&node->getStyle()).second) {
+    usage.bytes += sizeof(YGStyle);
+  }
+
+  auto const &cachedMeasurements = node->getLayout().cachedMeasurements;
+  if (cachedMeasurements.size() > 0 &&
+      visited.insert(&cachedMeasurements[0]).second) {
+    usage.bytes +=
+        cachedMeasurements.capacity() * sizeof(YGCachedMeasurement);
+  }
+
+  for (auto child : node->getChildren()) {
+    collectMemoryUsage(child, usage, visited);
+  }
+}
+
+} // namespace
+
+/*
+ * Reports the memory footprint of Yoga nodes in a 10k-node tree and a clone
+ * of it, and the time it takes to create, clone and lay them out.
+ * Kept apart from YogaNodeMemoryTest, which checks the sharing itself; run
+ * with `--gtest_filter=YogaNodeMemoryBenchmark.*` to see the numbers.
+ */
+TEST(YogaNodeMemoryBenchmark, tenThousandNodes) {
+  auto const nodeCount = 10000;
+  auto config = YGConfigNew();
+
+  auto start = std::chrono::steady_clock::now();
+  auto elapsed = [&]() {
+    auto now = std::chrono::steady_clock::now();
+    auto result =
+        std::chrono::duration_cast<std::chrono::microseconds>(now - start);
+    start = now;
+    return result.count();
+  };
+
+  auto root = buildYogaTree(config, nodeCount, 10);
+  auto const createMicroseconds = elapsed();
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  auto const layoutMicroseconds = elapsed();
+
+  // Relayout of a clone with a new width, the way a new revision of a tree
+  // is laid out. Children are cloned as Yoga visits them.
+  auto clonedRoot = YGNodeClone(root);
+  YGNodeStyleSetWidth(clonedRoot, 500);
+  YGNodeCalculateLayout(clonedRoot, YGUndefined, YGUndefined, YGDirectionLTR);
+  auto const cloneMicroseconds = elapsed();
+
+  auto visited = std::unordered_set<const void *>{};
+  auto original = MemoryUsage{};
+  collectMemoryUsage(root, original, visited);
+  auto clone = MemoryUsage{};
+  collectMemoryUsage(clonedRoot, clone, visited);
+
+  EXPECT_EQ(original.nodeCount, nodeCount);
+  EXPECT_GT(clone.nodeCount, 0);
+  EXPECT_EQ(YGNodeLayoutGetWidth(clonedRoot), 500);
+
+  auto const originalBytesPerNode = original.bytes / original.nodeCount;
+  auto const cloneBytesPerNode = clone.bytes / clone.nodeCount;
+
+  std::cout << "sizeof(YGNode): " << sizeof(YGNode) << " bytes" << std::endl;
+  std::cout << "Original tree: " << originalBytesPerNode << " bytes per node, "
+            << createMicroseconds << " us to create, " << layoutMicroseconds
+            << " us to lay out" << std::endl;
+  std::cout << "Cloned tree: " << clone.nodeCount << " new nodes, "
+            << cloneBytesPerNode << " bytes per node, " << cloneMicroseconds
+            << " us to clone and lay out" << std::endl;
+  RecordProperty("NodeSize", std::to_string(sizeof(YGNode)));
+  RecordProperty("BytesPerNode", std::to_string(originalBytesPerNode));
+  RecordProperty("BytesPerClonedNode", std::to_string(cloneBytesPerNode));
+
+  // Frees the clones first; nodes shared with the original tree are skipped.
+  YGNodeFreeRecursive(clonedRoot);
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
@@ -0,0 +1,124 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <unordered_set>
+
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+
+#include "YogaTrees.h"
+
+using namespace facebook::react;
+
+namespace {
+
+// Collects the nodes of the tree and the style blocks they reference.
+void collectStyles(
+    YGNodeConstRef node,
+    std::unordered_set<YGNodeConstRef> &nodes,
+    std::unordered_set<const YGStyle *> &styles) {
+  if (!nodes.insert(node).second) {
+    return;
+  }
+  styles.insert(&node->getStyle());
+  for (auto child : node->getChildren()) {
+    collectStyles(child, nodes, styles);
+  }
+}
+
+} // namespace
+
+TEST(YogaNodeMemoryTest, nodeKeepsStyleAndCachedMeasurementsOutOfLine) {
+  EXPECT_LT(
+      sizeof(YGNode),
+      sizeof(YGStyle) +
+          YG_MAX_CACHED_RESULT_COUNT * sizeof(YGCachedMeasurement));
+}
+
+TEST(YogaNodeMemoryTest, newNodesShareTheDefaultStyle) {
+  auto first = YGNodeNew();
+  auto second = YGNodeNew();
+
+  EXPECT_EQ(&first->getStyle(), &second->getStyle());
+
+  // Setting a value the style already has doesn't copy it.
+  YGNodeStyleSetFlexDirection(first, YGFlexDirectionColumn);
+  EXPECT_EQ(&first->getStyle(), &second->getStyle());
+
+  YGNodeFree(first);
+  YGNodeFree(second);
+}
+
+TEST(YogaNodeMemoryTest, clonesShareStyleUntilItChanges) {
+  auto node = YGNodeNew();
+  YGNodeStyleSetWidth(node, 100);
+  YGNodeStyleSetMargin(node, YGEdgeLeft, 10);
+
+  auto clone = YGNodeClone(node);
+  EXPECT_EQ(&clone->getStyle(), &node->getStyle());
+
+  YGNodeStyleSetWidth(clone, 100);
+  EXPECT_EQ(&clone->getStyle(), &node->getStyle());
+
+  YGNodeStyleSetWidth(clone, 200);
+  EXPECT_NE(&clone->getStyle(), &node->getStyle());
+  EXPECT_EQ(YGNodeStyleGetWidth(node).value, 100);
+  EXPECT_EQ(YGNodeStyleGetWidth(clone).value, 200);
+  EXPECT_EQ(YGNodeStyleGetMargin(clone, YGEdgeLeft).value, 10);
+
+  YGNodeFree(clone);
+  YGNodeFree(node);
+}
+
+TEST(YogaNodeMemoryTest, clonesShareCachedMeasurements) {
+  auto root = YGNodeNew();
+  YGNodeStyleSetAlignItems(root, YGAlignFlexStart);
+  auto node = YGNodeNew();
+  node->setMeasureFunc(measureYogaLeaf);
+  YGNodeInsertChild(root, node, 0);
+  YGNodeCalculateLayout(root, 100, YGUndefined, YGDirectionLTR);
+
+  auto clone = YGNodeClone(node);
+  auto const &measurements = node->getLayout().cachedMeasurements;
+  auto const &clonedMeasurements = clone->getLayout().cachedMeasurements;
+  ASSERT_GT(measurements.size(), 0);
+  EXPECT_EQ(&clonedMeasurements[0], &measurements[0]);
+
+  YGNodeFree(clone);
+  YGNodeFreeRecursive(root);
+}
+
+TEST(YogaNodeMemoryTest, relayoutOfClonedTreeCopiesNoStyles) {
+  auto const nodeCount = 10000;
+  auto config = YGConfigNew();
+  auto root = buildYogaTree(config, nodeCount, 10);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  // Relayout of a clone with a new width, the way a new revision of a tree
+  // is laid out. Children are cloned as Yoga visits them.
+  auto clonedRoot = YGNodeClone(root);
+  YGNodeStyleSetWidth(clonedRoot, 500);
+  YGNodeCalculateLayout(clonedRoot, YGUndefined, YGUndefined, YGDirectionLTR);
+  EXPECT_EQ(YGNodeLayoutGetWidth(clonedRoot), 500);
+
+  auto nodes = std::unordered_set<YGNodeConstRef>{};
+  auto styles = std::unordered_set<const YGStyle *>{};
+  collectStyles(root, nodes, styles);
+  EXPECT_EQ(nodes.size(), nodeCount);
+  auto const originalStyleCount = styles.size();
+
+  collectStyles(clonedRoot, nodes, styles);
+  EXPECT_GT(nodes.size(), nodeCount + 1);
+  // Only the root got a style of its own.
+  EXPECT_EQ(styles.size(), originalStyleCount + 1);
+
+  // Frees the clones first; nodes shared with the original tree are skipped.
+  YGNodeFreeRecursive(clonedRoot);
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
@@ -0,0 +1,65 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+
+namespace facebook {
+namespace react {
+
+inline YGSize measureYogaLeaf(
+    YGNodeRef,
+    float width,
+    YGMeasureMode widthMode,
+    float,
+    YGMeasureMode) {
+  return {widthMode == YGMeasureModeUndefined ? 40 : std::min(width, 40.f),
+          20};
+}
+
+/*
+ * Builds a tree of `nodeCount` nodes in which every node has `fanout`
+ * children (breadth first). Leaves are measured, like text.
+ */
+inline YGNodeRef
+buildYogaTree(YGConfigRef config, size_t nodeCount, size_t fanout) {
+  auto root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 1000);
+
+  auto nodes = std::vector<YGNodeRef>{root};
+  for (size_t index = 0; nodes.size() < nodeCount; index++) {
+    auto owner = nodes[index];
+    for (size_t i = 0; i < fanout && nodes.size() < nodeCount; i++) {
+      auto child = YGNodeNewWithConfig(config);
+      // Only a few distinct styles, as in an app rendering a list.
+      if (i % 3 == 0) {
+        YGNodeStyleSetFlexDirection(child, YGFlexDirectionRow);
+        YGNodeStyleSetPadding(child, YGEdgeAll, 4);
+      }
+      if (i % 3 == 1) {
+        YGNodeStyleSetFlexGrow(child, 1);
+      }
+      YGNodeInsertChild(owner, child, YGNodeGetChildCount(owner));
+      nodes.push_back(child);
+    }
+  }
+
+  for (auto node : nodes) {
+    if (YGNodeGetChildCount(node) == 0) {
+      node->setMeasureFunc(measureYogaLeaf);
+    }
+  }
+  return root;
+}
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,167 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "YogaLayoutThreadPool.h"
+
+#include <algorithm>
+
+namespace facebook {
+namespace react {
+
+constexpr size_t YogaLayoutThreadPool::MaxSharedWorkerCount;
+
+static YogaLayoutThreadPool::WorkerRunner &sharedWorkerRunner() {
+  static auto workerRunner = YogaLayoutThreadPool::WorkerRunner{};
+  return workerRunner;
+}
+
+YogaLayoutThreadPool &YogaLayoutThreadPool::sharedPool() {
+  // Never destroyed, so workers don't have to be joined at exit.
+  static auto &pool = *new YogaLayoutThreadPool(
+      std::min(
+          size_t{std::max(std::thread::hardware_concurrency(), 1u) - 1},
+          MaxSharedWorkerCount),
+      sharedWorkerRunner());
+  return pool;
+}
+
+void YogaLayoutThreadPool::setSharedWorkerRunner(WorkerRunner workerRunner) {
+  sharedWorkerRunner() = std::move(workerRunner);
+}
+
+YogaLayoutThreadPool::YogaLayoutThreadPool(
+    size_t workerCount,
+    WorkerRunner workerRunner) {
+  workers_.reserve(workerCount);
+  for (size_t i = 0; i < workerCount; i++) {
+    workers_.emplace_back([this, workerRunner]() {
+      if (workerRunner) {
+        workerRunner([this]() { workerLoop(); });
+      } else {
+        workerLoop();
+      }
+    });
+  }
+}
+
+YogaLayoutThreadPool::~YogaLayoutThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  condition_.notify_all();
+
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void YogaLayoutThreadPool::run(
+    size_t taskCount,
+    Task task,
+    void *taskContext) {
+  if (workers_.empty() || taskCount < 2) {
+    for (size_t taskIndex = 0; taskIndex < taskCount; taskIndex++) {
+      task(taskIndex, taskContext);
+    }
+    return;
+  }
+
+  auto batch = Batch{task, taskContext, taskCount};
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  batches_.push_back(&batch);
+  condition_.notify_all();
+
+  // Tasks of the own batch go first, then the tasks of other batches while
+  // the rest of the own batch is still running on other threads.
+  while (batch.nextTaskIndex < batch.taskCount) {
+    auto taskIndex = batch.nextTaskIndex++;
+    if (batch.nextTaskIndex == batch.taskCount) {
+      batches_.erase(std::find(batches_.begin(), batches_.end(), &batch));
+    }
+    runTask(lock, batch, taskIndex);
+  }
+
+  while (batch.finishedTaskCount < batch.taskCount) {
+    Batch *otherBatch = nullptr;
+    auto taskIndex = size_t{0};
+    if (takeTask(otherBatch, taskIndex)) {
+      runTask(lock, *otherBatch, taskIndex);
+    } else {
+      condition_.wait(lock);
+    }
+  }
+
+  // The batch is not in the queue anymore, so it's safe to unwind.
+  if (batch.exception) {
+    std::rethrow_exception(batch.exception);
+  }
+}
+
+bool YogaLayoutThreadPool::takeTask(Batch *&batch, size_t &taskIndex) {
+  if (batches_.empty()) {
+    return false;
+  }
+
+  batch = batches_.front();
+  taskIndex = batch->nextTaskIndex++;
+  if (batch->nextTaskIndex == batch->taskCount) {
+    batches_.pop_front();
+  }
+  return true;
+}
+
+void YogaLayoutThreadPool::runTask(
+    std::unique_lock<std::mutex> &lock,
+    Batch &batch,
+    size_t taskIndex) {
+  auto exception = std::exception_ptr{};
+
+  lock.unlock();
+  try {
+    batch.task(taskIndex, batch.taskContext);
+  } catch (...) {
+    exception = std::current_exception();
+  }
+  lock.lock();
+
+  if (exception && !batch.exception) {
+    batch.exception = exception;
+
+    // Skips the tasks which have not been taken yet.
+    if (batch.nextTaskIndex < batch.taskCount) {
+      batch.finishedTaskCount += batch.taskCount - batch.nextTaskIndex;
+      batch.nextTaskIndex = batch.taskCount;
+      batches_.erase(std::find(batches_.begin(), batches_.end(), &batch));
+    }
+  }
+
+  // The batch must not be touched after this point unless it is the own
+  // batch of the caller: its owner might return from `run` right away.
+  if (++batch.finishedTaskCount == batch.taskCount) {
+    condition_.notify_all();
+  }
+}
+
+void YogaLayoutThreadPool::workerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    Batch *batch = nullptr;
+    auto taskIndex = size_t{0};
+    if (takeTask(batch, taskIndex)) {
+      runTask(lock, *batch, taskIndex);
+    } else if (stopping_) {
+      return;
+    } else {
+      condition_.wait(lock);
+    }
+  }
+}
+
+} // namespace react
+} // namespace facebook
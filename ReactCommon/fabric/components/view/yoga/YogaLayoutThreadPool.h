@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace facebook {
+namespace react {
+
+/*
+ * Pool of threads which run batches of independent Yoga layout tasks.
+ * The thread which submits a batch takes part in running it, and while it
+ * waits for tasks taken by other threads it runs tasks of other batches.
+ * Because of that, tasks can submit nested batches (which Yoga does when
+ * a subtree has independent children itself) without deadlocking the pool.
+ * The class is thread-safe.
+ */
+class YogaLayoutThreadPool final {
+ public:
+  using Task = void (*)(size_t taskIndex, void *taskContext);
+
+  /*
+   * Runs the loop of a worker thread. Platforms use it to prepare threads for
+   * measure functions (e.g. on Android, workers must be attached to the JVM
+   * because text is measured through JNI).
+   */
+  using WorkerRunner =
+      std::function<void(std::function<void()> &&workerLoop)>;
+
+  /*
+   * Maximum number of workers of the shared pool. Layout tasks are short, so
+   * more threads mostly add contention.
+   */
+  static constexpr size_t MaxSharedWorkerCount = 3;
+
+  /*
+   * Returns a process-wide pool with a worker for every hardware thread
+   * besides the calling one (but at most `MaxSharedWorkerCount`).
+   */
+  static YogaLayoutThreadPool &sharedPool();
+
+  /*
+   * Sets the runner of the workers of the shared pool. Must be called before
+   * the first call of `sharedPool()`.
+   */
+  static void setSharedWorkerRunner(WorkerRunner workerRunner);
+
+  explicit YogaLayoutThreadPool(
+      size_t workerCount,
+      WorkerRunner workerRunner = nullptr);
+  ~YogaLayoutThreadPool();
+
+  YogaLayoutThreadPool(YogaLayoutThreadPool const &other) = delete;
+  YogaLayoutThreadPool &operator=(YogaLayoutThreadPool const &other) = delete;
+
+  /*
+   * Calls `task` for every index in [0, taskCount) and returns once all calls
+   * have returned. The calls might run concurrently in any order.
+   * If a call throws, the tasks which have not started yet are skipped and the
+   * (first) exception is rethrown once the running ones have returned.
+   */
+  void run(size_t taskCount, Task task, void *taskContext);
+
+ private:
+  struct Batch {
+    Task task;
+    void *taskContext;
+    size_t taskCount;
+    size_t nextTaskIndex{0};
+    size_t finishedTaskCount{0};
+    std::exception_ptr exception{};
+  };
+
+  /*
+   * Takes an index of a not yet started task of the oldest batch and removes
+   * the batch from the queue once all of its tasks are taken.
+   * Must be called with `mutex_` locked.
+   */
+  bool takeTask(Batch *&batch, size_t &taskIndex);
+
+  /*
+   * Runs the task with `mutex_` unlocked and marks it as finished. An
+   * exception thrown by the task is stored in the batch.
+   */
+  void runTask(
+      std::unique_lock<std::mutex> &lock,
+      Batch &batch,
+      size_t taskIndex);
+
+  void workerLoop();
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<Batch *> batches_; // Protected by `mutex_`.
+  bool stopping_{false}; // Protected by `mutex_`.
+  std::vector<std::thread> workers_;
+};
+
+} // namespace react
+} // namespace facebook
@@ -11,6 +11,7 @@
 #include <limits>
 #include <memory>
 
+#include <react/components/view/YogaLayoutThreadPool.h>
 #include <react/components/view/conversions.h>
 #include <react/core/LayoutConstraints.h>
 #include <react/core/LayoutContext.h>
@@ -21,6 +22,90 @@
 namespace facebook {
 namespace react {
 
+static LayoutConstraints layoutConstraintsFromYogaMeasureModes(
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  auto minimumSize = Size{0, 0};
+  auto maximumSize = Size{std::numeric_limits<Float>::infinity(),
+                          std::numeric_limits<Float>::infinity()};
+
+  switch (widthMode) {
+    case YGMeasureModeUndefined:
+      break;
+    case YGMeasureModeExactly:
+      minimumSize.width = floatFromYogaFloat(width);
+      maximumSize.width = floatFromYogaFloat(width);
+      break;
+    case YGMeasureModeAtMost:
+      maximumSize.width = floatFromYogaFloat(width);
+      break;
+  }
+
+  switch (heightMode) {
+    case YGMeasureModeUndefined:
+      break;
+    case YGMeasureModeExactly:
+      minimumSize.height = floatFromYogaFloat(height);
+      maximumSize.height = floatFromYogaFloat(height);
+      break;
+    case YGMeasureModeAtMost:
+      maximumSize.height = floatFromYogaFloat(height);
+      break;
+  }
+
+  return {minimumSize, maximumSize};
+}
+
+/*
+ * Returns the constraints of the last measurement of the node, or null if
+ * the node has never been laid out. The final layout pass of stretched nodes
+ * uses exact sizes, so `cachedLayout` is only consulted for nodes which were
+ * never measured with other constraints.
+ */
+static YGCachedMeasurement const *previousMeasurement(YGNode const &yogaNode) {
+  auto const &layout = yogaNode.getLayout();
+  if (auto measurement = layout.cachedMeasurements.latest()) {
+    return measurement;
+  }
+  if (layout.cachedLayout.widthMeasureMode == (YGMeasureMode)-1) {
+    return nullptr;
+  }
+  return &layout.cachedLayout;
+}
+
+/*
+ * Returns the constraints which the measure function of the node got during
+ * the last layout of the node, or nothing if the node has never been laid out.
+ */
+static better::optional<LayoutConstraints> previousMeasureLayoutConstraints(
+    YGNode const &yogaNode) {
+  auto const measurement = previousMeasurement(yogaNode);
+  if (!measurement) {
+    return {};
+  }
+  auto const &layout = yogaNode.getLayout();
+
+  // Same as Yoga does, margins, borders and paddings are excluded from the
+  // available size.
+  auto innerSize = [&](float availableSize, int leadingEdge, int trailingEdge) {
+    if (YGFloatIsUndefined(availableSize)) {
+      return availableSize;
+    }
+    auto insets = layout.margin[leadingEdge] + layout.margin[trailingEdge] +
+        layout.border[leadingEdge] + layout.border[trailingEdge] +
+        layout.padding[leadingEdge] + layout.padding[trailingEdge];
+    return std::max(0.0f, availableSize - insets);
+  };
+
+  return layoutConstraintsFromYogaMeasureModes(
+      innerSize(measurement->availableWidth, YGEdgeLeft, YGEdgeRight),
+      measurement->widthMeasureMode,
+      innerSize(measurement->availableHeight, YGEdgeTop, YGEdgeBottom),
+      measurement->heightMeasureMode);
+}
+
 YogaLayoutableShadowNode::YogaLayoutableShadowNode()
     : yogaNode_({}), yogaConfig_(nullptr) {
   initializeYogaConfig(yogaConfig_);
@@ -110,15 +195,45 @@ void YogaLayoutableShadowNode::setChildren(
 
   yogaNode_.setChildren({});
 
+  // Children which are relayout boundaries and keep the same style and
+  // position have the same size no matter what changed inside of them, so
+  // they don't dirty this node; they are laid out on their own instead.
+  // That's not true if the node aligns children by their baselines.
+  auto const canSkipRelayoutBoundaries =
+      yogaNode_.getStyle().alignItems() != YGAlignBaseline;
+  auto hasDirtyDescendants = false;
+
   auto i = int{0};
   for (auto const &child : children) {
     appendChild(child);
 
-    isClean = isClean && !child->yogaNode_.isDirty() &&
-        child->yogaNode_.getStyle() == oldChildren[i++]->getStyle();
+    auto const &childYogaNode = child->yogaNode_;
+    auto const isDirty = childYogaNode.isDirty();
+    hasDirtyDescendants =
+        hasDirtyDescendants || isDirty || child->getHasDirtyDescendants();
+
+    if (!isClean) {
+      continue;
+    }
+
+    auto const &oldChildYogaNode = *oldChildren[i++];
+    isClean = childYogaNode.getStyle() == oldChildYogaNode.getStyle() &&
+        (!isDirty ||
+         (canSkipRelayoutBoundaries && child->isRelayoutBoundary() &&
+          childYogaNode.getStyle().alignSelf() != YGAlignBaseline &&
+          childYogaNode.getLayout().position ==
+              oldChildYogaNode.getLayout().position &&
+          childYogaNode.getLayout().dimensions ==
+              oldChildYogaNode.getLayout().dimensions &&
+          !YGFloatIsUndefined(
+              childYogaNode.getLayout().dimensions[YGDimensionWidth])));
   }
 
   yogaNode_.setDirty(!isClean);
+
+  if (isClean && hasDirtyDescendants) {
+    setHasDirtyDescendants(true);
+  }
 }
 
 void YogaLayoutableShadowNode::setProps(const YogaStylableProps &props) {
@@ -130,6 +245,7 @@ void YogaLayoutableShadowNode::setProps(const YogaStylableProps &props) {
   }
 
   yogaNode_.setStyle(props.yogaStyle);
+  setIsRelayoutBoundary(styleDefinesRelayoutBoundary(props.yogaStyle));
 }
 
 void YogaLayoutableShadowNode::setSize(Size size) const {
@@ -167,11 +283,62 @@ void YogaLayoutableShadowNode::layout(LayoutContext layoutContext) {
      */
     yogaConfig_.pointScaleFactor = layoutContext.pointScaleFactor;
 
+    // Same as above, only the config of the root node is consulted.
+    yogaConfig_.runTasks = layoutContext.parallelLayout
+        ? YogaLayoutableShadowNode::yogaRunTasksCallbackConnector
+        : nullptr;
+
     {
+      SystraceSection s("YogaLayoutableShadowNode::prepareMeasurements");
+      prepareMeasurements(yogaNode_);
+    }
+
+    if (yogaNode_.getOwner() == nullptr) {
       SystraceSection s("YogaLayoutableShadowNode::YGNodeCalculateLayout");
 
       YGNodeCalculateLayout(
           &yogaNode_, YGUndefined, YGUndefined, YGDirectionInherit);
+    } else {
+      // The node is a relayout boundary inside of a clean tree (see
+      // `setChildren`), so it's laid out on its own. Its size is fixed, and
+      // its frame belongs to the layout of the parent which stays valid.
+      SystraceSection s("YogaLayoutableShadowNode::layoutRelayoutBoundary");
+
+      assert(isRelayoutBoundary());
+      auto const layout = yogaNode_.getLayout();
+
+      // Rounding to the pixel grid depends on the position of the node in the
+      // whole tree, so it's done separately.
+      yogaConfig_.pointScaleFactor = 0;
+      YGNodeCalculateLayout(
+          &yogaNode_, YGUndefined, YGUndefined, layout.direction);
+      yogaConfig_.pointScaleFactor = layoutContext.pointScaleFactor;
+
+      yogaNode_.setLayoutPosition(0, YGEdgeLeft);
+      yogaNode_.setLayoutPosition(0, YGEdgeTop);
+      YGNodeRoundToPixelGrid(
+          &yogaNode_, layout.absolutePosition[0], layout.absolutePosition[1]);
+
+      for (auto edge = 0; edge < (int)layout.position.size(); edge++) {
+        yogaNode_.setLayoutPosition(layout.position[edge], edge);
+      }
+      yogaNode_.setLayoutDimension(
+          layout.dimensions[YGDimensionWidth], YGDimensionWidth);
+      yogaNode_.setLayoutDimension(
+          layout.dimensions[YGDimensionHeight], YGDimensionHeight);
+
+      // Owners include the overflow of their children. (If the overflow is
+      // gone, owners keep theirs until they are laid out again, since it might
+      // come from something else.)
+      if (yogaNode_.getLayout().hadOverflow) {
+        for (auto owner = yogaNode_.getOwner();
+             owner != nullptr && !owner->getLayout().hadOverflow;
+             owner = owner->getOwner()) {
+          owner->setLayoutHadOverflow(true);
+        }
+      }
+
+      yogaNode_.setHasNewLayout(false);
     }
   }
 
@@ -240,6 +407,14 @@ YGNode *YogaLayoutableShadowNode::yogaNodeCloneCallbackConnector(
   return &clonedNode->yogaNode_;
 }
 
+void YogaLayoutableShadowNode::yogaRunTasksCallbackConnector(
+    YGConfig *config,
+    size_t taskCount,
+    YGConfig::TaskFn task,
+    void *taskContext) {
+  YogaLayoutThreadPool::sharedPool().run(taskCount, task, taskContext);
+}
+
 YGSize YogaLayoutableShadowNode::yogaNodeMeasureCallbackConnector(
     YGNode *yogaNode,
     float width,
@@ -252,38 +427,80 @@ YGSize YogaLayoutableShadowNode::yogaNodeMeasureCallbackConnector(
   auto shadowNodeRawPtr =
       static_cast<YogaLayoutableShadowNode *>(yogaNode->getContext());
 
-  auto minimumSize = Size{0, 0};
-  auto maximumSize = Size{std::numeric_limits<Float>::infinity(),
-                          std::numeric_limits<Float>::infinity()};
+  auto size = shadowNodeRawPtr->measure(layoutConstraintsFromYogaMeasureModes(
+      width, widthMode, height, heightMode));
 
-  switch (widthMode) {
-    case YGMeasureModeUndefined:
-      break;
-    case YGMeasureModeExactly:
-      minimumSize.width = floatFromYogaFloat(width);
-      maximumSize.width = floatFromYogaFloat(width);
-      break;
-    case YGMeasureModeAtMost:
-      maximumSize.width = floatFromYogaFloat(width);
-      break;
+  return YGSize{yogaFloatFromFloat(size.width),
+                yogaFloatFromFloat(size.height)};
+}
+
+void YogaLayoutableShadowNode::prepareMeasurements(YGNode const &yogaNode) {
+  for (auto const &childYogaNode : yogaNode.getChildren()) {
+    // Only dirty nodes are measured during the layout pass.
+    if (!childYogaNode->isDirty()) {
+      continue;
+    }
+
+    if (!childYogaNode->hasMeasureFunc()) {
+      prepareMeasurements(*childYogaNode);
+      continue;
+    }
+
+    // Yoga does not measure nodes which have exact sizes.
+    auto const measurement = previousMeasurement(*childYogaNode);
+    if (measurement &&
+        measurement->widthMeasureMode == YGMeasureModeExactly &&
+        measurement->heightMeasureMode == YGMeasureModeExactly) {
+      continue;
+    }
+
+    auto childNode =
+        static_cast<YogaLayoutableShadowNode *>(childYogaNode->getContext());
+    childNode->prepareMeasurement(
+        previousMeasureLayoutConstraints(*childYogaNode));
   }
+}
 
-  switch (heightMode) {
-    case YGMeasureModeUndefined:
-      break;
-    case YGMeasureModeExactly:
-      minimumSize.height = floatFromYogaFloat(height);
-      maximumSize.height = floatFromYogaFloat(height);
-      break;
-    case YGMeasureModeAtMost:
-      maximumSize.height = floatFromYogaFloat(height);
-      break;
+bool YogaLayoutableShadowNode::styleDefinesRelayoutBoundary(
+    YGStyle const &style) {
+  auto isFixed = [](YGValue value) { return value.unit == YGUnitPoint; };
+  auto isFixedOrUnset = [](YGValue value) {
+    return value.unit == YGUnitPoint || value.unit == YGUnitUndefined ||
+        value.unit == YGUnitAuto;
+  };
+
+  // The size must come from the style alone: no flexing, no stretching and
+  // nothing relative to the size of the parent.
+  if (!isFixed(style.dimensions()[YGDimensionWidth]) ||
+      !isFixed(style.dimensions()[YGDimensionHeight])) {
+    return false;
   }
 
-  auto size = shadowNodeRawPtr->measure({minimumSize, maximumSize});
+  for (auto dimension : {YGDimensionWidth, YGDimensionHeight}) {
+    if (!isFixedOrUnset(style.minDimensions()[dimension]) ||
+        !isFixedOrUnset(style.maxDimensions()[dimension])) {
+      return false;
+    }
+  }
 
-  return YGSize{yogaFloatFromFloat(size.width),
-                yogaFloatFromFloat(size.height)};
+  // Percentages of margins and positions are relative to the parent, which
+  // the node doesn't have when it's laid out on its own.
+  for (auto edge = 0; edge < facebook::yoga::enums::count<YGEdge>(); edge++) {
+    if (!isFixedOrUnset(style.padding()[edge]) ||
+        !isFixedOrUnset(style.margin()[edge]) ||
+        !isFixedOrUnset(style.position()[edge])) {
+      return false;
+    }
+  }
+
+  auto isZeroOrUnset = [](YGFloatOptional value) {
+    return value.isUndefined() || value.unwrap() == 0;
+  };
+
+  auto const flexBasis = YGValue(style.flexBasis());
+  return isZeroOrUnset(style.flex()) && isZeroOrUnset(style.flexGrow()) &&
+      isZeroOrUnset(style.flexShrink()) &&
+      (flexBasis.unit == YGUnitAuto || flexBasis.unit == YGUnitUndefined);
 }
 
 void YogaLayoutableShadowNode::initializeYogaConfig(YGConfig &config) {
@@ -108,10 +108,17 @@ class YogaLayoutableShadowNode : public LayoutableShadowNode,
 
  private:
   static void initializeYogaConfig(YGConfig &config);
+  static bool styleDefinesRelayoutBoundary(YGStyle const &style);
+  static void prepareMeasurements(YGNode const &yogaNode);
   static YGNode *yogaNodeCloneCallbackConnector(
       YGNode *oldYogaNode,
       YGNode *parentYogaNode,
       int childIndex);
+  static void yogaRunTasksCallbackConnector(
+      YGConfig *config,
+      size_t taskCount,
+      YGConfig::TaskFn task,
+      void *taskContext);
   static YGSize yogaNodeMeasureCallbackConnector(
       YGNode *yogaNode,
       float width,
@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+namespace facebook {
+namespace react {
+
+/*
+ * Lock-free queue which is filled by many threads and drained in batches.
+ * `push` is a single compare-and-swap, so producers (e.g. the UI thread
+ * delivering touch and scroll events) never wait for the consumer.
+ * `popAll` takes all enqueued values at once with a single atomic exchange
+ * and returns them in the order in which they were pushed.
+ */
+template <typename T>
+class BatchQueue final {
+ public:
+  BatchQueue() = default;
+  BatchQueue(BatchQueue const &) = delete;
+  BatchQueue &operator=(BatchQueue const &) = delete;
+
+  ~BatchQueue() {
+    deleteNodes(head_.exchange(nullptr));
+  }
+
+  /*
+   * Enqueues the value.
+   * Can be called on any thread.
+   */
+  void push(T value) {
+    auto node =
+        new Node{std::move(value), head_.load(std::memory_order_relaxed)};
+    while (!head_.compare_exchange_weak(
+        node->next,
+        node,
+        std::memory_order_release,
+        std::memory_order_relaxed)) {
+    }
+  }
+
+  /*
+   * Dequeues all values.
+   * Can be called on any thread; concurrent calls get disjoint batches.
+   */
+  std::vector<T> popAll() {
+    auto node = head_.exchange(nullptr, std::memory_order_acquire);
+
+    // Nodes are linked from the newest to the oldest one; reversing the list
+    // restores the order of `push` calls.
+    Node *oldest = nullptr;
+    auto size = size_t{0};
+    while (node) {
+      auto next = node->next;
+      node->next = oldest;
+      oldest = node;
+      node = next;
+      size++;
+    }
+
+    auto values = std::vector<T>{};
+    values.reserve(size);
+    for (auto it = oldest; it; it = it->next) {
+      values.push_back(std::move(it->value));
+    }
+
+    deleteNodes(oldest);
+    return values;
+  }
+
+  /*
+   * Returns `true` if there is nothing to dequeue at this moment.
+   */
+  bool empty() const {
+    return head_.load(std::memory_order_relaxed) == nullptr;
+  }
+
+ private:
+  struct Node {
+    T value;
+    Node *next;
+  };
+
+  static void deleteNodes(Node *node) {
+    while (node) {
+      auto next = node->next;
+      delete node;
+      node = next;
+    }
+  }
+
+  std::atomic<Node *> head_{nullptr};
+};
+
+} // namespace react
+} // namespace facebook
@@ -77,6 +77,26 @@ void EventEmitter::dispatchEvent(
       priority);
 }
 
+void EventEmitter::dispatchContinuousEvent(
+    const std::string &type,
+    const ValueFactory &payloadFactory,
+    const EventPriority &priority) const {
+  SystraceSection s("EventEmitter::dispatchContinuousEvent");
+
+  auto eventDispatcher = eventDispatcher_.lock();
+  if (!eventDispatcher) {
+    return;
+  }
+
+  eventDispatcher->dispatchEvent(
+      RawEvent(
+          normalizeEventType(type),
+          payloadFactory,
+          eventTarget_,
+          RawEvent::Category::Continuous),
+      priority);
+}
+
 void EventEmitter::setEnabled(bool enabled) const {
   enableCounter_ += enabled ? 1 : -1;
 
@@ -82,6 +82,17 @@ class EventEmitter {
       const folly::dynamic &payload,
       const EventPriority &priority = EventPriority::AsynchronousBatched) const;
 
+  /*
+   * Initates a delivery of an event which describes a continuous change
+   * (e.g. scrolling); if several events of the same type are waiting for
+   * delivery, only the latest one is delivered.
+   * Is used by particular subclasses only.
+   */
+  void dispatchContinuousEvent(
+      const std::string &type,
+      const ValueFactory &payloadFactory,
+      const EventPriority &priority = EventPriority::AsynchronousBatched) const;
+
  private:
   void toggleEventTargetOwnership_() const;
 
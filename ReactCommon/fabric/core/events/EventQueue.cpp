@@ -24,19 +24,13 @@ EventQueue::EventQueue(
 }
 
 void EventQueue::enqueueEvent(const RawEvent &rawEvent) const {
-  {
-    std::lock_guard<std::mutex> lock(queueMutex_);
-    eventQueue_.push_back(rawEvent);
-  }
+  eventQueue_.push(rawEvent);
 
   onEnqueue();
 }
 
 void EventQueue::enqueueStateUpdate(const StateUpdate &stateUpdate) const {
-  {
-    std::lock_guard<std::mutex> lock(queueMutex_);
-    stateUpdateQueue_.push_back(stateUpdate);
-  }
+  stateUpdateQueue_.push(stateUpdate);
 
   onEnqueue();
 }
@@ -51,59 +45,46 @@ void EventQueue::onBeat(jsi::Runtime &runtime) const {
 }
 
 void EventQueue::flushEvents(jsi::Runtime &runtime) const {
-  std::vector<RawEvent> queue;
-
-  {
-    std::lock_guard<std::mutex> lock(queueMutex_);
+  if (eventQueue_.empty()) {
+    return;
+  }
 
-    if (eventQueue_.size() == 0) {
-      return;
-    }
+  auto queue = eventQueue_.popAll();
+  auto events = coalesceRawEvents(queue);
 
-    queue = std::move(eventQueue_);
-    eventQueue_.clear();
-  }
+  // Events of a batch usually share a few targets (e.g. a stream of scroll
+  // events), so every target is retained and released only once.
+  auto eventTargets = uniqueEventTargets(events);
 
   {
     std::lock_guard<std::mutex> lock(EventEmitter::DispatchMutex());
 
-    for (const auto &event : queue) {
-      if (event.eventTarget) {
-        event.eventTarget->retain(runtime);
-      }
+    for (auto eventTarget : eventTargets) {
+      eventTarget->retain(runtime);
     }
   }
 
-  for (const auto &event : queue) {
+  for (auto event : events) {
     eventPipe_(
-        runtime, event.eventTarget.get(), event.type, event.payloadFactory);
+        runtime, event->eventTarget.get(), event->type, event->payloadFactory);
   }
 
   // No need to lock `EventEmitter::DispatchMutex()` here.
   // The mutex protects from a situation when the `instanceHandle` can be
   // deallocated during accessing, but that's impossible at this point because
-  // we have a strong pointer to it.
-  for (const auto &event : queue) {
-    if (event.eventTarget) {
-      event.eventTarget->release(runtime);
-    }
+  // we have a strong pointer to it (`queue` owns the targets).
+  for (auto eventTarget : eventTargets) {
+    eventTarget->release(runtime);
   }
 }
 
 void EventQueue::flushStateUpdates() const {
-  std::vector<StateUpdate> stateUpdateQueue;
-
-  {
-    std::lock_guard<std::mutex> lock(queueMutex_);
-
-    if (stateUpdateQueue_.size() == 0) {
-      return;
-    }
-
-    stateUpdateQueue = std::move(stateUpdateQueue_);
-    stateUpdateQueue_.clear();
+  if (stateUpdateQueue_.empty()) {
+    return;
   }
 
+  auto stateUpdateQueue = stateUpdateQueue_.popAll();
+
   for (const auto &stateUpdate : stateUpdateQueue) {
     auto pair = stateUpdate();
     statePipe_(pair.second, pair.first);
@@ -8,10 +8,9 @@
 #pragma once
 
 #include <memory>
-#include <mutex>
-#include <vector>
 
 #include <jsi/jsi.h>
+#include <react/core/BatchQueue.h>
 #include <react/core/EventBeat.h>
 #include <react/core/EventPipe.h>
 #include <react/core/RawEvent.h>
@@ -60,10 +59,9 @@ class EventQueue {
   const EventPipe eventPipe_;
   const StatePipe statePipe_;
   const std::unique_ptr<EventBeat> eventBeat_;
-  // Thread-safe, protected by `queueMutex_`.
-  mutable std::vector<RawEvent> eventQueue_;
-  mutable std::vector<StateUpdate> stateUpdateQueue_;
-  mutable std::mutex queueMutex_;
+  // Thread-safe, lock-free.
+  mutable BatchQueue<RawEvent> eventQueue_;
+  mutable BatchQueue<StateUpdate> stateUpdateQueue_;
 };
 
 } // namespace react
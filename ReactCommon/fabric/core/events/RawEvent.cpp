@@ -7,16 +7,87 @@
 
 #include "RawEvent.h"
 
+#include <algorithm>
+
 namespace facebook {
 namespace react {
 
 RawEvent::RawEvent(
     std::string type,
     ValueFactory payloadFactory,
-    SharedEventTarget eventTarget)
+    SharedEventTarget eventTarget,
+    Category category)
     : type(std::move(type)),
       payloadFactory(std::move(payloadFactory)),
-      eventTarget(std::move(eventTarget)) {}
+      eventTarget(std::move(eventTarget)),
+      category(category) {}
+
+std::vector<RawEvent const *> coalesceRawEvents(
+    std::vector<RawEvent> const &rawEvents) {
+  auto result = std::vector<RawEvent const *>{};
+  result.reserve(rawEvents.size());
+
+  // Walking from the newest event to the oldest one, `pendingEvents` holds
+  // continuous events which supersede older events of the same type and
+  // target. A batch usually has a handful of targets, so a linear search is
+  // fine here.
+  auto pendingEvents = std::vector<RawEvent const *>{};
+
+  for (auto it = rawEvents.rbegin(); it != rawEvents.rend(); ++it) {
+    auto const &rawEvent = *it;
+
+    if (rawEvent.category == RawEvent::Category::Discrete) {
+      // Events before a discrete one must not be replaced by events after it.
+      pendingEvents.erase(
+          std::remove_if(
+              pendingEvents.begin(),
+              pendingEvents.end(),
+              [&](RawEvent const *pendingEvent) {
+                return pendingEvent->eventTarget == rawEvent.eventTarget;
+              }),
+          pendingEvents.end());
+      result.push_back(&rawEvent);
+      continue;
+    }
+
+    auto isSuperseded = std::any_of(
+        pendingEvents.begin(),
+        pendingEvents.end(),
+        [&](RawEvent const *pendingEvent) {
+          return pendingEvent->eventTarget == rawEvent.eventTarget &&
+              pendingEvent->type == rawEvent.type;
+        });
+
+    if (!isSuperseded) {
+      pendingEvents.push_back(&rawEvent);
+      result.push_back(&rawEvent);
+    }
+  }
+
+  std::reverse(result.begin(), result.end());
+  return result;
+}
+
+std::vector<EventTarget const *> uniqueEventTargets(
+    std::vector<RawEvent const *> const &rawEvents) {
+  auto eventTargets = std::vector<EventTarget const *>{};
+  eventTargets.reserve(rawEvents.size());
+  for (auto rawEvent : rawEvents) {
+    auto eventTarget = rawEvent->eventTarget.get();
+    // Consecutive events usually share the target, so most duplicates are
+    // skipped right away.
+    if (eventTarget &&
+        (eventTargets.empty() || eventTargets.back() != eventTarget)) {
+      eventTargets.push_back(eventTarget);
+    }
+  }
+
+  std::sort(eventTargets.begin(), eventTargets.end());
+  eventTargets.erase(
+      std::unique(eventTargets.begin(), eventTargets.end()),
+      eventTargets.end());
+  return eventTargets;
+}
 
 } // namespace react
 } // namespace facebook
@@ -8,6 +8,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <react/core/EventTarget.h>
 #include <react/core/ValueFactory.h>
@@ -20,15 +21,40 @@ namespace react {
  */
 class RawEvent {
  public:
+  /*
+   * Continuous events (e.g. `scroll` or `touchMove`) describe the latest
+   * state of something, so an event can be dropped if a newer one of the same
+   * type for the same target is waiting for delivery.
+   * Discrete events are always delivered, in order.
+   */
+  enum class Category { Discrete, Continuous };
+
   RawEvent(
       std::string type,
       ValueFactory payloadFactory,
-      SharedEventTarget eventTarget);
+      SharedEventTarget eventTarget,
+      Category category = Category::Discrete);
 
   const std::string type;
   const ValueFactory payloadFactory;
   const SharedEventTarget eventTarget;
+  const Category category;
 };
 
+/*
+ * Returns the events which must be delivered, preserving their order.
+ * A continuous event is skipped if a later event of the same type and target
+ * follows it without a discrete event for that target in between.
+ */
+std::vector<RawEvent const *> coalesceRawEvents(
+    std::vector<RawEvent> const &rawEvents);
+
+/*
+ * Returns the distinct (non-null) targets of the events, in no particular
+ * order, so every target can be retained and released once per batch.
+ */
+std::vector<EventTarget const *> uniqueEventTargets(
+    std::vector<RawEvent const *> const &rawEvents);
+
 } // namespace react
 } // namespace facebook
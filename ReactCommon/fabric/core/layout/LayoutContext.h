@@ -41,6 +41,13 @@ struct LayoutContext {
    * purpose), make sure the memory is managed responsibly.
    */
   std::vector<LayoutableShadowNode const *> *affectedNodes{};
+
+  /*
+   * If `true`, the layout system might lay out independent subtrees
+   * concurrently on several threads. Measuring of all nodes in the tree
+   * must be thread-safe in this case.
+   */
+  bool parallelLayout{false};
 };
 
 } // namespace react
@@ -32,6 +32,24 @@ bool LayoutableShadowNode::setLayoutMetrics(LayoutMetrics layoutMetrics) {
   return true;
 }
 
+bool LayoutableShadowNode::isRelayoutBoundary() const {
+  return isRelayoutBoundary_;
+}
+
+void LayoutableShadowNode::setIsRelayoutBoundary(bool isRelayoutBoundary) {
+  ensureUnsealed();
+  isRelayoutBoundary_ = isRelayoutBoundary;
+}
+
+bool LayoutableShadowNode::getHasDirtyDescendants() const {
+  return hasDirtyDescendants_;
+}
+
+void LayoutableShadowNode::setHasDirtyDescendants(bool hasDirtyDescendants) {
+  ensureUnsealed();
+  hasDirtyDescendants_ = hasDirtyDescendants;
+}
+
 bool LayoutableShadowNode::LayoutableShadowNode::isLayoutOnly() const {
   return false;
 }
@@ -77,6 +95,9 @@ Size LayoutableShadowNode::measure(LayoutConstraints layoutConstraints) const {
   return Size();
 }
 
+void LayoutableShadowNode::prepareMeasurement(
+    better::optional<LayoutConstraints> const &layoutConstraints) const {}
+
 Float LayoutableShadowNode::firstBaseline(Size size) const {
   return 0;
 }
@@ -88,9 +109,18 @@ Float LayoutableShadowNode::lastBaseline(Size size) const {
 void LayoutableShadowNode::layout(LayoutContext layoutContext) {
   layoutChildren(layoutContext);
 
+  if (hasDirtyDescendants_) {
+    setHasDirtyDescendants(false);
+  }
+
   for (auto child : getLayoutableChildNodes()) {
     if (!child->getHasNewLayout()) {
-      continue;
+      // The child was not laid out as part of this node, but it still might
+      // be (or contain) a dirty relayout boundary which has to be laid out on
+      // its own.
+      if (child->getIsLayoutClean() && !child->hasDirtyDescendants_) {
+        continue;
+      }
     }
 
     child->ensureUnsealed();
@@ -104,7 +134,7 @@ void LayoutableShadowNode::layout(LayoutContext layoutContext) {
     auto childLayoutContext = LayoutContext(layoutContext);
     childLayoutContext.absolutePosition += childLayoutMetrics.frame.origin;
 
-    child->layout(layoutContext);
+    child->layout(childLayoutContext);
   }
 }
 
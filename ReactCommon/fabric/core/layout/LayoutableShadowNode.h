@@ -12,6 +12,7 @@
 #include <memory>
 #include <vector>
 
+#include <better/optional.h>
 #include <better/small_vector.h>
 #include <react/core/LayoutMetrics.h>
 #include <react/core/Sealable.h>
@@ -43,6 +44,16 @@ class LayoutableShadowNode : public virtual Sealable {
    */
   virtual Size measure(LayoutConstraints layoutConstraints) const;
 
+  /*
+   * Called before a layout pass for nodes which are going to be measured
+   * during the pass, with the constraints which were used for measuring
+   * during the previous pass (if any). Allows to prepare measurements in
+   * advance (e.g. to measure many nodes at once).
+   * Default implementation does nothing.
+   */
+  virtual void prepareMeasurement(
+      better::optional<LayoutConstraints> const &layoutConstraints) const;
+
   /*
    * Computes layout recusively.
    * Additional environmental constraints might be provided via `layoutContext`
@@ -73,6 +84,14 @@ class LayoutableShadowNode : public virtual Sealable {
    */
   virtual Transform getTransform() const;
 
+  /*
+   * Returns `true` if the size of the node depends neither on its content nor
+   * on its parent, so changes inside of the subtree can be laid out without
+   * laying out ancestors of the node.
+   * The value is computed (and cached) when the node gets its props.
+   */
+  bool isRelayoutBoundary() const;
+
   /*
    * Returns layout metrics relatively to the given ancestor node.
    */
@@ -96,6 +115,16 @@ class LayoutableShadowNode : public virtual Sealable {
   virtual void setHasNewLayout(bool hasNewLayout) = 0;
   virtual bool getHasNewLayout() const = 0;
 
+  /*
+   * Indicates whether a descendant node got dirty layout which did not dirty
+   * this node because it is behind a relayout boundary. Layout of such
+   * descendants starts at the boundary instead of the root node.
+   */
+  void setHasDirtyDescendants(bool hasDirtyDescendants);
+  bool getHasDirtyDescendants() const;
+
+  void setIsRelayoutBoundary(bool isRelayoutBoundary);
+
   /*
    * Applies layout for all children;
    * does not call anything in recusive manner *by desing*.
@@ -136,6 +165,8 @@ class LayoutableShadowNode : public virtual Sealable {
 
  private:
   LayoutMetrics layoutMetrics_{};
+  bool isRelayoutBoundary_{false};
+  bool hasDirtyDescendants_{false};
 };
 
 } // namespace react
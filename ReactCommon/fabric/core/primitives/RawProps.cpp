@@ -6,3 +6,73 @@
  */
 
 #include "RawProps.h"
+
+#include <react/core/RawPropsParser.h>
+
+namespace facebook {
+namespace react {
+
+RawProps::RawProps() noexcept : mode_(Mode::Empty) {}
+
+RawProps::RawProps(jsi::Runtime &runtime, const jsi::Value &value) noexcept
+#ifdef ANDROID
+    // Android needs all props as `folly::dynamic` anyway.
+    : RawProps(
+          value.isNull() ? folly::dynamic::object()
+                         : jsi::dynamicFromValue(runtime, value)) {
+}
+#else
+    : mode_(Mode::JSI), runtime_(&runtime), value_(runtime, value) {
+}
+#endif
+
+RawProps::RawProps(const folly::dynamic &dynamic) noexcept
+    : mode_(Mode::Dynamic), dynamic_(dynamic) {}
+
+void RawProps::parse(RawPropsParser const &parser) const noexcept {
+  if (parser_ == &parser) {
+    return;
+  }
+
+  parser_ = &parser;
+  parser.preparse(*this);
+}
+
+const RawValue *RawProps::at(
+    char const *name,
+    char const *prefix,
+    char const *suffix) const noexcept {
+  auto key = RawPropsKey{prefix, name, suffix};
+  if (parser_) {
+    return parser_->at(*this, key);
+  }
+  return unparsedAt(key);
+}
+
+const RawValue *RawProps::unparsedAt(RawPropsKey const &key) const noexcept {
+  if (!unparsedMap_.has_value()) {
+    switch (mode_) {
+      case Mode::Empty:
+        unparsedMap_ = better::map<std::string, RawValue>{};
+        break;
+      case Mode::JSI:
+        unparsedMap_ = (better::map<std::string, RawValue>)RawValue(
+            value_.isObject() ? jsi::dynamicFromValue(*runtime_, value_)
+                              : folly::dynamic::object());
+        break;
+      case Mode::Dynamic:
+        unparsedMap_ = (better::map<std::string, RawValue>)RawValue(dynamic_);
+        break;
+    }
+  }
+
+  auto iterator = unparsedMap_->find((std::string)key);
+  if (iterator == unparsedMap_->end()) {
+    return nullptr;
+  }
+
+  return &iterator->second;
+}
+
+} // namespace react
+} // namespace facebook
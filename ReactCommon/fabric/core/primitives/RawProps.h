@@ -7,15 +7,21 @@
 
 #pragma once
 
+#include <vector>
+
 #include <better/map.h>
+#include <better/optional.h>
 #include <folly/dynamic.h>
 #include <jsi/JSIDynamic.h>
 #include <jsi/jsi.h>
+#include <react/core/RawPropsKey.h>
 #include <react/core/RawValue.h>
 
 namespace facebook {
 namespace react {
 
+class RawPropsParser;
+
 /*
  * `RawProps` represents an untyped map of props comes from JavaScript side.
  * `RawProps` stores JSI (or `folly::dynamic`) primitives inside and abstract
@@ -25,16 +31,25 @@ namespace react {
  * The class is practically a wrapper around a `jsi::Value and `jsi::Runtime`
  * pair (or folly::dynamic) preventing direct access to it and inefficient
  * misuse. Not copyable, not moveable.
+ * Props are converted lazily: `parse` converts (in a single pass) only values
+ * of props which a particular `RawPropsParser` knows about.
  */
 class RawProps {
  public:
+  /*
+   * Mode of the storage.
+   */
+  enum class Mode { Empty, JSI, Dynamic };
+
+  /*
+   * Creates empty RawProps objects.
+   */
+  RawProps() noexcept;
+
   /*
    * Creates an object with given `runtime` and `value`.
    */
-  RawProps(jsi::Runtime &runtime, const jsi::Value &value) noexcept
-      : RawProps(
-            value.isNull() ? folly::dynamic::object()
-                           : jsi::dynamicFromValue(runtime, value)) {}
+  RawProps(jsi::Runtime &runtime, const jsi::Value &value) noexcept;
 
   /*
    * Creates an object with given `folly::dynamic` object.
@@ -42,13 +57,7 @@ class RawProps {
    * We need this temporary, only because we have a callsite that does not have
    * a `jsi::Runtime` behind the data.
    */
-  RawProps(const folly::dynamic &dynamic) noexcept
-      :
-#ifdef ANDROID
-        dynamic_(dynamic),
-#endif
-        map_((better::map<std::string, RawValue>)RawValue(dynamic)) {
-  }
+  RawProps(const folly::dynamic &dynamic) noexcept;
 
   /*
    * Not moveable.
@@ -62,6 +71,13 @@ class RawProps {
   RawProps(const RawProps &other) noexcept = delete;
   RawProps &operator=(const RawProps &other) noexcept = delete;
 
+  /*
+   * Converts values of props which `parser` knows about, so they can be
+   * accessed with `at`. Does nothing if the object was already parsed with
+   * the same parser.
+   */
+  void parse(RawPropsParser const &parser) const noexcept;
+
 #ifdef ANDROID
   /*
    * Deprecated. Do not use.
@@ -74,24 +90,48 @@ class RawProps {
 #endif
 
   /*
-   * Returns a const unowning pointer to `RawValue` of a prop with a given name.
+   * Returns a const unowning pointer to `RawValue` of a prop with a given name
+   * (`prefix` + `name` + `suffix`).
    * Returns `nullptr` if a prop with the given name does not exist.
    */
-  const RawValue *at(const std::string &name) const noexcept {
-    auto iterator = map_.find(name);
-    if (iterator == map_.end()) {
-      return nullptr;
-    }
-
-    return &iterator->second;
-  }
+  const RawValue *at(
+      char const *name,
+      char const *prefix = nullptr,
+      char const *suffix = nullptr) const noexcept;
 
  private:
-#ifdef ANDROID
-  const folly::dynamic dynamic_;
-#endif
+  friend class RawPropsParser;
+
+  /*
+   * Slow path for objects which were not parsed and props which the parser
+   * does not know about.
+   */
+  const RawValue *unparsedAt(RawPropsKey const &key) const noexcept;
+
+  Mode mode_;
 
-  const better::map<std::string, RawValue> map_;
+  /*
+   * Source artefacts:
+   */
+  // Case 1: Source data is represented as `jsi::Object`.
+  jsi::Runtime *runtime_{};
+  jsi::Value value_{};
+
+  // Case 2: Source data is represented as `folly::dynamic`.
+  folly::dynamic dynamic_{};
+
+  /*
+   * Parsed artefacts (filled by `RawPropsParser`):
+   */
+  mutable RawPropsParser const *parser_{};
+  mutable RawPropsValueIndex keyIndexCursor_{0};
+  mutable std::vector<RawPropsValueIndex> keyIndexToValueIndex_{};
+  mutable std::vector<RawValue> values_{};
+
+  /*
+   * All props, converted on demand by `unparsedAt`.
+   */
+  mutable better::optional<better::map<std::string, RawValue>> unparsedMap_{};
 };
 
 } // namespace react
@@ -0,0 +1,69 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "RawPropsKey.h"
+
+#include <cstring>
+
+namespace facebook {
+namespace react {
+
+static bool appendPart(
+    char *buffer,
+    RawPropsPropNameLength *length,
+    char const *part) noexcept {
+  if (!part) {
+    return true;
+  }
+
+  auto partLength = std::strlen(part);
+  if (*length + partLength >= kPropNameLengthHardCap) {
+    return false;
+  }
+  std::memcpy(buffer + *length, part, partLength);
+  *length += partLength;
+  return true;
+}
+
+bool RawPropsKey::render(char *buffer, RawPropsPropNameLength *length) const
+    noexcept {
+  *length = 0;
+  auto fits = appendPart(buffer, length, prefix) &&
+      appendPart(buffer, length, name) && appendPart(buffer, length, suffix);
+  buffer[*length] = '\0';
+  return fits;
+}
+
+RawPropsKey::operator std::string() const noexcept {
+  // Not limited by `kPropNameLengthHardCap`.
+  auto string = std::string{prefix ? prefix : ""};
+  string += name ? name : "";
+  string += suffix ? suffix : "";
+  return string;
+}
+
+static bool partsAreEqual(char const *lhs, char const *rhs) noexcept {
+  // String literals are usually deduplicated, so comparing pointers is enough
+  // in most cases. A missing part is the same as an empty one.
+  if (lhs == rhs) {
+    return true;
+  }
+  return std::strcmp(lhs ? lhs : "", rhs ? rhs : "") == 0;
+}
+
+bool operator==(RawPropsKey const &lhs, RawPropsKey const &rhs) noexcept {
+  return partsAreEqual(lhs.name, rhs.name) &&
+      partsAreEqual(lhs.prefix, rhs.prefix) &&
+      partsAreEqual(lhs.suffix, rhs.suffix);
+}
+
+bool operator!=(RawPropsKey const &lhs, RawPropsKey const &rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+} // namespace react
+} // namespace facebook
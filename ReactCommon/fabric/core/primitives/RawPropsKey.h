@@ -0,0 +1,67 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace facebook {
+namespace react {
+
+/*
+ * Type used to represent an index of some stored values in small arrays.
+ */
+using RawPropsValueIndex = uint16_t;
+static_assert(
+    sizeof(RawPropsValueIndex) == 2,
+    "RawPropsValueIndex must be two byte size.");
+
+/*
+ * A special value of `RawPropsValueIndex` that represents no value.
+ */
+constexpr static RawPropsValueIndex kRawPropsValueIndexEmpty =
+    std::numeric_limits<RawPropsValueIndex>::max();
+
+/*
+ * Type used to represent a length of a prop name.
+ */
+using RawPropsPropNameLength = uint16_t;
+
+/*
+ * Maximum length of a prop name (with prefix and suffix).
+ */
+constexpr static RawPropsPropNameLength kPropNameLengthHardCap = 64;
+
+/*
+ * Represents a name of a prop as three (possibly empty) parts: a prefix, a
+ * name and a suffix (e.g. `border` + `Left` + `Width`), so names of props
+ * which share prefixes do not need to be concatenated in memory.
+ * All parts must be string literals (or any strings which outlive the key).
+ */
+class RawPropsKey final {
+ public:
+  char const *prefix{};
+  char const *name{};
+  char const *suffix{};
+
+  /*
+   * Writes the whole name to `buffer` (which must be at least
+   * `kPropNameLengthHardCap` bytes long) and its length to `length`.
+   * Returns `false` if the name is too long to fit into the buffer.
+   */
+  bool render(char *buffer, RawPropsPropNameLength *length) const noexcept;
+
+  explicit operator std::string() const noexcept;
+};
+
+bool operator==(RawPropsKey const &lhs, RawPropsKey const &rhs) noexcept;
+bool operator!=(RawPropsKey const &lhs, RawPropsKey const &rhs) noexcept;
+
+} // namespace react
+} // namespace facebook
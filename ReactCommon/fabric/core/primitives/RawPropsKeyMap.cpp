@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "RawPropsKeyMap.h"
+
+#include <cassert>
+#include <cstring>
+
+namespace facebook {
+namespace react {
+
+bool RawPropsKeyMap::insert(
+    RawPropsKey const &key,
+    RawPropsValueIndex value) noexcept {
+  auto item = Item{};
+  item.value = value;
+  if (!key.render(item.name, &item.length)) {
+    return false;
+  }
+  items_.push_back(item);
+  buckets_.clear();
+  return true;
+}
+
+uint32_t RawPropsKeyMap::hash(
+    char const *name,
+    RawPropsPropNameLength length) const noexcept {
+  // FNV-1a with a seed.
+  auto hash = uint32_t{2166136261u} ^ seed_;
+  for (RawPropsPropNameLength i = 0; i < length; i++) {
+    hash = (hash ^ static_cast<uint8_t>(name[i])) * 16777619u;
+  }
+  return hash ^ (hash >> 15);
+}
+
+void RawPropsKeyMap::reindex() noexcept {
+  assert(items_.size() < kRawPropsValueIndexEmpty && "Too many props.");
+
+  // Starts with a table which is at least twice as large as the number of
+  // items and tries different seeds; the table grows if none of them works.
+  auto size = uint32_t{4};
+  while (size < items_.size() * 2) {
+    size *= 2;
+  }
+
+  while (true) {
+    for (auto seed = uint32_t{0}; seed < 32; seed++) {
+      seed_ = seed;
+      mask_ = size - 1;
+      buckets_.assign(size, kRawPropsValueIndexEmpty);
+
+      auto hasCollisions = false;
+      for (size_t index = 0; index < items_.size(); index++) {
+        auto const &item = items_[index];
+        auto &bucket = buckets_[hash(item.name, item.length) & mask_];
+        if (bucket != kRawPropsValueIndexEmpty) {
+          hasCollisions = true;
+          break;
+        }
+        bucket = static_cast<RawPropsValueIndex>(index);
+      }
+
+      if (!hasCollisions) {
+        return;
+      }
+    }
+
+    size *= 2;
+  }
+}
+
+RawPropsValueIndex RawPropsKeyMap::at(
+    char const *name,
+    RawPropsPropNameLength length) const noexcept {
+  if (buckets_.empty()) {
+    // Nothing has been indexed yet.
+    return kRawPropsValueIndexEmpty;
+  }
+
+  auto itemIndex = buckets_[hash(name, length) & mask_];
+  if (itemIndex == kRawPropsValueIndexEmpty) {
+    return kRawPropsValueIndexEmpty;
+  }
+
+  auto const &item = items_[itemIndex];
+  if (item.length != length || std::memcmp(item.name, name, length) != 0) {
+    return kRawPropsValueIndexEmpty;
+  }
+
+  return item.value;
+}
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,64 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <react/core/RawPropsKey.h>
+
+namespace facebook {
+namespace react {
+
+/*
+ * A map from prop names to indexes which is built once (for a specific set of
+ * props) and then only read.
+ * `reindex()` searches for a hash function which has no collisions on the
+ * set, so `at()` computes one hash and compares at most one name.
+ */
+class RawPropsKeyMap final {
+ public:
+  /*
+   * Stores `value` for `key`. The value cannot be found until `reindex()` is
+   * called.
+   * Returns `false` (and stores nothing) if the name of the key is not
+   * shorter than `kPropNameLengthHardCap`.
+   */
+  bool insert(RawPropsKey const &key, RawPropsValueIndex value) noexcept;
+
+  /*
+   * Builds the hash table.
+   */
+  void reindex() noexcept;
+
+  /*
+   * Returns the value stored for a name, or `kRawPropsValueIndexEmpty`.
+   */
+  RawPropsValueIndex at(char const *name, RawPropsPropNameLength length) const
+      noexcept;
+
+ private:
+  struct Item {
+    RawPropsValueIndex value;
+    RawPropsPropNameLength length;
+    char name[kPropNameLengthHardCap];
+  };
+
+  uint32_t hash(char const *name, RawPropsPropNameLength length) const
+      noexcept;
+
+  std::vector<Item> items_{};
+
+  // Indexes of `items_` (or `kRawPropsValueIndexEmpty`) by hash.
+  std::vector<RawPropsValueIndex> buckets_{};
+  uint32_t seed_{0};
+  uint32_t mask_{0};
+};
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "RawPropsParser.h"
+
+#include <cassert>
+
+namespace facebook {
+namespace react {
+
+RawValue const *RawPropsParser::at(
+    RawProps const &rawProps,
+    RawPropsKey const &key) const noexcept {
+  if (!ready_) {
+    // Preparation: recording all the props which the Props type reads.
+    // Props with names which are too long to be indexed are not recorded;
+    // they are always read from the unparsed values.
+    if (indexOf(key) == kRawPropsValueIndexEmpty &&
+        nameToIndex_.insert(
+            key, static_cast<RawPropsValueIndex>(keys_.size()))) {
+      keys_.push_back(key);
+      nameToIndex_.reindex();
+    }
+    return nullptr;
+  }
+
+  // Props are read in the same order every time, so the next key is usually
+  // the expected one, which does not require hashing the name.
+  auto keyIndex = rawProps.keyIndexCursor_;
+  if (keyIndex >= keys_.size() || keys_[keyIndex] != key) {
+    keyIndex = indexOf(key);
+    if (keyIndex == kRawPropsValueIndexEmpty) {
+      // The prop was not read during the preparation (e.g. it's read
+      // conditionally), so it was not parsed.
+      return rawProps.unparsedAt(key);
+    }
+  }
+
+  rawProps.keyIndexCursor_ = keyIndex + 1;
+  auto valueIndex = rawProps.keyIndexToValueIndex_[keyIndex];
+  if (valueIndex == kRawPropsValueIndexEmpty) {
+    return nullptr;
+  }
+  return &rawProps.values_[valueIndex];
+}
+
+RawPropsValueIndex RawPropsParser::indexOf(RawPropsKey const &key) const
+    noexcept {
+  char buffer[kPropNameLengthHardCap];
+  RawPropsPropNameLength length;
+  if (!key.render(buffer, &length)) {
+    return kRawPropsValueIndexEmpty;
+  }
+  return nameToIndex_.at(buffer, length);
+}
+
+void RawPropsParser::postPrepare() noexcept {
+  ready_ = true;
+  nameToIndex_.reindex();
+}
+
+void RawPropsParser::preparse(RawProps const &rawProps) const noexcept {
+  rawProps.keyIndexToValueIndex_.assign(
+      keys_.size(), kRawPropsValueIndexEmpty);
+  rawProps.keyIndexCursor_ = 0;
+  rawProps.values_.clear();
+
+  if (!ready_) {
+    return;
+  }
+
+  auto indexOfName = [&](std::string const &name) {
+    if (name.size() >= kPropNameLengthHardCap) {
+      return kRawPropsValueIndexEmpty;
+    }
+    return nameToIndex_.at(
+        name.data(), static_cast<RawPropsPropNameLength>(name.size()));
+  };
+
+  auto storeValue = [&](RawPropsValueIndex keyIndex, folly::dynamic value) {
+    rawProps.keyIndexToValueIndex_[keyIndex] =
+        static_cast<RawPropsValueIndex>(rawProps.values_.size());
+    rawProps.values_.push_back(RawValue{std::move(value)});
+  };
+
+  switch (rawProps.mode_) {
+    case RawProps::Mode::Empty:
+      return;
+
+    case RawProps::Mode::JSI: {
+      auto &runtime = *rawProps.runtime_;
+      if (!rawProps.value_.isObject()) {
+        return;
+      }
+
+      auto object = rawProps.value_.asObject(runtime);
+      auto names = object.getPropertyNames(runtime);
+      auto count = names.size(runtime);
+
+      // Only values of props which the Props type reads are converted.
+      for (size_t i = 0; i < count; i++) {
+        auto nameValue = names.getValueAtIndex(runtime, i).getString(runtime);
+        auto keyIndex = indexOfName(nameValue.utf8(runtime));
+        if (keyIndex != kRawPropsValueIndexEmpty) {
+          storeValue(
+              keyIndex,
+              jsi::dynamicFromValue(
+                  runtime, object.getProperty(runtime, nameValue)));
+        }
+      }
+      return;
+    }
+
+    case RawProps::Mode::Dynamic: {
+      if (!rawProps.dynamic_.isObject()) {
+        return;
+      }
+
+      for (auto const &pair : rawProps.dynamic_.items()) {
+        auto keyIndex = indexOfName(pair.first.getString());
+        if (keyIndex != kRawPropsValueIndexEmpty) {
+          storeValue(keyIndex, pair.second);
+        }
+      }
+      return;
+    }
+  }
+}
+
+} // namespace react
+} // namespace facebook
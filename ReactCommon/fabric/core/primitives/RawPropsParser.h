@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <react/core/RawProps.h>
+#include <react/core/RawPropsKey.h>
+#include <react/core/RawPropsKeyMap.h>
+#include <react/core/RawValue.h>
+
+namespace facebook {
+namespace react {
+
+/*
+ * Specialized (to a particular type of Props) parser that provides the most
+ * efficient access to `RawProps` content.
+ * The parser knows all props which the Props type reads, in the order in
+ * which it reads them. That allows `RawProps` to convert only those values
+ * (in a single pass over the props object) and to look up every one of them
+ * without hashing strings.
+ */
+class RawPropsParser final {
+ public:
+  /*
+   * Default constructor.
+   * The parser must be prepared before use.
+   */
+  RawPropsParser() = default;
+  RawPropsParser(RawPropsParser &&other) noexcept = default;
+
+  /*
+   * Not copyable.
+   */
+  RawPropsParser(RawPropsParser const &other) noexcept = delete;
+  RawPropsParser &operator=(RawPropsParser const &other) noexcept = delete;
+
+  /*
+   * Records all props which `PropsT` reads by constructing it from empty
+   * `RawProps`.
+   */
+  template <typename PropsT>
+  void prepare() noexcept {
+    RawProps emptyRawProps{};
+    emptyRawProps.parse(*this);
+    PropsT(PropsT(), emptyRawProps);
+    postPrepare();
+  }
+
+ private:
+  friend class RawProps;
+
+  /*
+   * To be used by `RawProps` only.
+   */
+  void preparse(RawProps const &rawProps) const noexcept;
+
+  /*
+   * To be used by `RawProps` only.
+   */
+  RawValue const *at(RawProps const &rawProps, RawPropsKey const &key) const
+      noexcept;
+
+  void postPrepare() noexcept;
+
+  /*
+   * Returns the index of `key` in `keys_`, or `kRawPropsValueIndexEmpty` if
+   * the props type does not read the prop.
+   */
+  RawPropsValueIndex indexOf(RawPropsKey const &key) const noexcept;
+
+  mutable std::vector<RawPropsKey> keys_{};
+  mutable RawPropsKeyMap nameToIndex_{};
+  mutable bool ready_{false};
+};
+
+} // namespace react
+} // namespace facebook
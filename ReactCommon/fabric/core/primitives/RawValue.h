@@ -16,6 +16,7 @@ namespace facebook {
 namespace react {
 
 class RawProps;
+class RawPropsParser;
 
 /*
  * `RawValue` abstracts some arbitrary complex data structure similar to JSON.
@@ -63,6 +64,7 @@ class RawValue {
 
  private:
   friend RawProps;
+  friend RawPropsParser;
 
   /*
    * Arbitrary constructors are private only for RawProps and internal usage.
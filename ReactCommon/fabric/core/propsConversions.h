@@ -45,13 +45,20 @@ void fromRawValue(const RawValue &rawValue, std::vector<T> &result) {
   result.push_back(itemResult);
 }
 
+/*
+ * Returns the value of the prop with a given name (`namePrefix` + `name` +
+ * `nameSuffix`), `defaultValue` if the prop is `null`, or `sourceValue` if
+ * the prop is absent.
+ */
 template <typename T, typename U = T>
 T convertRawProp(
     const RawProps &rawProps,
-    const std::string &name,
+    char const *name,
     const T &sourceValue,
-    const U &defaultValue = U()) {
-  const auto rawValue = rawProps.at(name);
+    const U &defaultValue = U(),
+    char const *namePrefix = nullptr,
+    char const *nameSuffix = nullptr) {
+  const auto rawValue = rawProps.at(name, namePrefix, nameSuffix);
 
   if (!rawValue) {
     return sourceValue;
@@ -71,10 +78,12 @@ T convertRawProp(
 template <typename T>
 static folly::Optional<T> convertRawProp(
     const RawProps &rawProps,
-    const std::string &name,
+    char const *name,
     const folly::Optional<T> &sourceValue,
-    const folly::Optional<T> &defaultValue = {}) {
-  const auto rawValue = rawProps.at(name);
+    const folly::Optional<T> &defaultValue = {},
+    char const *namePrefix = nullptr,
+    char const *nameSuffix = nullptr) {
+  const auto rawValue = rawProps.at(name, namePrefix, nameSuffix);
 
   if (!rawValue) {
     return sourceValue;
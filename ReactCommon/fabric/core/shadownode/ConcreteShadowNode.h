@@ -9,6 +9,7 @@
 
 #include <react/core/ConcreteState.h>
 #include <react/core/Props.h>
+#include <react/core/RawPropsParser.h>
 #include <react/core/ShadowNode.h>
 #include <react/core/StateData.h>
 
@@ -53,12 +54,26 @@ class ConcreteShadowNode : public ShadowNode {
   static SharedConcreteProps Props(
       const RawProps &rawProps,
       const SharedProps &baseProps = nullptr) {
+    rawProps.parse(rawPropsParser());
     return std::make_shared<const PropsT>(
         baseProps ? *std::static_pointer_cast<const PropsT>(baseProps)
                   : PropsT(),
         rawProps);
   }
 
+  /*
+   * Returns the parser which knows all props which `PropsT` reads.
+   * It's prepared once, on first use.
+   */
+  static RawPropsParser const &rawPropsParser() {
+    static auto const rawPropsParser = [] {
+      auto rawPropsParser = RawPropsParser{};
+      rawPropsParser.prepare<PropsT>();
+      return rawPropsParser;
+    }();
+    return rawPropsParser;
+  }
+
   static SharedConcreteProps defaultSharedProps() {
     static const SharedConcreteProps defaultSharedProps =
         std::make_shared<const PropsT>();
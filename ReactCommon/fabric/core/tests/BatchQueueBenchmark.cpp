@@ -0,0 +1,172 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <react/core/BatchQueue.h>
+
+using namespace facebook::react;
+
+namespace {
+
+struct Item {
+  int producer;
+  int index;
+};
+
+/*
+ * The queue the `EventQueue` used before, for comparison.
+ */
+class MutexQueue {
+ public:
+  void push(Item item) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    items_.push_back(item);
+  }
+
+  std::vector<Item> popAll() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto items = std::move(items_);
+    items_.clear();
+    return items;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<Item> items_;
+};
+
+struct StreamReport {
+  int itemCount{0};
+  int flushCount{0};
+  std::chrono::nanoseconds medianPushDuration{};
+  std::chrono::nanoseconds maxPushDuration{};
+};
+
+/*
+ * Simulates `producerCount` streams of scroll events (several touch samples
+ * per frame of a 120 Hz display) pushed on producer threads while a consumer
+ * thread keeps flushing, as the JavaScript thread does. Time is compressed
+ * tenfold to keep the test short; the consumer flushes without pauses to
+ * maximize contention.
+ */
+template <typename Queue>
+StreamReport simulateScrollStreams(
+    Queue &queue,
+    int producerCount,
+    int frameCount) {
+  auto const eventsPerFrame = 4;
+  std::atomic<bool> done{false};
+  auto report = StreamReport{};
+  auto consumed = std::vector<std::vector<int>>(producerCount);
+
+  auto consumer = std::thread([&]() {
+    auto flush = [&]() {
+      auto items = queue.popAll();
+      if (items.empty()) {
+        return;
+      }
+      report.flushCount++;
+      for (auto const &item : items) {
+        consumed[item.producer].push_back(item.index);
+      }
+    };
+    while (!done) {
+      flush();
+    }
+    flush();
+  });
+
+  auto pushDurations = std::vector<std::vector<std::chrono::nanoseconds>>(
+      producerCount,
+      std::vector<std::chrono::nanoseconds>(frameCount * eventsPerFrame));
+  auto producers = std::vector<std::thread>{};
+  for (int producer = 0; producer < producerCount; producer++) {
+    producers.emplace_back([&, producer]() {
+      auto const frameDuration = std::chrono::microseconds(1000000 / 120 / 10);
+      auto frameStart = std::chrono::steady_clock::now();
+      auto index = 0;
+      for (int frame = 0; frame < frameCount; frame++) {
+        for (int event = 0; event < eventsPerFrame; event++, index++) {
+          auto start = std::chrono::steady_clock::now();
+          queue.push(Item{producer, index});
+          pushDurations[producer][index] =
+              std::chrono::steady_clock::now() - start;
+        }
+        frameStart += frameDuration;
+        std::this_thread::sleep_until(frameStart);
+      }
+    });
+  }
+
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  done = true;
+  consumer.join();
+
+  auto allDurations = std::vector<std::chrono::nanoseconds>{};
+  for (int producer = 0; producer < producerCount; producer++) {
+    // Every event arrives exactly once and in order within its stream.
+    auto const &indices = consumed[producer];
+    EXPECT_EQ(indices.size(), frameCount * eventsPerFrame);
+    EXPECT_TRUE(std::is_sorted(indices.begin(), indices.end()));
+
+    report.itemCount += indices.size();
+    allDurations.insert(
+        allDurations.end(),
+        pushDurations[producer].begin(),
+        pushDurations[producer].end());
+  }
+
+  std::sort(allDurations.begin(), allDurations.end());
+  report.medianPushDuration = allDurations[allDurations.size() / 2];
+  report.maxPushDuration = allDurations.back();
+  return report;
+}
+
+} // namespace
+
+/*
+ * Reports the time a producer (the UI thread) spends enqueueing events while
+ * the consumer (the JavaScript thread) flushes concurrently.
+ * Kept apart from BatchQueueTest, which checks the ordering guarantees; run
+ * with `--gtest_filter=BatchQueueBenchmark.*` to see the numbers.
+ */
+TEST(BatchQueueBenchmark, scrollEventStreams) {
+  // Two simultaneous scroll streams, ten seconds of 120 Hz frames each (one
+  // second of real time).
+  auto const producerCount = 2;
+  auto const frameCount = 1200;
+
+  auto print = [&](const char *name, StreamReport const &report) {
+    std::cout << name << ": " << report.itemCount << " events in "
+              << report.flushCount << " flushes, median push "
+              << report.medianPushDuration.count() << " ns, max push "
+              << report.maxPushDuration.count() << " ns" << std::endl;
+    RecordProperty(
+        std::string(name) + "MaxPushNanoseconds",
+        std::to_string(report.maxPushDuration.count()));
+  };
+
+  BatchQueue<Item> batchQueue;
+  print(
+      "BatchQueue",
+      simulateScrollStreams(batchQueue, producerCount, frameCount));
+
+  MutexQueue mutexQueue;
+  print(
+      "MutexQueue",
+      simulateScrollStreams(mutexQueue, producerCount, frameCount));
+}
@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <react/core/BatchQueue.h>
+
+using namespace facebook::react;
+
+namespace {
+
+struct Item {
+  int producer;
+  int index;
+};
+
+} // namespace
+
+TEST(BatchQueueTest, popAllReturnsValuesInOrder) {
+  BatchQueue<int> queue;
+  EXPECT_TRUE(queue.empty());
+  EXPECT_TRUE(queue.popAll().empty());
+
+  queue.push(1);
+  queue.push(2);
+  queue.push(3);
+  EXPECT_FALSE(queue.empty());
+  EXPECT_EQ(queue.popAll(), (std::vector<int>{1, 2, 3}));
+  EXPECT_TRUE(queue.empty());
+
+  queue.push(4);
+  EXPECT_EQ(queue.popAll(), (std::vector<int>{4}));
+}
+
+TEST(BatchQueueTest, destructorReleasesValues) {
+  auto value = std::make_shared<int>(42);
+  {
+    BatchQueue<std::shared_ptr<int>> queue;
+    queue.push(value);
+    queue.push(value);
+    EXPECT_EQ(value.use_count(), 3);
+  }
+  EXPECT_EQ(value.use_count(), 1);
+}
+
+/*
+ * Several producers push while a consumer keeps draining the queue, as the
+ * UI thread enqueues events while the JavaScript thread flushes them.
+ */
+TEST(BatchQueueTest, concurrentProducersAndConsumer) {
+  auto const producerCount = 4;
+  auto const itemCount = 10000;
+
+  BatchQueue<Item> queue;
+  std::atomic<bool> done{false};
+  auto consumed = std::vector<std::vector<int>>(producerCount);
+
+  auto consumer = std::thread([&]() {
+    auto drain = [&]() {
+      for (auto const &item : queue.popAll()) {
+        consumed[item.producer].push_back(item.index);
+      }
+    };
+    while (!done) {
+      drain();
+    }
+    drain();
+  });
+
+  auto producers = std::vector<std::thread>{};
+  for (int producer = 0; producer < producerCount; producer++) {
+    producers.emplace_back([&, producer]() {
+      for (int index = 0; index < itemCount; index++) {
+        queue.push(Item{producer, index});
+      }
+    });
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  done = true;
+  consumer.join();
+
+  // Every item arrives exactly once and in order within its producer.
+  for (auto const &indices : consumed) {
+    ASSERT_EQ(indices.size(), itemCount);
+    for (int index = 0; index < itemCount; index++) {
+      EXPECT_EQ(indices[index], index);
+    }
+  }
+  EXPECT_TRUE(queue.empty());
+}
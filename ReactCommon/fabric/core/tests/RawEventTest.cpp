@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <react/core/EventTarget.h>
+#include <react/core/RawEvent.h>
+
+using namespace facebook::react;
+
+namespace {
+
+RawEvent makeEvent(
+    std::string type,
+    SharedEventTarget const &eventTarget,
+    RawEvent::Category category) {
+  return RawEvent(
+      std::move(type),
+      [](facebook::jsi::Runtime &runtime) {
+        return facebook::jsi::Value::undefined();
+      },
+      eventTarget,
+      category);
+}
+
+// Returns indices of the events kept by `coalesceRawEvents`.
+std::vector<size_t> coalescedIndices(std::vector<RawEvent> const &rawEvents) {
+  auto indices = std::vector<size_t>{};
+  for (auto rawEvent : coalesceRawEvents(rawEvents)) {
+    indices.push_back(rawEvent - rawEvents.data());
+  }
+  return indices;
+}
+
+auto const Discrete = RawEvent::Category::Discrete;
+auto const Continuous = RawEvent::Category::Continuous;
+
+} // namespace
+
+TEST(RawEventTest, discreteEventsAreNeverCoalesced) {
+  auto rawEvents = std::vector<RawEvent>{};
+  rawEvents.push_back(makeEvent("press", nullptr, Discrete));
+  rawEvents.push_back(makeEvent("press", nullptr, Discrete));
+  rawEvents.push_back(makeEvent("press", nullptr, Discrete));
+
+  EXPECT_EQ(coalescedIndices(rawEvents), (std::vector<size_t>{0, 1, 2}));
+}
+
+TEST(RawEventTest, continuousEventsKeepTheLatestPerTypeAndTarget) {
+  // Event targets are only compared, so any distinct pointers will do.
+  auto storage = std::vector<int>(2);
+  auto first = SharedEventTarget(
+      std::shared_ptr<void>{}, reinterpret_cast<EventTarget *>(&storage[0]));
+  auto second = SharedEventTarget(
+      std::shared_ptr<void>{}, reinterpret_cast<EventTarget *>(&storage[1]));
+
+  auto rawEvents = std::vector<RawEvent>{};
+  rawEvents.push_back(makeEvent("scroll", first, Continuous));
+  rawEvents.push_back(makeEvent("scroll", second, Continuous));
+  rawEvents.push_back(makeEvent("touchMove", first, Continuous));
+  rawEvents.push_back(makeEvent("scroll", first, Continuous));
+  rawEvents.push_back(makeEvent("scroll", second, Continuous));
+
+  EXPECT_EQ(coalescedIndices(rawEvents), (std::vector<size_t>{2, 3, 4}));
+}
+
+TEST(RawEventTest, discreteEventsSeparateContinuousEvents) {
+  auto rawEvents = std::vector<RawEvent>{};
+  rawEvents.push_back(makeEvent("scroll", nullptr, Continuous));
+  rawEvents.push_back(makeEvent("scroll", nullptr, Continuous));
+  rawEvents.push_back(makeEvent("scrollEndDrag", nullptr, Discrete));
+  rawEvents.push_back(makeEvent("scroll", nullptr, Continuous));
+  rawEvents.push_back(makeEvent("scroll", nullptr, Continuous));
+
+  // The scroll position at the end of dragging is still delivered before the
+  // `scrollEndDrag` event.
+  EXPECT_EQ(coalescedIndices(rawEvents), (std::vector<size_t>{1, 2, 4}));
+}
+
+TEST(RawEventTest, everyEventTargetIsRetainedOncePerBatch) {
+  auto storage = std::vector<int>(2);
+  auto first = SharedEventTarget(
+      std::shared_ptr<void>{}, reinterpret_cast<EventTarget *>(&storage[0]));
+  auto second = SharedEventTarget(
+      std::shared_ptr<void>{}, reinterpret_cast<EventTarget *>(&storage[1]));
+
+  auto rawEvents = std::vector<RawEvent>{};
+  rawEvents.push_back(makeEvent("press", first, Discrete));
+  rawEvents.push_back(makeEvent("press", first, Discrete));
+  rawEvents.push_back(makeEvent("press", nullptr, Discrete));
+  rawEvents.push_back(makeEvent("press", second, Discrete));
+  rawEvents.push_back(makeEvent("press", first, Discrete));
+  rawEvents.push_back(makeEvent("press", second, Discrete));
+
+  auto events = std::vector<RawEvent const *>{};
+  for (auto const &rawEvent : rawEvents) {
+    events.push_back(&rawEvent);
+  }
+  auto eventTargets = uniqueEventTargets(events);
+  std::sort(eventTargets.begin(), eventTargets.end());
+
+  auto expectedEventTargets =
+      std::vector<EventTarget const *>{first.get(), second.get()};
+  std::sort(expectedEventTargets.begin(), expectedEventTargets.end());
+  EXPECT_EQ(eventTargets, expectedEventTargets);
+
+  EXPECT_TRUE(uniqueEventTargets({}).empty());
+}
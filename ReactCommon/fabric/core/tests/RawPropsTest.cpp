@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <react/core/RawProps.h>
+#include <react/core/RawPropsParser.h>
+#include <react/core/propsConversions.h>
+
+using namespace facebook::react;
+
+class PropsOfSomeType {
+ public:
+  PropsOfSomeType() = default;
+  PropsOfSomeType(PropsOfSomeType const &sourceProps, RawProps const &rawProps)
+      : intValue(
+            convertRawProp(rawProps, "intValue", sourceProps.intValue, 0)),
+        marginLeft(convertRawProp(
+            rawProps,
+            "Left",
+            sourceProps.marginLeft,
+            0.0,
+            "margin",
+            "")),
+        stringValue(convertRawProp(
+            rawProps,
+            "stringValue",
+            sourceProps.stringValue,
+            std::string{"default"})) {}
+
+  int intValue{1};
+  double marginLeft{1};
+  std::string stringValue{"initial"};
+};
+
+// Doesn't fit into `kPropNameLengthHardCap` bytes.
+static char const *const kLongName =
+    "aPropWithAVeryLongNameWhichIsLongerThanTheHardCapOfSixtyFourCharacters";
+
+class PropsWithLongNames {
+ public:
+  PropsWithLongNames() = default;
+  PropsWithLongNames(
+      PropsWithLongNames const &sourceProps,
+      RawProps const &rawProps)
+      : intValue(
+            convertRawProp(rawProps, "intValue", sourceProps.intValue, 0)),
+        longValue(convertRawProp(
+            rawProps,
+            kLongName,
+            sourceProps.longValue,
+            std::string{"default"})),
+        longPrefixedValue(convertRawProp(
+            rawProps,
+            "Value",
+            sourceProps.longPrefixedValue,
+            0,
+            kLongName,
+            "Suffix")) {}
+
+  int intValue{1};
+  std::string longValue{"initial"};
+  int longPrefixedValue{1};
+};
+
+TEST(RawPropsTest, parsesOnlyKnownProps) {
+  auto parser = RawPropsParser{};
+  parser.prepare<PropsOfSomeType>();
+
+  RawProps rawProps{folly::dynamic::object("intValue", 42)("marginLeft", 2.5)(
+      "unknownValue", "ignored")};
+  rawProps.parse(parser);
+
+  auto props = PropsOfSomeType(PropsOfSomeType(), rawProps);
+  EXPECT_EQ(props.intValue, 42);
+  EXPECT_EQ(props.marginLeft, 2.5);
+  // Absent props keep source values.
+  EXPECT_EQ(props.stringValue, "initial");
+
+  // Props can be read in any order, and by a name that is split differently.
+  EXPECT_EQ((double)*rawProps.at("marginLeft"), 2.5);
+  EXPECT_EQ((int)*rawProps.at("Value", "int"), 42);
+  EXPECT_EQ(rawProps.at("stringValue"), nullptr);
+
+  // The prop was not read during the preparation, but it's still available.
+  EXPECT_EQ((std::string)*rawProps.at("unknownValue"), "ignored");
+  EXPECT_EQ(rawProps.at("missingValue"), nullptr);
+}
+
+TEST(RawPropsTest, nullResetsPropsToDefaults) {
+  auto parser = RawPropsParser{};
+  parser.prepare<PropsOfSomeType>();
+
+  RawProps rawProps{folly::dynamic::object("stringValue", nullptr)};
+  rawProps.parse(parser);
+
+  auto sourceProps = PropsOfSomeType{};
+  sourceProps.stringValue = "source";
+  auto props = PropsOfSomeType(sourceProps, rawProps);
+  EXPECT_EQ(props.stringValue, "default");
+  EXPECT_EQ(props.intValue, 1);
+}
+
+TEST(RawPropsTest, parsedAndUnparsedPropsAreEqual) {
+  auto parser = RawPropsParser{};
+  parser.prepare<PropsOfSomeType>();
+
+  folly::dynamic dynamic =
+      folly::dynamic::object("intValue", 7)("marginLeft", 3)(
+          "stringValue", "value");
+  RawProps parsedRawProps{dynamic};
+  parsedRawProps.parse(parser);
+  RawProps unparsedRawProps{dynamic};
+
+  // The same object can be read many times.
+  for (int i = 0; i < 2; i++) {
+    auto parsedProps = PropsOfSomeType(PropsOfSomeType(), parsedRawProps);
+    auto unparsedProps = PropsOfSomeType(PropsOfSomeType(), unparsedRawProps);
+    EXPECT_EQ(parsedProps.intValue, unparsedProps.intValue);
+    EXPECT_EQ(parsedProps.marginLeft, unparsedProps.marginLeft);
+    EXPECT_EQ(parsedProps.stringValue, unparsedProps.stringValue);
+    EXPECT_EQ(parsedProps.stringValue, "value");
+  }
+}
+
+TEST(RawPropsTest, emptyRawProps) {
+  auto parser = RawPropsParser{};
+  parser.prepare<PropsOfSomeType>();
+
+  RawProps rawProps{};
+  rawProps.parse(parser);
+  EXPECT_EQ(rawProps.at("intValue"), nullptr);
+  EXPECT_EQ(rawProps.at("unknownValue"), nullptr);
+}
+
+TEST(RawPropsTest, propsWithLongNamesAreReadUnparsed) {
+  auto parser = RawPropsParser{};
+  parser.prepare<PropsWithLongNames>();
+
+  auto const longPrefixedName = std::string{kLongName} + "ValueSuffix";
+  folly::dynamic dynamic = folly::dynamic::object("intValue", 7)(
+      kLongName, "long")(longPrefixedName, 8);
+  RawProps rawProps{dynamic};
+  rawProps.parse(parser);
+
+  auto props = PropsWithLongNames(PropsWithLongNames(), rawProps);
+  EXPECT_EQ(props.intValue, 7);
+  EXPECT_EQ(props.longValue, "long");
+  EXPECT_EQ(props.longPrefixedValue, 8);
+
+  EXPECT_EQ((std::string)*rawProps.at(kLongName), "long");
+}
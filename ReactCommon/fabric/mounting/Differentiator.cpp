@@ -5,10 +5,13 @@
 
 #include "Differentiator.h"
 
+#include <algorithm>
+
 #include <better/map.h>
 #include <better/small_vector.h>
 #include <react/core/LayoutableShadowNode.h>
 #include <react/debug/SystraceSection.h>
+#include "MonotonicBuffer.h"
 #include "ShadowView.h"
 
 namespace facebook {
@@ -115,14 +118,132 @@ static ShadowViewNodePair::List sliceChildShadowNodeViewPairs(
   return pairList;
 }
 
+ShadowViewNodePair::List const &ShadowViewNodePairCache::getOldChildPairs(
+    ShadowNode const &shadowNode) {
+  return getChildPairs(oldEntries_, shadowNode);
+}
+
+ShadowViewNodePair::List const &ShadowViewNodePairCache::getNewChildPairs(
+    ShadowNode const &shadowNode) {
+  return getChildPairs(newEntries_, shadowNode);
+}
+
+ShadowViewNodePair::List const &ShadowViewNodePairCache::getChildPairs(
+    Entries &entries,
+    ShadowNode const &shadowNode) {
+  auto it = entries.find(&shadowNode);
+  if (it == entries.end()) {
+    // The entry retains the node, so the pointer used as a key can't be
+    // reused by another node while the entry exists.
+    it = entries
+             .emplace(
+                 &shadowNode,
+                 Entry{shadowNode.shared_from_this(),
+                       sliceChildShadowNodeViewPairs(shadowNode)})
+             .first;
+  }
+  return it->second.childPairs;
+}
+
+void ShadowViewNodePairCache::commit() {
+  oldEntries_ = std::move(newEntries_);
+  newEntries_ = Entries{};
+}
+
+/*
+ * Children lists up to this size are matched by tag using `TinyMap`, larger
+ * ones use a hash map instead: a linear lookup for every old child turns
+ * the matching into a quadratic one on long lists.
+ */
+static constexpr int kTinyMapMaximumSize = 16;
+
+/*
+ * For every old child starting from `fromIndex`, finds the index of the node
+ * with the same tag in `newChildPairs` (or -1 if there is none) and stores it
+ * in `newIndices`. For every new child starting from `fromIndex`, stores
+ * the index of the matching old child (or -1) in `oldIndices`.
+ * Both lists of indices are relative to `fromIndex`.
+ */
+template <typename MapT>
+static void matchChildPairsByTag(
+    MapT &newIndicesByTag,
+    ShadowViewNodePair::List const &oldChildPairs,
+    ShadowViewNodePair::List const &newChildPairs,
+    int fromIndex,
+    better::small_vector<int, kTinyMapMaximumSize> &newIndices,
+    better::small_vector<int, kTinyMapMaximumSize> &oldIndices) {
+  for (int index = fromIndex; index < newChildPairs.size(); index++) {
+    newIndicesByTag.insert(
+        {newChildPairs[index].shadowView.tag, index - fromIndex});
+  }
+
+  for (int index = fromIndex; index < oldChildPairs.size(); index++) {
+    auto const it =
+        newIndicesByTag.find(oldChildPairs[index].shadowView.tag);
+    if (it != newIndicesByTag.end()) {
+      newIndices[index - fromIndex] = it->second;
+      oldIndices[it->second] = index - fromIndex;
+    }
+  }
+}
+
+/*
+ * Marks the old children that can stay where they are: the longest
+ * subsequence of old children whose new indices are increasing. All other
+ * matched old children have to be moved (removed and inserted again).
+ * Runs in O(n log n).
+ */
+static void markChildPairsToKeep(
+    better::small_vector<int, kTinyMapMaximumSize> const &newIndices,
+    better::small_vector<bool, kTinyMapMaximumSize> &isKept) {
+  // `tails[length - 1]` is the position (in `newIndices`) of the smallest
+  // tail of all found increasing subsequences of the given length.
+  auto tails = better::small_vector<int, kTinyMapMaximumSize>{};
+  auto predecessors =
+      better::small_vector<int, kTinyMapMaximumSize>(newIndices.size(), -1);
+
+  for (int position = 0; position < newIndices.size(); position++) {
+    auto const newIndex = newIndices[position];
+    if (newIndex == -1) {
+      continue;
+    }
+
+    auto const it = std::lower_bound(
+        tails.begin(), tails.end(), newIndex, [&](int tail, int value) {
+          return newIndices[tail] < value;
+        });
+
+    if (it != tails.begin()) {
+      predecessors[position] = *(it - 1);
+    }
+
+    if (it == tails.end()) {
+      tails.push_back(position);
+    } else {
+      *it = position;
+    }
+  }
+
+  for (int position = tails.empty() ? -1 : tails.back(); position != -1;
+       position = predecessors[position]) {
+    isKept[position] = true;
+  }
+}
+
+/*
+ * Mutations staged by the algorithm before they are moved to the resulting
+ * list; their storage comes from the diff's `MonotonicBuffer`.
+ */
+using StagedMutationList =
+    std::vector<ShadowViewMutation, MonotonicAllocator<ShadowViewMutation>>;
+
 static void calculateShadowViewMutations(
-    ShadowViewMutation::List &mutations,
+    StagedMutationList &mutations,
+    ShadowViewNodePairCache &cache,
+    MonotonicBuffer &buffer,
     ShadowView const &parentShadowView,
     ShadowViewNodePair::List const &oldChildPairs,
     ShadowViewNodePair::List const &newChildPairs) {
-  // The current version of the algorithm is otimized for simplicity,
-  // not for performance or optimal result.
-
   if (oldChildPairs == newChildPairs) {
     return;
   }
@@ -133,26 +254,24 @@ static void calculateShadowViewMutations(
 
   auto index = int{0};
 
-  // Maps inserted node tags to pointers to them in `newChildPairs`.
-  auto insertedPairs = TinyMap<Tag, ShadowViewNodePair const *>{};
-
   // Lists of mutations
-  auto createMutations = ShadowViewMutation::List{};
-  auto deleteMutations = ShadowViewMutation::List{};
-  auto insertMutations = ShadowViewMutation::List{};
-  auto removeMutations = ShadowViewMutation::List{};
-  auto updateMutations = ShadowViewMutation::List{};
-  auto downwardMutations = ShadowViewMutation::List{};
-  auto destructiveDownwardMutations = ShadowViewMutation::List{};
-
-  // Stage 1: Collecting `Update` mutations
+  auto const allocator = MonotonicAllocator<ShadowViewMutation>(buffer);
+  auto createMutations = StagedMutationList(allocator);
+  auto deleteMutations = StagedMutationList(allocator);
+  auto insertMutations = StagedMutationList(allocator);
+  auto removeMutations = StagedMutationList(allocator);
+  auto updateMutations = StagedMutationList(allocator);
+  auto downwardMutations = StagedMutationList(allocator);
+  auto destructiveDownwardMutations = StagedMutationList(allocator);
+
+  // Stage 1: Collecting `Update` mutations for the common prefix
   for (index = 0; index < oldChildPairs.size() && index < newChildPairs.size();
        index++) {
     auto const &oldChildPair = oldChildPairs[index];
     auto const &newChildPair = newChildPairs[index];
 
     if (oldChildPair.shadowView.tag != newChildPair.shadowView.tag) {
-      // Totally different nodes, updating is impossible.
+      // The order of children differs from here on.
       break;
     }
 
@@ -164,13 +283,21 @@ static void calculateShadowViewMutations(
           index));
     }
 
-    auto const oldGrandChildPairs =
-        sliceChildShadowNodeViewPairs(*oldChildPair.shadowNode);
-    auto const newGrandChildPairs =
-        sliceChildShadowNodeViewPairs(*newChildPair.shadowNode);
+    if (newChildPair == oldChildPair) {
+      // The subtree was not cloned by the commit, so it's identical and
+      // there is nothing to diff inside.
+      continue;
+    }
+
+    auto const &oldGrandChildPairs =
+        cache.getOldChildPairs(*oldChildPair.shadowNode);
+    auto const &newGrandChildPairs =
+        cache.getNewChildPairs(*newChildPair.shadowNode);
     calculateShadowViewMutations(
         *(newGrandChildPairs.size() ? &downwardMutations
                                     : &destructiveDownwardMutations),
+        cache,
+        buffer,
         oldChildPair.shadowView,
         oldGrandChildPairs,
         newGrandChildPairs);
@@ -178,77 +305,124 @@ static void calculateShadowViewMutations(
 
   int lastIndexAfterFirstStage = index;
 
-  // Stage 2: Collecting `Insert` mutations
-  for (; index < newChildPairs.size(); index++) {
-    auto const &newChildPair = newChildPairs[index];
-
-    insertMutations.push_back(ShadowViewMutation::InsertMutation(
-          parentShadowView, newChildPair.shadowView, index));
-
-    insertedPairs.insert({newChildPair.shadowView.tag, &newChildPair});
+  // Stage 2: Matching the rest of the old and new children by tag
+  auto const oldRemainingCount =
+      int(oldChildPairs.size()) - lastIndexAfterFirstStage;
+  auto const newRemainingCount =
+      int(newChildPairs.size()) - lastIndexAfterFirstStage;
+
+  // `newIndices[i]` is the (relative) new index of the i-th remaining old
+  // child, `oldIndices[j]` is the (relative) old index of the j-th remaining
+  // new child; -1 means that there is no counterpart.
+  auto newIndices =
+      better::small_vector<int, kTinyMapMaximumSize>(oldRemainingCount, -1);
+  auto oldIndices =
+      better::small_vector<int, kTinyMapMaximumSize>(newRemainingCount, -1);
+
+  if (newRemainingCount <= kTinyMapMaximumSize) {
+    auto newIndicesByTag = TinyMap<Tag, int, kTinyMapMaximumSize>{};
+    matchChildPairsByTag(
+        newIndicesByTag,
+        oldChildPairs,
+        newChildPairs,
+        lastIndexAfterFirstStage,
+        newIndices,
+        oldIndices);
+  } else {
+    auto newIndicesByTag = better::map<Tag, int>{};
+    newIndicesByTag.reserve(newRemainingCount);
+    matchChildPairsByTag(
+        newIndicesByTag,
+        oldChildPairs,
+        newChildPairs,
+        lastIndexAfterFirstStage,
+        newIndices,
+        oldIndices);
   }
 
-  // Stage 3: Collecting `Delete` and `Remove` mutations
+  // Stage 3: Choosing the children that stay in place
+  auto isKept =
+      better::small_vector<bool, kTinyMapMaximumSize>(oldRemainingCount, false);
+  markChildPairsToKeep(newIndices, isKept);
+
+  // Stage 4: Collecting `Delete`, `Remove` and `Update` mutations
   for (index = lastIndexAfterFirstStage; index < oldChildPairs.size();
        index++) {
     auto const &oldChildPair = oldChildPairs[index];
-
-    // Even if the old view was (re)inserted, we have to generate `remove`
-    // mutation.
-    removeMutations.push_back(ShadowViewMutation::RemoveMutation(
-        parentShadowView, oldChildPair.shadowView, index));
-
-    auto const it = insertedPairs.find(oldChildPair.shadowView.tag);
-
-    if (it == insertedPairs.end()) {
-      // The old view was *not* (re)inserted.
-      // We have to generate `delete` mutation and apply the algorithm
-      // recursively.
+    auto const newIndex = newIndices[index - lastIndexAfterFirstStage];
+
+    if (newIndex == -1) {
+      // The old view does not exist anymore.
+      // We have to generate `remove` and `delete` mutations and call the
+      // algorithm recursively to clean up the entire subtree starting from
+      // the removed view.
+      removeMutations.push_back(ShadowViewMutation::RemoveMutation(
+          parentShadowView, oldChildPair.shadowView, index));
       deleteMutations.push_back(
           ShadowViewMutation::DeleteMutation(oldChildPair.shadowView));
-
-      // We also have to call the algorithm recursively to clean up the entire
-      // subtree starting from the removed view.
       calculateShadowViewMutations(
           destructiveDownwardMutations,
+          cache,
+          buffer,
           oldChildPair.shadowView,
-          sliceChildShadowNodeViewPairs(*oldChildPair.shadowNode),
+          cache.getOldChildPairs(*oldChildPair.shadowNode),
           {});
-    } else {
-      // The old view *was* (re)inserted.
-      // We have to call the algorithm recursively if the inserted view
-      // is *not* the same as removed one.
-      auto const &newChildPair = *it->second;
-
-      if (newChildPair != oldChildPair) {
-        auto const oldGrandChildPairs =
-            sliceChildShadowNodeViewPairs(*oldChildPair.shadowNode);
-        auto const newGrandChildPairs =
-            sliceChildShadowNodeViewPairs(*newChildPair.shadowNode);
-        calculateShadowViewMutations(
-            *(newGrandChildPairs.size() ? &downwardMutations
-                                        : &destructiveDownwardMutations),
-            newChildPair.shadowView,
-            oldGrandChildPairs,
-            newGrandChildPairs);
-      }
+      continue;
+    }
+
+    auto const &newChildPair =
+        newChildPairs[lastIndexAfterFirstStage + newIndex];
+    auto const isMoved = !isKept[index - lastIndexAfterFirstStage];
+
+    if (isMoved) {
+      // The view is moved: it's removed here and (re)inserted in Stage 5.
+      removeMutations.push_back(ShadowViewMutation::RemoveMutation(
+          parentShadowView, oldChildPair.shadowView, index));
+    }
+
+    if (oldChildPair.shadowView != newChildPair.shadowView) {
+      updateMutations.push_back(ShadowViewMutation::UpdateMutation(
+          parentShadowView,
+          oldChildPair.shadowView,
+          newChildPair.shadowView,
+          index));
+    }
 
-      // In any case we have to remove the view from `insertedPairs` as
-      // indication that the view was actually removed (which means that
-      // the view existed before), hence we don't have to generate
-      // `create` mutation.
-      insertedPairs.erase(it);
+    if (newChildPair == oldChildPair) {
+      // Same as in Stage 1, the subtree is shared by both trees.
+      continue;
     }
+
+    auto const &oldGrandChildPairs =
+        cache.getOldChildPairs(*oldChildPair.shadowNode);
+    auto const &newGrandChildPairs =
+        cache.getNewChildPairs(*newChildPair.shadowNode);
+    calculateShadowViewMutations(
+        *(newGrandChildPairs.size() ? &downwardMutations
+                                    : &destructiveDownwardMutations),
+        cache,
+        buffer,
+        isMoved ? newChildPair.shadowView : oldChildPair.shadowView,
+        oldGrandChildPairs,
+        newGrandChildPairs);
   }
 
-  // Stage 4: Collecting `Create` mutations
+  // Stage 5: Collecting `Create` and `Insert` mutations
   for (index = lastIndexAfterFirstStage; index < newChildPairs.size();
        index++) {
     auto const &newChildPair = newChildPairs[index];
+    auto const oldIndex = oldIndices[index - lastIndexAfterFirstStage];
 
-    if (insertedPairs.find(newChildPair.shadowView.tag) ==
-        insertedPairs.end()) {
-      // The new view was (re)inserted, so there is no need to create it.
+    if (oldIndex != -1 && isKept[oldIndex]) {
+      // The view stays in place.
+      continue;
+    }
+
+    insertMutations.push_back(ShadowViewMutation::InsertMutation(
+        parentShadowView, newChildPair.shadowView, index));
+
+    if (oldIndex != -1) {
+      // The view was moved, so there is no need to create it.
       continue;
     }
 
@@ -257,9 +431,11 @@ static void calculateShadowViewMutations(
 
     calculateShadowViewMutations(
         downwardMutations,
+        cache,
+        buffer,
         newChildPair.shadowView,
         {},
-        sliceChildShadowNodeViewPairs(*newChildPair.shadowNode));
+        cache.getNewChildPairs(*newChildPair.shadowNode));
   }
 
   // All mutations in an optimal order:
@@ -295,28 +471,53 @@ static void calculateShadowViewMutations(
 
 ShadowViewMutation::List calculateShadowViewMutations(
     ShadowNode const &oldRootShadowNode,
-    ShadowNode const &newRootShadowNode) {
+    ShadowNode const &newRootShadowNode,
+    ShadowViewNodePairCache *cache,
+    MonotonicBuffer *buffer) {
   SystraceSection s("calculateShadowViewMutations");
 
   // Root shadow nodes must be belong the same family.
   assert(ShadowNode::sameFamily(oldRootShadowNode, newRootShadowNode));
 
-  auto mutations = ShadowViewMutation::List{};
-  mutations.reserve(256);
+  // Without a buffer provided by the caller, staged mutations live only
+  // within this diff. (The buffer does not allocate until it's used.)
+  MonotonicBuffer localBuffer;
+  auto &actualBuffer = buffer ? *buffer : localBuffer;
+
+  auto stagedMutations =
+      StagedMutationList(MonotonicAllocator<ShadowViewMutation>(actualBuffer));
+  stagedMutations.reserve(256);
 
   auto oldRootShadowView = ShadowView(oldRootShadowNode);
   auto newRootShadowView = ShadowView(newRootShadowNode);
 
   if (oldRootShadowView != newRootShadowView) {
-    mutations.push_back(ShadowViewMutation::UpdateMutation(
+    stagedMutations.push_back(ShadowViewMutation::UpdateMutation(
         ShadowView(), oldRootShadowView, newRootShadowView, -1));
   }
 
+  // Without a cache provided by the caller, flattened children are shared
+  // only within this diff.
+  auto localCache = ShadowViewNodePairCache{};
+  auto &actualCache = cache ? *cache : localCache;
+
   calculateShadowViewMutations(
-      mutations,
+      stagedMutations,
+      actualCache,
+      actualBuffer,
       ShadowView(oldRootShadowNode),
-      sliceChildShadowNodeViewPairs(oldRootShadowNode),
-      sliceChildShadowNodeViewPairs(newRootShadowNode));
+      actualCache.getOldChildPairs(oldRootShadowNode),
+      actualCache.getNewChildPairs(newRootShadowNode));
+
+  actualCache.commit();
+
+  // The resulting list outlives the buffer, so it is allocated exactly once.
+  auto mutations = ShadowViewMutation::List{};
+  mutations.reserve(stagedMutations.size());
+  std::move(
+      stagedMutations.begin(),
+      stagedMutations.end(),
+      std::back_inserter(mutations));
 
   return mutations;
 }
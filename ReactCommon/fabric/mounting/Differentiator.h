@@ -5,20 +5,73 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include <react/core/ShadowNode.h>
+#include <react/mounting/MonotonicBuffer.h>
+#include <react/mounting/ShadowView.h>
 #include <react/mounting/ShadowViewMutation.h>
 
 namespace facebook {
 namespace react {
 
+/*
+ * Stores flattened lists of child `ShadowView`s (with layout-only views
+ * sliced out) of the shadow nodes of the most recently diffed new tree.
+ * The next diff, where that tree is the old one, reuses them instead of
+ * flattening the same nodes again. Only nodes which were visited by the
+ * last diff are retained.
+ * The class is not thread-safe.
+ */
+class ShadowViewNodePairCache final {
+ public:
+  /*
+   * Returns flattened children of a node of the old (or new) tree.
+   * The returned reference is valid until `commit()` is called.
+   */
+  ShadowViewNodePair::List const &getOldChildPairs(
+      ShadowNode const &shadowNode);
+  ShadowViewNodePair::List const &getNewChildPairs(
+      ShadowNode const &shadowNode);
+
+  /*
+   * Makes the new tree the old one. Must be called after every diff.
+   */
+  void commit();
+
+ private:
+  struct Entry {
+    ShadowNode::Shared shadowNode;
+    ShadowViewNodePair::List childPairs;
+  };
+
+  // `std::unordered_map` (unlike `better::map`) guarantees that references
+  // to values stay valid after insertions.
+  using Entries = std::unordered_map<ShadowNode const *, Entry>;
+
+  ShadowViewNodePair::List const &getChildPairs(
+      Entries &entries,
+      ShadowNode const &shadowNode);
+
+  Entries oldEntries_;
+  Entries newEntries_;
+};
+
 /*
  * Calculates a list of view mutations which describes how the old
  * `ShadowTree` can be transformed to the new one.
  * The list of mutations might be and might not be optimal.
+ * Subtrees which are shared by both trees are skipped. Pass the same `cache`
+ * for consecutive diffs of the same surface to avoid flattening unchanged
+ * nodes repeatedly.
+ * Intermediate mutation lists are allocated from `buffer` (if provided);
+ * the caller is responsible for resetting it after the call.
  */
 ShadowViewMutationList calculateShadowViewMutations(
     ShadowNode const &oldRootShadowNode,
-    ShadowNode const &newRootShadowNode);
+    ShadowNode const &newRootShadowNode,
+    ShadowViewNodePairCache *cache = nullptr,
+    MonotonicBuffer *buffer = nullptr);
 
 } // namespace react
 } // namespace facebook
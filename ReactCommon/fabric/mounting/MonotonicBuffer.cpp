@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "MonotonicBuffer.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace facebook {
+namespace react {
+
+constexpr size_t MonotonicBuffer::kUnderuseRatio;
+constexpr size_t MonotonicBuffer::kUnderusedResetLimit;
+
+MonotonicBuffer::MonotonicBuffer(size_t initialChunkSize)
+    : initialChunkSize_(initialChunkSize) {}
+
+void *MonotonicBuffer::allocate(size_t size, size_t alignment) {
+  // Chunks come from `new[]`, which aligns them for any fundamental type.
+  assert(alignment <= alignof(std::max_align_t));
+  assert((alignment & (alignment - 1)) == 0);
+
+  auto offset = (offset_ + alignment - 1) & ~(alignment - 1);
+
+  if (chunks_.empty() || offset + size > chunks_.back().size) {
+    addChunk(size);
+    offset = 0;
+  }
+
+  offset_ = offset + size;
+  stats_.allocatedBytes += size;
+  stats_.allocationCount++;
+  return chunks_.back().data.get() + offset;
+}
+
+void MonotonicBuffer::reset() {
+  auto capacity = size_t{0};
+  for (auto const &chunk : chunks_) {
+    capacity += chunk.size;
+  }
+
+  // A peak (e.g. one large diff) shouldn't keep its memory for the lifetime
+  // of the buffer once the usage has dropped for good.
+  auto isUnderused = capacity > initialChunkSize_ &&
+      stats_.allocatedBytes < capacity / kUnderuseRatio;
+  underusedResetCount_ = isUnderused ? underusedResetCount_ + 1 : 0;
+
+  if (underusedResetCount_ >= kUnderusedResetLimit) {
+    chunks_.clear();
+    underusedResetCount_ = 0;
+  } else if (chunks_.size() > 1) {
+    // Replaces all chunks with one which fits everything allocated so far,
+    // so the same workload is served without new chunks next time.
+    chunks_.clear();
+    chunks_.push_back(
+        Chunk{std::unique_ptr<char[]>(new char[capacity]), capacity});
+  }
+
+  offset_ = 0;
+  stats_ = Stats{};
+}
+
+MonotonicBuffer::Stats const &MonotonicBuffer::getStats() const {
+  return stats_;
+}
+
+void MonotonicBuffer::addChunk(size_t minimumSize) {
+  auto size = chunks_.empty() ? initialChunkSize_ : chunks_.back().size * 2;
+  size = std::max(size, minimumSize);
+
+  chunks_.push_back(Chunk{std::unique_ptr<char[]>(new char[size]), size});
+  stats_.chunkAllocationCount++;
+}
+
+} // namespace react
+} // namespace facebook
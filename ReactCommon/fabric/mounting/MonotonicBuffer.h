@@ -0,0 +1,128 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace facebook {
+namespace react {
+
+/*
+ * Arena that hands out memory by bumping a pointer and frees nothing until
+ * `reset()` is called. Meant for short-lived containers which are built and
+ * thrown away together (e.g. mutation lists staged by the differentiator
+ * during one mounting transaction).
+ * After `reset()` the buffer keeps a single chunk which fits everything
+ * allocated before, so building lists of a similar size again does not touch
+ * the system allocator. If most of that chunk stays unused for several resets
+ * in a row (e.g. after a single large transaction), the buffer releases it and
+ * starts over with the initial chunk size.
+ * The class is not thread-safe.
+ */
+class MonotonicBuffer final {
+ public:
+  /*
+   * Memory usage since the last `reset()`.
+   */
+  struct Stats {
+    /*
+     * Number of bytes handed out by the buffer.
+     */
+    size_t allocatedBytes{0};
+
+    /*
+     * Number of allocations served by the buffer.
+     */
+    size_t allocationCount{0};
+
+    /*
+     * Number of chunks the buffer had to request from the system allocator.
+     */
+    size_t chunkAllocationCount{0};
+  };
+
+  explicit MonotonicBuffer(size_t initialChunkSize = 16 * 1024);
+
+  MonotonicBuffer(MonotonicBuffer const &other) = delete;
+  MonotonicBuffer &operator=(MonotonicBuffer const &other) = delete;
+
+  void *allocate(size_t size, size_t alignment);
+
+  /*
+   * Makes all memory available for reuse. Any memory handed out before
+   * becomes invalid.
+   */
+  void reset();
+
+  Stats const &getStats() const;
+
+ private:
+  struct Chunk {
+    std::unique_ptr<char[]> data;
+    size_t size;
+  };
+
+  /*
+   * A reset which used less than `1 / kUnderuseRatio` of the capacity is
+   * underused; the memory is released after `kUnderusedResetLimit` of them
+   * in a row.
+   */
+  static constexpr size_t kUnderuseRatio = 4;
+  static constexpr size_t kUnderusedResetLimit = 8;
+
+  void addChunk(size_t minimumSize);
+
+  size_t const initialChunkSize_;
+  std::vector<Chunk> chunks_;
+  size_t offset_{0};
+  size_t underusedResetCount_{0};
+  Stats stats_;
+};
+
+/*
+ * STL allocator that allocates from a `MonotonicBuffer`. Deallocation is
+ * a no-op; the memory is reclaimed when the buffer is reset.
+ */
+template <typename T>
+class MonotonicAllocator {
+ public:
+  using value_type = T;
+
+  explicit MonotonicAllocator(MonotonicBuffer &buffer) : buffer_(&buffer) {}
+
+  template <typename U>
+  MonotonicAllocator(MonotonicAllocator<U> const &other)
+      : buffer_(other.buffer_) {}
+
+  T *allocate(size_t count) {
+    return static_cast<T *>(buffer_->allocate(count * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *, size_t) {}
+
+  template <typename U>
+  bool operator==(MonotonicAllocator<U> const &rhs) const {
+    return buffer_ == rhs.buffer_;
+  }
+
+  template <typename U>
+  bool operator!=(MonotonicAllocator<U> const &rhs) const {
+    return buffer_ != rhs.buffer_;
+  }
+
+ private:
+  template <typename U>
+  friend class MonotonicAllocator;
+
+  MonotonicBuffer *buffer_;
+};
+
+} // namespace react
+} // namespace facebook
@@ -54,7 +54,15 @@ better::optional<MountingTransaction> MountingCoordinator::pullTransaction()
   number_++;
 
   auto mutations = calculateShadowViewMutations(
-      baseRevision_.getRootShadowNode(), lastRevision_->getRootShadowNode());
+      baseRevision_.getRootShadowNode(),
+      lastRevision_->getRootShadowNode(),
+      &shadowViewNodePairCache_,
+      &mutationBuffer_);
+
+  auto const &mutationBufferStats = mutationBuffer_.getStats();
+  auto mutationStagingBytes = mutationBufferStats.allocatedBytes;
+  auto mutationStagingAllocationCount = mutationBufferStats.allocationCount;
+  mutationBuffer_.reset();
 
 #ifdef RN_SHADOW_TREE_INTROSPECTION
   stubViewTree_.mutate(mutations);
@@ -77,6 +85,8 @@ better::optional<MountingTransaction> MountingCoordinator::pullTransaction()
 #endif
 
   auto telemetry = lastRevision_->getTelemetry();
+  telemetry.didStageMutations(
+      mutationStagingBytes, mutationStagingAllocationCount);
   baseRevision_ = std::move(*lastRevision_);
   lastRevision_.reset();
 
@@ -9,6 +9,8 @@
 
 #include <better/optional.h>
 
+#include <react/mounting/Differentiator.h>
+#include <react/mounting/MonotonicBuffer.h>
 #include <react/mounting/MountingTransaction.h>
 #include <react/mounting/ShadowTreeRevision.h>
 
@@ -71,6 +73,9 @@ class MountingCoordinator final {
   mutable ShadowTreeRevision baseRevision_;
   mutable better::optional<ShadowTreeRevision> lastRevision_{};
   mutable MountingTransaction::Number number_{0};
+  mutable ShadowViewNodePairCache
+      shadowViewNodePairCache_; // Protected by `mutex_`.
+  mutable MonotonicBuffer mutationBuffer_; // Protected by `mutex_`.
 
 #ifdef RN_SHADOW_TREE_INTROSPECTION
   mutable StubViewTree stubViewTree_; // Protected by `mutex_`.
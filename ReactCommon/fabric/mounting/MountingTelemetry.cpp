@@ -38,6 +38,13 @@ void MountingTelemetry::didLayout() {
   layoutEndTime_ -= getTime();
 }
 
+void MountingTelemetry::didStageMutations(
+    size_t allocatedBytes,
+    size_t allocationCount) {
+  mutationStagingBytes_ = allocatedBytes;
+  mutationStagingAllocationCount_ = allocationCount;
+}
+
 int64_t MountingTelemetry::getCommitTime() const {
   assert(commitStartTime_ != kUndefinedTime);
   assert(commitEndTime_ != kUndefinedTime);
@@ -56,5 +63,13 @@ int64_t MountingTelemetry::getCommitStartTime() const {
   return commitStartTime_;
 }
 
+size_t MountingTelemetry::getMutationStagingBytes() const {
+  return mutationStagingBytes_;
+}
+
+size_t MountingTelemetry::getMutationStagingAllocationCount() const {
+  return mutationStagingAllocationCount_;
+}
+
 } // namespace react
 } // namespace facebook
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 
@@ -26,6 +27,7 @@ class MountingTelemetry final {
   void didCommit();
   void willLayout();
   void didLayout();
+  void didStageMutations(size_t allocatedBytes, size_t allocationCount);
 
   /*
    * Reading
@@ -34,6 +36,12 @@ class MountingTelemetry final {
   int64_t getCommitTime() const;
   int64_t getCommitStartTime() const;
 
+  /*
+   * Memory used by the differentiator to stage mutations of the transaction.
+   */
+  size_t getMutationStagingBytes() const;
+  size_t getMutationStagingAllocationCount() const;
+
  private:
   constexpr static int64_t kUndefinedTime = std::numeric_limits<int64_t>::max();
 
@@ -41,6 +49,8 @@ class MountingTelemetry final {
   int64_t commitEndTime_{kUndefinedTime};
   int64_t layoutStartTime_{kUndefinedTime};
   int64_t layoutEndTime_{kUndefinedTime};
+  size_t mutationStagingBytes_{0};
+  size_t mutationStagingAllocationCount_{0};
 };
 
 } // namespace react
@@ -159,8 +159,9 @@ bool ShadowTree::tryCommit(ShadowTreeCommitTransaction transaction) const {
     return false;
   }
 
+  // Most commits only lay out a few subtrees (see relayout boundaries in
+  // `LayoutableShadowNode`), so the list starts empty.
   std::vector<LayoutableShadowNode const *> affectedLayoutableNodes{};
-  affectedLayoutableNodes.reserve(1024);
 
   telemetry.willLayout();
   newRootShadowNode->layout(&affectedLayoutableNodes);
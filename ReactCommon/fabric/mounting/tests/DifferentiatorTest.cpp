@@ -0,0 +1,270 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <react/components/view/ViewComponentDescriptor.h>
+#include <react/core/ShadowNodeFragment.h>
+#include <react/mounting/Differentiator.h>
+#include <react/mounting/stubs.h>
+
+using namespace facebook::react;
+
+class DifferentiatorTest : public ::testing::Test {
+ protected:
+  static constexpr Tag kRootTag = 1;
+
+  /*
+   * Returns a view with the given tag. Views are cached, so the same tag
+   * always maps to the same (unchanged) node, as it happens when React
+   * reorders children without touching them.
+   */
+  ShadowNode::Shared view(Tag tag) {
+    auto &shadowNode = views_[tag];
+    if (!shadowNode) {
+      shadowNode = std::make_shared<ViewShadowNode>(
+          ShadowNodeFragment{
+              /* .tag = */ tag,
+              /* .surfaceId = */ 1,
+              /* .props = */ props_,
+              /* .eventEmitter = */
+              ShadowNodeFragment::eventEmitterPlaceholder(),
+              /* .children = */ ShadowNode::emptySharedShadowNodeSharedList(),
+          },
+          componentDescriptor_);
+    }
+    return shadowNode;
+  }
+
+  ShadowNode::Shared rootWithChildren(std::vector<Tag> const &tags) {
+    auto children = std::make_shared<SharedShadowNodeList>();
+    for (auto tag : tags) {
+      children->push_back(view(tag));
+    }
+    return rootShadowNode_->clone(ShadowNodeFragment{
+        ShadowNodeFragment::tagPlaceholder(),
+        ShadowNodeFragment::surfaceIdPlaceholder(),
+        ShadowNodeFragment::propsPlaceholder(),
+        ShadowNodeFragment::eventEmitterPlaceholder(),
+        children});
+  }
+
+  /*
+   * Diffs the lists of children, applies the mutations to a stub view tree
+   * that mirrors the old list and verifies that the result is the new list.
+   */
+  ShadowViewMutation::List diff(
+      std::vector<Tag> const &oldTags,
+      std::vector<Tag> const &newTags) {
+    auto oldRootShadowNode = rootWithChildren(oldTags);
+    auto newRootShadowNode = rootWithChildren(newTags);
+
+    auto mutations =
+        calculateShadowViewMutations(*oldRootShadowNode, *newRootShadowNode);
+
+    auto stubViewTree = stubViewTreeFromShadowNode(*oldRootShadowNode);
+    stubViewTree.mutate(mutations);
+    EXPECT_EQ(stubViewTree, stubViewTreeFromShadowNode(*newRootShadowNode));
+    EXPECT_EQ(childTags(stubViewTree), newTags);
+
+    return mutations;
+  }
+
+  static std::vector<Tag> childTags(StubViewTree const &stubViewTree) {
+    auto tags = std::vector<Tag>{};
+    for (auto const &child : stubViewTree.registry.at(kRootTag)->children) {
+      tags.push_back(child->tag);
+    }
+    return tags;
+  }
+
+  static int countMutations(
+      ShadowViewMutation::List const &mutations,
+      ShadowViewMutation::Type type) {
+    return std::count_if(
+        mutations.begin(),
+        mutations.end(),
+        [type](ShadowViewMutation const &mutation) {
+          return mutation.type == type;
+        });
+  }
+
+  static std::vector<Tag> range(Tag from, Tag to) {
+    auto tags = std::vector<Tag>{};
+    for (auto tag = from; tag < to; tag++) {
+      tags.push_back(tag);
+    }
+    return tags;
+  }
+
+  ViewComponentDescriptor componentDescriptor_{nullptr};
+  SharedProps props_ = std::make_shared<ViewProps const>(
+      ViewProps(),
+      // Views with `nativeID` are never flattened.
+      RawProps(folly::dynamic::object("nativeID", "view")));
+  ShadowNode::Shared rootShadowNode_ = std::make_shared<ViewShadowNode>(
+      ShadowNodeFragment{
+          /* .tag = */ kRootTag,
+          /* .surfaceId = */ 1,
+          /* .props = */ props_,
+          /* .eventEmitter = */ ShadowNodeFragment::eventEmitterPlaceholder(),
+          /* .children = */ ShadowNode::emptySharedShadowNodeSharedList(),
+      },
+      componentDescriptor_);
+  std::unordered_map<Tag, ShadowNode::Shared> views_;
+};
+
+constexpr Tag DifferentiatorTest::kRootTag;
+
+TEST_F(DifferentiatorTest, identicalChildren) {
+  auto mutations = diff({2, 3, 4}, {2, 3, 4});
+  EXPECT_EQ(mutations.size(), 0);
+}
+
+TEST_F(DifferentiatorTest, appendedChild) {
+  auto mutations = diff({2, 3, 4}, {2, 3, 4, 5});
+  EXPECT_EQ(mutations.size(), 2);
+  EXPECT_EQ(countMutations(mutations, ShadowViewMutation::Create), 1);
+  EXPECT_EQ(countMutations(mutations, ShadowViewMutation::Insert), 1);
+}
+
+TEST_F(DifferentiatorTest, prependedChild) {
+  auto mutations = diff({2, 3, 4}, {5, 2, 3, 4});
+  EXPECT_EQ(mutations.size(), 2);
+  EXPECT_EQ(countMutations(mutations, ShadowViewMutation::Create), 1);
+  EXPECT_EQ(countMutations(mutations, ShadowViewMutation::Insert), 1);
+}
+
+TEST_F(DifferentiatorTest, removedChild) {
+  auto mutations = diff({2, 3, 4, 5}, {2, 4, 5});
+  EXPECT_EQ(mutations.size(), 2);
+  EXPECT_EQ(countMutations(mutations, ShadowViewMutation::Remove), 1);
+  EXPECT_EQ(countMutations(mutations, ShadowViewMutation::Delete), 1);
+}
+
+TEST_F(DifferentiatorTest, movedChild) {
+  // Moving the last child to the front moves only that child and never
+  // recreates views.
+  auto mutations = diff({2, 3, 4, 5, 6}, {6, 2, 3, 4, 5});
+  EXPECT_EQ(mutations.size(), 2);
+  EXPECT_EQ(countMutations(mutations, ShadowViewMutation::Remove), 1);
+  EXPECT_EQ(countMutations(mutations, ShadowViewMutation::Insert), 1);
+
+  // Same for moving the first child to the back.
+  mutations = diff({2, 3, 4, 5, 6}, {3, 4, 5, 6, 2});
+  EXPECT_EQ(mutations.size(), 2);
+}
+
+TEST_F(DifferentiatorTest, swappedChildren) {
+  auto mutations = diff({2, 3, 4, 5}, {2, 5, 4, 3});
+  EXPECT_EQ(countMutations(mutations, ShadowViewMutation::Remove), 2);
+  EXPECT_EQ(countMutations(mutations, ShadowViewMutation::Insert), 2);
+  EXPECT_EQ(countMutations(mutations, ShadowViewMutation::Create), 0);
+  EXPECT_EQ(countMutations(mutations, ShadowViewMutation::Delete), 0);
+}
+
+TEST_F(DifferentiatorTest, movedInsertedAndRemovedChildren) {
+  // Long enough to use hashed lookup instead of `TinyMap`.
+  auto oldTags = range(2, 42);
+  auto newTags = std::vector<Tag>{100};
+  newTags.insert(newTags.end(), oldTags.rbegin(), oldTags.rbegin() + 10);
+  newTags.insert(newTags.end(), oldTags.begin() + 5, oldTags.end() - 10);
+  newTags.push_back(101);
+
+  auto mutations = diff(oldTags, newTags);
+  EXPECT_EQ(countMutations(mutations, ShadowViewMutation::Create), 2);
+  EXPECT_EQ(countMutations(mutations, ShadowViewMutation::Delete), 5);
+  EXPECT_EQ(countMutations(mutations, ShadowViewMutation::Remove), 15);
+  EXPECT_EQ(countMutations(mutations, ShadowViewMutation::Insert), 12);
+}
+
+TEST_F(DifferentiatorTest, cachedChildPairsAcrossDiffs) {
+  auto cache = ShadowViewNodePairCache{};
+  auto revisions = std::vector<ShadowNode::Shared>{
+      rootWithChildren({2, 3, 4}),
+      rootWithChildren({4, 3, 2, 5}),
+      rootWithChildren({5, 2}),
+      rootWithChildren({5, 2, 6, 7})};
+
+  for (int index = 1; index < revisions.size(); index++) {
+    auto const &oldRootShadowNode = *revisions[index - 1];
+    auto const &newRootShadowNode = *revisions[index];
+
+    // The cache keeps the new tree of every diff for the next one.
+    auto cachedMutations = calculateShadowViewMutations(
+        oldRootShadowNode, newRootShadowNode, &cache);
+    auto mutations =
+        calculateShadowViewMutations(oldRootShadowNode, newRootShadowNode);
+    EXPECT_EQ(cachedMutations.size(), mutations.size());
+
+    auto stubViewTree = stubViewTreeFromShadowNode(oldRootShadowNode);
+    stubViewTree.mutate(cachedMutations);
+    EXPECT_EQ(stubViewTree, stubViewTreeFromShadowNode(newRootShadowNode));
+  }
+}
+
+TEST_F(DifferentiatorTest, stagedMutationsInBuffer) {
+  MonotonicBuffer buffer;
+  auto oldRootShadowNode = rootWithChildren(range(2, 50));
+  auto newRootShadowNode = rootWithChildren(range(25, 75));
+
+  auto bufferedMutations = calculateShadowViewMutations(
+      *oldRootShadowNode, *newRootShadowNode, nullptr, &buffer);
+  auto mutations =
+      calculateShadowViewMutations(*oldRootShadowNode, *newRootShadowNode);
+  EXPECT_EQ(bufferedMutations.size(), mutations.size());
+  EXPECT_GT(buffer.getStats().allocatedBytes, 0);
+  EXPECT_GT(buffer.getStats().allocationCount, 0);
+
+  // The resulting list does not depend on the buffer.
+  buffer.reset();
+  EXPECT_EQ(buffer.getStats().allocatedBytes, 0);
+
+  auto stubViewTree = stubViewTreeFromShadowNode(*oldRootShadowNode);
+  stubViewTree.mutate(bufferedMutations);
+  EXPECT_EQ(stubViewTree, stubViewTreeFromShadowNode(*newRootShadowNode));
+
+  // The retained chunk serves the same diff again.
+  calculateShadowViewMutations(
+      *oldRootShadowNode, *newRootShadowNode, nullptr, &buffer);
+  EXPECT_EQ(buffer.getStats().chunkAllocationCount, 0);
+}
+
+TEST_F(DifferentiatorTest, longListUpdates) {
+  auto const size = 500;
+  auto const tags = range(2, 2 + size);
+  auto const addedTags = range(10000, 10000 + size / 10);
+
+  // Reordering never recreates views, and the children which keep their
+  // relative order stay in place.
+  auto shuffledTags = tags;
+  std::shuffle(shuffledTags.begin(), shuffledTags.end(), std::mt19937{42});
+  auto mutations = diff(tags, shuffledTags);
+  EXPECT_LT(mutations.size(), 2 * size);
+  EXPECT_EQ(countMutations(mutations, ShadowViewMutation::Create), 0);
+  EXPECT_EQ(countMutations(mutations, ShadowViewMutation::Delete), 0);
+
+  // Adding children at either end touches only the added children.
+  auto prependedTags = addedTags;
+  prependedTags.insert(prependedTags.end(), tags.begin(), tags.end());
+  mutations = diff(tags, prependedTags);
+  EXPECT_EQ(mutations.size(), 2 * addedTags.size());
+  EXPECT_EQ(
+      countMutations(mutations, ShadowViewMutation::Create), addedTags.size());
+
+  auto appendedTags = tags;
+  appendedTags.insert(appendedTags.end(), addedTags.begin(), addedTags.end());
+  mutations = diff(tags, appendedTags);
+  EXPECT_EQ(mutations.size(), 2 * addedTags.size());
+  EXPECT_EQ(
+      countMutations(mutations, ShadowViewMutation::Create), addedTags.size());
+}
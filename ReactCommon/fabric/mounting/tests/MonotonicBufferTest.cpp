@@ -0,0 +1,54 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <react/mounting/MonotonicBuffer.h>
+
+using namespace facebook::react;
+
+TEST(MonotonicBufferTest, reusesMemoryOfPreviousUsage) {
+  MonotonicBuffer buffer{1024};
+  for (int i = 0; i < 10; i++) {
+    buffer.allocate(1000, 8);
+  }
+  EXPECT_GT(buffer.getStats().chunkAllocationCount, 1);
+
+  // Everything fits into the chunk which the reset kept.
+  for (int reset = 0; reset < 20; reset++) {
+    buffer.reset();
+    for (int i = 0; i < 10; i++) {
+      buffer.allocate(1000, 8);
+    }
+    EXPECT_EQ(buffer.getStats().chunkAllocationCount, 0);
+  }
+}
+
+TEST(MonotonicBufferTest, releasesMemoryAfterPeak) {
+  MonotonicBuffer buffer{1024};
+  buffer.allocate(64 * 1024, 8);
+  buffer.allocate(64 * 1024, 8);
+
+  // Small usage is served from the chunk of the peak for a while...
+  auto resetCount = 0;
+  do {
+    buffer.reset();
+    resetCount++;
+    buffer.allocate(100, 8);
+  } while (buffer.getStats().chunkAllocationCount == 0 && resetCount < 100);
+
+  // ...until the buffer drops back to the initial chunk size.
+  EXPECT_GT(resetCount, 1);
+  EXPECT_LT(resetCount, 100);
+  EXPECT_EQ(buffer.getStats().chunkAllocationCount, 1);
+
+  // A chunk of the initial size isn't released again.
+  for (int reset = 0; reset < 20; reset++) {
+    buffer.reset();
+    buffer.allocate(100, 8);
+    EXPECT_EQ(buffer.getStats().chunkAllocationCount, 0);
+  }
+}
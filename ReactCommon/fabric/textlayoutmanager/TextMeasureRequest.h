@@ -0,0 +1,32 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <react/attributedstring/AttributedString.h>
+#include <react/attributedstring/ParagraphAttributes.h>
+#include <react/core/LayoutConstraints.h>
+
+namespace facebook {
+namespace react {
+
+/*
+ * Arguments of a single `TextLayoutManager::measure` call; a list of them can
+ * be measured at once with `TextLayoutManager::measureBatch`.
+ */
+struct TextMeasureRequest {
+  AttributedString attributedString;
+  ParagraphAttributes paragraphAttributes;
+  LayoutConstraints layoutConstraints;
+};
+
+using TextMeasureRequestList = std::vector<TextMeasureRequest>;
+
+} // namespace react
+} // namespace facebook
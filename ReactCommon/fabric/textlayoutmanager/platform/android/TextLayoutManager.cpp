@@ -9,6 +9,7 @@
 
 #include <react/attributedstring/conversions.h>
 #include <react/core/conversions.h>
+#include <react/jni/ReadableNativeArray.h>
 #include <react/jni/ReadableNativeMap.h>
 
 using namespace facebook::jni;
@@ -22,13 +23,20 @@ void *TextLayoutManager::getNativeTextLayoutManager() const {
   return self_;
 }
 
+jni::global_ref<jobject> const &TextLayoutManager::getFabricUIManager() const {
+  std::call_once(fabricUIManagerOnceFlag_, [&]() {
+    fabricUIManager_ =
+        contextContainer_->getInstance<jni::global_ref<jobject>>(
+            "FabricUIManager");
+  });
+  return fabricUIManager_;
+}
+
 Size TextLayoutManager::measure(
     AttributedString attributedString,
     ParagraphAttributes paragraphAttributes,
     LayoutConstraints layoutConstraints) const {
-  const jni::global_ref<jobject> &fabricUIManager =
-      contextContainer_->getInstance<jni::global_ref<jobject>>(
-          "FabricUIManager");
+  const jni::global_ref<jobject> &fabricUIManager = getFabricUIManager();
 
   static auto measure =
       jni::findClassStatic("com/facebook/react/fabric/FabricUIManager")
@@ -67,5 +75,66 @@ Size TextLayoutManager::measure(
       maximumSize.height));
 }
 
+std::vector<Size> TextLayoutManager::measureBatch(
+    TextMeasureRequestList const &requests) const {
+  if (requests.empty()) {
+    return {};
+  }
+
+  const jni::global_ref<jobject> &fabricUIManager = getFabricUIManager();
+
+  static auto measureBatch =
+      jni::findClassStatic("com/facebook/react/fabric/FabricUIManager")
+          ->getMethod<jlongArray(
+              jstring, ReadableArray::javaobject, jfloatArray)>(
+              "measureBatch");
+
+  // All requests are packed into two arguments, so there is a single call
+  // into Java however many requests there are: an array of attributed strings
+  // and paragraph attributes (interleaved), and an array of constraints (four
+  // values per request). Attributed strings stay in the `ReadableMap` form
+  // because Java text layout (and its spannable cache) consumes them as is.
+  auto count = requests.size();
+  auto attributes = folly::dynamic::array();
+  auto constraints = std::vector<jfloat>{};
+  constraints.reserve(count * 4);
+  for (auto const &request : requests) {
+    attributes.push_back(toDynamic(request.attributedString));
+    attributes.push_back(toDynamic(request.paragraphAttributes));
+    auto minimumSize = request.layoutConstraints.minimumSize;
+    auto maximumSize = request.layoutConstraints.maximumSize;
+    constraints.push_back(minimumSize.width);
+    constraints.push_back(maximumSize.width);
+    constraints.push_back(minimumSize.height);
+    constraints.push_back(maximumSize.height);
+  }
+
+  local_ref<JString> componentName = make_jstring("RCTText");
+  local_ref<ReadableNativeArray::javaobject> attributesRNA =
+      ReadableNativeArray::newObjectCxxArgs(std::move(attributes));
+  local_ref<ReadableArray::javaobject> attributesRA = make_local(
+      reinterpret_cast<ReadableArray::javaobject>(attributesRNA.get()));
+  local_ref<JArrayFloat> constraintsArray =
+      JArrayFloat::newArray(constraints.size());
+  constraintsArray->setRegion(
+      0, static_cast<jsize>(constraints.size()), constraints.data());
+
+  local_ref<JArrayLong> measurements = measureBatch(
+      fabricUIManager,
+      componentName.get(),
+      attributesRA.get(),
+      constraintsArray.get());
+
+  auto values = std::vector<jlong>(count);
+  measurements->getRegion(0, static_cast<jsize>(count), values.data());
+
+  auto sizes = std::vector<Size>{};
+  sizes.reserve(count);
+  for (auto value : values) {
+    sizes.push_back(yogaMeassureToSize(value));
+  }
+  return sizes;
+}
+
 } // namespace react
 } // namespace facebook
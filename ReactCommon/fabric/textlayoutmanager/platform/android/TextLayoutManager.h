@@ -8,10 +8,15 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
+#include <vector>
+
+#include <fb/fbjni.h>
 
 #include <react/attributedstring/AttributedString.h>
 #include <react/attributedstring/ParagraphAttributes.h>
 #include <react/core/LayoutConstraints.h>
+#include <react/textlayoutmanager/TextMeasureRequest.h>
 #include <react/utils/ContextContainer.h>
 
 namespace facebook {
@@ -38,6 +43,12 @@ class TextLayoutManager {
       ParagraphAttributes paragraphAttributes,
       LayoutConstraints layoutConstraints) const;
 
+  /*
+   * Measures every request of `requests` with a single call to Java;
+   * returns sizes in the same order.
+   */
+  std::vector<Size> measureBatch(TextMeasureRequestList const &requests) const;
+
   /*
    * Returns an opaque pointer to platform-specific TextLayoutManager.
    * Is used on a native views layer to delegate text rendering to the manager.
@@ -45,9 +56,17 @@ class TextLayoutManager {
   void *getNativeTextLayoutManager() const;
 
  private:
+  /*
+   * Returns `FabricUIManager` Java object; it is looked up in
+   * `ContextContainer` only once.
+   */
+  jni::global_ref<jobject> const &getFabricUIManager() const;
+
   void *self_;
 
   ContextContainer::Shared contextContainer_;
+  mutable std::once_flag fabricUIManagerOnceFlag_;
+  mutable jni::global_ref<jobject> fabricUIManager_;
 };
 
 } // namespace react
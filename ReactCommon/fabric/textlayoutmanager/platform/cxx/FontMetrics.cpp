@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "FontMetrics.h"
+
+namespace facebook {
+namespace react {
+
+static bool isCombiningMark(uint32_t codePoint) {
+  return (codePoint >= 0x0300 && codePoint <= 0x036F) ||
+      (codePoint >= 0x200B && codePoint <= 0x200F) ||
+      (codePoint >= 0xFE00 && codePoint <= 0xFE0F);
+}
+
+static bool isWide(uint32_t codePoint) {
+  return (codePoint >= 0x1100 && codePoint <= 0x115F) || // Hangul Jamo
+      (codePoint >= 0x2E80 && codePoint <= 0xA4CF) || // CJK, Kana, Yi
+      (codePoint >= 0xAC00 && codePoint <= 0xD7A3) || // Hangul Syllables
+      (codePoint >= 0xF900 && codePoint <= 0xFAFF) || // CJK Compatibility
+      (codePoint >= 0xFF00 && codePoint <= 0xFF60) || // Fullwidth Forms
+      (codePoint >= 0x1F300 && codePoint <= 0x1FAFF) || // Emoji
+      (codePoint >= 0x20000 && codePoint <= 0x3FFFD); // CJK Extensions
+}
+
+Float FontMetrics::getAdvance(uint32_t codePoint) const {
+  if (codePoint >= 0x20 && codePoint <= 0x7E) {
+    return asciiAdvances[codePoint - 0x20];
+  }
+
+  if (codePoint == 0x2026) {
+    return ellipsisAdvance;
+  }
+
+  if (isCombiningMark(codePoint)) {
+    return 0;
+  }
+
+  if (isWide(codePoint)) {
+    return 1;
+  }
+
+  return defaultAdvance;
+}
+
+FontMetrics const &FontMetrics::defaultFontMetrics() {
+  // Advances from the Helvetica AFM file, in thousandths of an em.
+  static auto const fontMetrics = [] {
+    auto const advances = std::array<int, 95>{{
+        278, 278, 355, 556, 556, 889, 667, 191, 333, 333, 389, 584, // ' '-'+'
+        278, 333, 278, 278, 556, 556, 556, 556, 556, 556, 556, 556, // ','-'7'
+        556, 556, 278, 278, 584, 584, 584, 556, 1015, 667, 667, 722, // '8'-'C'
+        722, 667, 611, 778, 722, 278, 500, 667, 556, 833, 722, 778, // 'D'-'O'
+        667, 778, 722, 667, 611, 722, 667, 944, 667, 667, 611, 278, // 'P'-'['
+        278, 278, 469, 556, 333, 556, 556, 500, 556, 556, 278, 556, // '\'-'g'
+        556, 222, 222, 500, 222, 833, 556, 556, 556, 556, 333, 500, // 'h'-'s'
+        278, 556, 500, 722, 500, 500, 500, 334, 260, 334, 584, // 't'-'~'
+    }};
+
+    auto fontMetrics = FontMetrics{};
+    for (size_t index = 0; index < advances.size(); index++) {
+      fontMetrics.asciiAdvances[index] = advances[index] / Float{1000};
+    }
+    fontMetrics.defaultAdvance = 0.556;
+    fontMetrics.ellipsisAdvance = 1;
+    fontMetrics.boldAdvanceScale = 1.06;
+    // Ascent, descent and line gap of Arial.
+    fontMetrics.lineHeight = (1854 + 434 + 67) / Float{2048};
+    return fontMetrics;
+  }();
+
+  return fontMetrics;
+}
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,73 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <better/map.h>
+#include <react/graphics/Geometry.h>
+
+namespace facebook {
+namespace react {
+
+/*
+ * Metrics of a font which the portable `TextLayoutManager` uses instead of
+ * real font files. All values are in ems (fractions of the font size).
+ */
+struct FontMetrics {
+  /*
+   * Advances of printable ASCII characters, from U+0020 (space) to U+007E.
+   */
+  std::array<Float, 95> asciiAdvances;
+
+  /*
+   * Advance of other characters, except wide (e.g. CJK) characters which
+   * always take one em and combining marks which take nothing.
+   */
+  Float defaultAdvance;
+
+  /*
+   * Advance of the ellipsis (U+2026).
+   */
+  Float ellipsisAdvance;
+
+  /*
+   * Advances of bold text (font weight 600 and heavier) are scaled by this.
+   */
+  Float boldAdvanceScale;
+
+  /*
+   * Height of a line (ascent, descent and line gap) unless `lineHeight` is
+   * specified.
+   */
+  Float lineHeight;
+
+  /*
+   * Returns the advance of the given Unicode code point.
+   */
+  Float getAdvance(uint32_t codePoint) const;
+
+  /*
+   * Metrics of Helvetica (and metric-compatible Arial).
+   */
+  static FontMetrics const &defaultFontMetrics();
+};
+
+/*
+ * Font metrics by font family. The portable `TextLayoutManager` looks it up
+ * in `ContextContainer` (as `std::shared_ptr<FontMetricsMap const>` by
+ * `"FontMetrics"` key); fonts which are not in the map use
+ * `FontMetrics::defaultFontMetrics()`.
+ */
+using FontMetricsMap = better::map<std::string, FontMetrics>;
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,267 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "TextLayoutManager.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace facebook {
+namespace react {
+
+namespace {
+
+/*
+ * A laid out character (or an attachment).
+ */
+struct Character {
+  Float advance;
+  Float lineHeight;
+  Float ellipsisAdvance;
+  bool isWhitespace;
+  bool isLineBreak;
+  bool allowsBreakAfter;
+};
+
+struct Line {
+  Float width; // Without trailing whitespace.
+  Float height;
+};
+
+/*
+ * Decodes the next code point from a UTF-8 string; invalid sequences are
+ * decoded as U+FFFD one byte at a time.
+ */
+uint32_t decodeUTF8(std::string const &string, size_t &index) {
+  auto byte = static_cast<uint8_t>(string[index++]);
+  if (byte < 0x80) {
+    return byte;
+  }
+
+  auto length = byte >= 0xF0 ? 3 : byte >= 0xE0 ? 2 : byte >= 0xC0 ? 1 : -1;
+  if (length < 0 || index + length > string.size()) {
+    return 0xFFFD;
+  }
+
+  auto codePoint = static_cast<uint32_t>(byte & (0x3F >> length));
+  for (int i = 0; i < length; i++) {
+    auto continuation = static_cast<uint8_t>(string[index + i]);
+    if ((continuation & 0xC0) != 0x80) {
+      return 0xFFFD;
+    }
+    codePoint = (codePoint << 6) | (continuation & 0x3F);
+  }
+  index += length;
+  return codePoint;
+}
+
+bool allowsBreakAfter(uint32_t codePoint) {
+  return codePoint == ' ' || codePoint == '\t' || codePoint == '-' ||
+      codePoint == 0x200B || // Zero Width Space
+      (codePoint >= 0x2E80 && codePoint <= 0x9FFF) || // CJK
+      (codePoint >= 0xAC00 && codePoint <= 0xD7A3) || // Hangul
+      (codePoint >= 0xFF00 && codePoint <= 0xFF60); // Fullwidth Forms
+}
+
+} // namespace
+
+TextLayoutManager::TextLayoutManager(
+    ContextContainer::Shared const &contextContainer) {
+  if (contextContainer) {
+    fontMetricsMap_ =
+        contextContainer
+            ->findInstance<std::shared_ptr<FontMetricsMap const>>(
+                "FontMetrics")
+            .value_or(nullptr);
+  }
+}
+
+TextLayoutManager::~TextLayoutManager() {}
+
+void *TextLayoutManager::getNativeTextLayoutManager() const {
+  return nullptr;
+}
+
+FontMetrics const &TextLayoutManager::getFontMetrics(
+    std::string const &fontFamily) const {
+  if (fontMetricsMap_) {
+    auto iterator = fontMetricsMap_->find(fontFamily);
+    if (iterator != fontMetricsMap_->end()) {
+      return iterator->second;
+    }
+  }
+
+  return FontMetrics::defaultFontMetrics();
+}
+
+Size TextLayoutManager::measure(
+    AttributedString attributedString,
+    ParagraphAttributes paragraphAttributes,
+    LayoutConstraints layoutConstraints) const {
+  auto characters = std::vector<Character>{};
+
+  for (auto const &fragment : attributedString.getFragments()) {
+    auto const &textAttributes = fragment.textAttributes;
+
+    if (fragment.shadowView.componentHandle) {
+      // Attachments are laid out as unbreakable boxes.
+      auto size = fragment.shadowView.layoutMetrics.frame.size;
+      characters.push_back({size.width, size.height, 0, false, false, true});
+      continue;
+    }
+
+    auto const &fontMetrics = getFontMetrics(textAttributes.fontFamily);
+    auto fontSize = std::isnan(textAttributes.fontSize)
+        ? TextAttributes::defaultTextAttributes().fontSize
+        : textAttributes.fontSize;
+    auto fontScale = textAttributes.allowFontScaling.value_or(true) &&
+            !std::isnan(textAttributes.fontSizeMultiplier)
+        ? textAttributes.fontSizeMultiplier
+        : Float{1};
+    fontSize *= fontScale;
+
+    auto advanceScale = fontSize;
+    if (textAttributes.fontWeight.hasValue() &&
+        (int)textAttributes.fontWeight.value() >= (int)FontWeight::Semibold) {
+      advanceScale *= fontMetrics.boldAdvanceScale;
+    }
+
+    auto letterSpacing = std::isnan(textAttributes.letterSpacing)
+        ? Float{0}
+        : textAttributes.letterSpacing;
+
+    auto lineHeight = std::isnan(textAttributes.lineHeight)
+        ? fontSize * fontMetrics.lineHeight
+        : textAttributes.lineHeight * fontScale;
+
+    auto const &string = fragment.string;
+    for (size_t index = 0; index < string.size();) {
+      auto codePoint = decodeUTF8(string, index);
+      auto character = Character{};
+      character.lineHeight = lineHeight;
+      character.ellipsisAdvance = fontMetrics.ellipsisAdvance * advanceScale;
+
+      if (codePoint == '\n') {
+        character.isLineBreak = true;
+        characters.push_back(character);
+        continue;
+      }
+
+      if (codePoint == '\t') {
+        codePoint = ' ';
+      }
+
+      character.advance =
+          fontMetrics.getAdvance(codePoint) * advanceScale + letterSpacing;
+      character.isWhitespace = codePoint == ' ';
+      character.allowsBreakAfter = allowsBreakAfter(codePoint);
+      characters.push_back(character);
+    }
+  }
+
+  auto maximumWidth = layoutConstraints.maximumSize.width;
+  auto maximumNumberOfLines = paragraphAttributes.maximumNumberOfLines > 0
+      ? (size_t)paragraphAttributes.maximumNumberOfLines
+      : std::numeric_limits<size_t>::max();
+
+  auto lines = std::vector<Line>{};
+  auto index = size_t{0};
+
+  // Greedy line breaking: every line takes as many characters as fit, and is
+  // broken at the last break opportunity. Whitespace at the end of a line may
+  // overflow it; words which are wider than a line are broken anywhere.
+  while (index < characters.size() && lines.size() < maximumNumberOfLines) {
+    auto lineStart = index;
+    auto width = Float{0};
+    auto line = Line{0, 0};
+    auto breakIndex = lineStart;
+    auto lineAtBreak = line;
+
+    while (index < characters.size()) {
+      auto const &character = characters[index];
+
+      if (character.isLineBreak) {
+        line.height = std::max(line.height, character.lineHeight);
+        index++;
+        breakIndex = index;
+        lineAtBreak = line;
+        break;
+      }
+
+      if (!character.isWhitespace && index > lineStart &&
+          width + character.advance > maximumWidth) {
+        if (breakIndex > lineStart) {
+          index = breakIndex;
+          line = lineAtBreak;
+        }
+        break;
+      }
+
+      width += character.advance;
+      line.height = std::max(line.height, character.lineHeight);
+      if (!character.isWhitespace) {
+        line.width = width;
+      }
+      index++;
+
+      if (character.allowsBreakAfter) {
+        breakIndex = index;
+        lineAtBreak = line;
+      }
+    }
+
+    lines.push_back(line);
+  }
+
+  // A line break at the very end starts an empty line.
+  if (!characters.empty() && characters.back().isLineBreak &&
+      index == characters.size() && lines.size() < maximumNumberOfLines) {
+    lines.push_back({0, characters.back().lineHeight});
+  }
+
+  // The last line is ellipsized if the text does not fit in the allowed
+  // number of lines.
+  while (index < characters.size() && characters[index].isWhitespace) {
+    index++;
+  }
+  if (index < characters.size() && !lines.empty() &&
+      paragraphAttributes.ellipsizeMode != EllipsizeMode::Clip) {
+    auto &line = lines.back();
+    line.width = std::min(
+        line.width + characters[index - 1].ellipsisAdvance, maximumWidth);
+  }
+
+  auto size = Size{0, 0};
+  for (auto const &line : lines) {
+    size.width = std::max(size.width, std::min(line.width, maximumWidth));
+    size.height += line.height;
+  }
+
+  // Native text rendering rounds the size up to whole pixels; whole points
+  // are used here.
+  size.width = std::ceil(size.width);
+  size.height = std::ceil(size.height);
+  return layoutConstraints.clamp(size);
+}
+
+std::vector<Size> TextLayoutManager::measureBatch(
+    TextMeasureRequestList const &requests) const {
+  auto sizes = std::vector<Size>{};
+  sizes.reserve(requests.size());
+  for (auto const &request : requests) {
+    sizes.push_back(measure(
+        request.attributedString,
+        request.paragraphAttributes,
+        request.layoutConstraints));
+  }
+  return sizes;
+}
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,64 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <react/attributedstring/AttributedString.h>
+#include <react/attributedstring/ParagraphAttributes.h>
+#include <react/core/LayoutConstraints.h>
+#include <react/textlayoutmanager/TextMeasureRequest.h>
+#include <react/textlayoutmanager/FontMetrics.h>
+#include <react/utils/ContextContainer.h>
+
+namespace facebook {
+namespace react {
+
+class TextLayoutManager;
+
+using SharedTextLayoutManager = std::shared_ptr<const TextLayoutManager>;
+
+/*
+ * Portable implementation of TextLayoutManager which does not depend on any
+ * platform text rendering infrastructure (e.g. for benchmarks and
+ * server-side layout). Text is measured using font metrics tables; lines are
+ * broken greedily at spaces, hyphens and between wide (e.g. CJK) characters.
+ */
+class TextLayoutManager {
+ public:
+  TextLayoutManager(ContextContainer::Shared const &contextContainer);
+  ~TextLayoutManager();
+
+  /*
+   * Measures `attributedString` using font metrics tables.
+   */
+  Size measure(
+      AttributedString attributedString,
+      ParagraphAttributes paragraphAttributes,
+      LayoutConstraints layoutConstraints) const;
+
+  /*
+   * Measures every request of `requests`; returns sizes in the same order.
+   */
+  std::vector<Size> measureBatch(TextMeasureRequestList const &requests) const;
+
+  /*
+   * Returns an opaque pointer to platform-specific TextLayoutManager.
+   * There is no such manager on this platform, so it returns `nullptr`.
+   */
+  void *getNativeTextLayoutManager() const;
+
+ private:
+  FontMetrics const &getFontMetrics(std::string const &fontFamily) const;
+
+  std::shared_ptr<FontMetricsMap const> fontMetricsMap_;
+};
+
+} // namespace react
+} // namespace facebook
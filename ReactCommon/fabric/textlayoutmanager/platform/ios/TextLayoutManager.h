@@ -8,10 +8,12 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <react/attributedstring/AttributedString.h>
 #include <react/attributedstring/ParagraphAttributes.h>
 #include <react/core/LayoutConstraints.h>
+#include <react/textlayoutmanager/TextMeasureRequest.h>
 #include <react/utils/ContextContainer.h>
 
 namespace facebook {
@@ -37,6 +39,11 @@ class TextLayoutManager {
       ParagraphAttributes paragraphAttributes,
       LayoutConstraints layoutConstraints) const;
 
+  /*
+   * Measures every request of `requests`; returns sizes in the same order.
+   */
+  std::vector<Size> measureBatch(TextMeasureRequestList const &requests) const;
+
   /*
    * Returns an opaque pointer to platform-specific TextLayoutManager.
    * Is used on a native views layer to delegate text rendering to the manager.
@@ -37,5 +37,18 @@ Size TextLayoutManager::measure(
                                       layoutConstraints:layoutConstraints];
 }
 
+std::vector<Size> TextLayoutManager::measureBatch(
+    TextMeasureRequestList const &requests) const {
+  auto sizes = std::vector<Size>{};
+  sizes.reserve(requests.size());
+  for (auto const &request : requests) {
+    sizes.push_back(measure(
+        request.attributedString,
+        request.paragraphAttributes,
+        request.layoutConstraints));
+  }
+  return sizes;
+}
+
 } // namespace react
 } // namespace facebook
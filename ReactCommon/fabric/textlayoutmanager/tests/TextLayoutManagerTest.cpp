@@ -5,6 +5,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <cmath>
 #include <memory>
 
 #include <gtest/gtest.h>
@@ -16,3 +17,126 @@ using namespace facebook::react;
 TEST(TextLayoutManagerTest, testSomething) {
   // TODO:
 }
+
+#if !defined(ANDROID) && !defined(__APPLE__)
+
+namespace {
+
+AttributedString makeAttributedString(std::string string) {
+  auto fragment = AttributedString::Fragment{};
+  fragment.string = std::move(string);
+  fragment.textAttributes.fontSize = 10;
+
+  auto attributedString = AttributedString{};
+  attributedString.appendFragment(fragment);
+  return attributedString;
+}
+
+LayoutConstraints makeConstraints(Float maximumWidth) {
+  auto layoutConstraints = LayoutConstraints{};
+  layoutConstraints.maximumSize.width = maximumWidth;
+  return layoutConstraints;
+}
+
+// Height of `lineCount` lines of 10 points text, rounded up.
+Float heightOfLines(int lineCount) {
+  return std::ceil(lineCount * 10 * (1854 + 434 + 67) / Float{2048});
+}
+
+} // namespace
+
+TEST(TextLayoutManagerTest, measuresSingleLine) {
+  TextLayoutManager textLayoutManager{nullptr};
+
+  // "Hello" is (722 + 556 + 222 + 222 + 556) / 1000 em wide.
+  auto size = textLayoutManager.measure(
+      makeAttributedString("Hello"), {}, makeConstraints(1000));
+  EXPECT_EQ(size, (Size{23, heightOfLines(1)}));
+
+  EXPECT_EQ(
+      textLayoutManager.measure(AttributedString{}, {}, makeConstraints(100)),
+      (Size{0, 0}));
+}
+
+TEST(TextLayoutManagerTest, breaksLinesAtSpaces) {
+  TextLayoutManager textLayoutManager{nullptr};
+  // Every word is 5 * 5.56 = 27.8 points wide, a space is 2.78 points wide.
+  auto attributedString = makeAttributedString("aaaaa bbbbb ddddd");
+
+  EXPECT_EQ(
+      textLayoutManager.measure(attributedString, {}, makeConstraints(100)),
+      (Size{89, heightOfLines(1)}));
+  EXPECT_EQ(
+      textLayoutManager.measure(attributedString, {}, makeConstraints(60)),
+      (Size{59, heightOfLines(2)}));
+  EXPECT_EQ(
+      textLayoutManager.measure(attributedString, {}, makeConstraints(30)),
+      (Size{28, heightOfLines(3)}));
+
+  // Words which are wider than a line are broken anywhere.
+  EXPECT_EQ(
+      textLayoutManager.measure(attributedString, {}, makeConstraints(12)),
+      (Size{12, heightOfLines(9)}));
+
+  // Explicit line breaks are kept.
+  EXPECT_EQ(
+      textLayoutManager.measure(
+          makeAttributedString("aaaaa\nbbbbb\n"), {}, makeConstraints(100)),
+      (Size{28, heightOfLines(3)}));
+}
+
+TEST(TextLayoutManagerTest, limitsNumberOfLines) {
+  TextLayoutManager textLayoutManager{nullptr};
+  auto attributedString = makeAttributedString("aaaaa bbbbb ddddd");
+  auto paragraphAttributes = ParagraphAttributes{};
+  paragraphAttributes.maximumNumberOfLines = 2;
+
+  EXPECT_EQ(
+      textLayoutManager.measure(
+          attributedString, paragraphAttributes, makeConstraints(30)),
+      (Size{28, heightOfLines(2)}));
+
+  // The ellipsis (10 points wide) is added to the last line.
+  paragraphAttributes.maximumNumberOfLines = 1;
+  paragraphAttributes.ellipsizeMode = EllipsizeMode::Tail;
+  EXPECT_EQ(
+      textLayoutManager.measure(
+          attributedString, paragraphAttributes, makeConstraints(100)),
+      (Size{89, heightOfLines(1)}));
+  EXPECT_EQ(
+      textLayoutManager.measure(
+          attributedString, paragraphAttributes, makeConstraints(60)),
+      (Size{60, heightOfLines(1)}));
+  EXPECT_EQ(
+      textLayoutManager.measure(
+          attributedString, paragraphAttributes, makeConstraints(40)),
+      (Size{38, heightOfLines(1)}));
+}
+
+TEST(TextLayoutManagerTest, usesFontMetricsFromContextContainer) {
+  auto fontMetrics = FontMetrics::defaultFontMetrics();
+  fontMetrics.asciiAdvances.fill(1);
+  fontMetrics.lineHeight = 2;
+
+  auto contextContainer = std::make_shared<ContextContainer>();
+  contextContainer->registerInstance(
+      std::make_shared<FontMetricsMap const>(
+          FontMetricsMap{{"Monospace", fontMetrics}}),
+      "FontMetrics");
+  TextLayoutManager textLayoutManager{contextContainer};
+
+  auto attributedString = makeAttributedString("Hello");
+  EXPECT_EQ(
+      textLayoutManager.measure(attributedString, {}, makeConstraints(1000)),
+      (Size{23, heightOfLines(1)}));
+
+  auto fragment = attributedString.getFragments().front();
+  fragment.textAttributes.fontFamily = "Monospace";
+  auto monospaceString = AttributedString{};
+  monospaceString.appendFragment(fragment);
+  EXPECT_EQ(
+      textLayoutManager.measure(monospaceString, {}, makeConstraints(1000)),
+      (Size{50, 20}));
+}
+
+#endif
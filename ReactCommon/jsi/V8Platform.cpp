@@ -20,46 +20,128 @@ namespace v8runtime {
   return platform;
 }
 
-WorkerThreadsTaskRunner::~WorkerThreadsTaskRunner() {
-  stop_requested_ = true;
-  tasks_available_cond_.notify_all();
-  delayed_tasks_available_cond_.notify_all();
+namespace {
+
+// Budget of a single round of idle tasks, short enough to not delay a frame.
+constexpr double kIdleTaskBudgetInSeconds = 0.004;
+// Idle tasks left over after a round wait for about a frame, so that the work queued meanwhile goes first.
+constexpr double kIdleTaskRetryDelayInSeconds = 0.016;
+constexpr int kMaxWorkerThreadCount = 4;
 
-  // Wait until both worker and timer threads are dranined.
-  std::unique_lock<std::mutex> worker_stopped_lock(worker_stopped_mutex_);
-  worker_stopped_cond_.wait(worker_stopped_lock, [this]() {return worker_stopped_; });
+// Lets a task go through std::function, which has to be copyable, and come out as a unique_ptr again.
+class SharedTask : public v8::Task {
+public:
+  explicit SharedTask(std::shared_ptr<v8::Task> task) : task_(std::move(task)) {}
+
+  void Run() override { task_->Run(); }
+
+private:
+  std::shared_ptr<v8::Task> task_;
+};
+
+double MonotonicTimeInSeconds() {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+DelayedTaskScheduler::DelayedTaskScheduler() {
+  std::thread(&DelayedTaskScheduler::TimerFunc, this).detach();
+}
+
+DelayedTaskScheduler::~DelayedTaskScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(delayed_queue_access_mutex_);
+    stop_requested_ = true;
+  }
+  delayed_tasks_available_cond_.notify_all();
 
   std::unique_lock<std::mutex> timer_stopped_lock(timer_stopped_mutex_);
   timer_stopped_cond_.wait(timer_stopped_lock, [this]() {return timer_stopped_; });
 }
 
-WorkerThreadsTaskRunner::WorkerThreadsTaskRunner() {
-  std::thread(&WorkerThreadsTaskRunner::WorkerFunc, this).detach();
-  std::thread(&WorkerThreadsTaskRunner::TimerFunc, this).detach();
+void DelayedTaskScheduler::Schedule(std::function<void()> callback, double delay_in_seconds) {
+  auto deadline = std::chrono::steady_clock::now() +
+    std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(delay_in_seconds));
+
+  {
+    std::lock_guard<std::mutex> lock(delayed_queue_access_mutex_);
+    delayed_task_queue_.push(std::make_pair(deadline, std::move(callback)));
+  }
+  delayed_tasks_available_cond_.notify_all();
 }
 
-void WorkerThreadsTaskRunner::PostTask(std::unique_ptr<v8::Task> task) {
+void DelayedTaskScheduler::TimerFunc() {
+  std::unique_lock<std::mutex> delayed_lock(delayed_queue_access_mutex_);
+  while (!stop_requested_) {
+    if (delayed_task_queue_.empty()) {
+      delayed_tasks_available_cond_.wait(delayed_lock);
+      continue; // Loop back and recompute, the wakeup may be spurious.
+    }
+
+    auto deadline = delayed_task_queue_.top().first;
+    if (std::chrono::steady_clock::now() < deadline) {
+      // Wakes up early if an earlier task gets scheduled meanwhile.
+      delayed_tasks_available_cond_.wait_until(delayed_lock, deadline);
+      continue;
+    }
+
+    std::function<void()> callback = std::move(const_cast<DelayedEntry&>(delayed_task_queue_.top()).second);
+    delayed_task_queue_.pop();
+
+    // Callbacks post to other queues, don't block Schedule meanwhile.
+    delayed_lock.unlock();
+    callback();
+    delayed_lock.lock();
+  }
+  delayed_lock.unlock();
+
+  std::lock_guard<std::mutex> lock(timer_stopped_mutex_);
+  timer_stopped_ = true;
+  timer_stopped_cond_.notify_all();
+}
+
+WorkerThreadsTaskRunner::WorkerThreadsTaskRunner(int thread_count, DelayedTaskScheduler& delayed_task_scheduler)
+  : thread_count_(std::max(thread_count, 1)), delayed_task_scheduler_(delayed_task_scheduler) {
+  workers_running_ = thread_count_;
+  for (int i = 0; i < thread_count_; i++) {
+    std::thread(&WorkerThreadsTaskRunner::WorkerFunc, this).detach();
+  }
+}
+
+WorkerThreadsTaskRunner::~WorkerThreadsTaskRunner() {
   {
     std::lock_guard<std::mutex> lock(queue_access_mutex_);
-    tasks_queue_.push(std::move(task));
+    stop_requested_ = true;
   }
-
   tasks_available_cond_.notify_all();
+
+  // Wait until all the worker threads are drained.
+  std::unique_lock<std::mutex> workers_stopped_lock(workers_stopped_mutex_);
+  workers_stopped_cond_.wait(workers_stopped_lock, [this]() {return workers_running_ == 0; });
 }
 
-void WorkerThreadsTaskRunner::PostDelayedTask(std::unique_ptr<v8::Task> task, double delay_in_seconds) {
+void WorkerThreadsTaskRunner::PostTask(std::unique_ptr<v8::Task> task) {
   {
-    if (delay_in_seconds == 0) {
-      PostTask(std::move(task));
-      return;
-    }
+    std::lock_guard<std::mutex> lock(queue_access_mutex_);
+    tasks_queue_.push(std::move(task));
+  }
 
-    double deadline = std::chrono::steady_clock::now().time_since_epoch().count() + delay_in_seconds * std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::seconds(1)).count();
+  // Every task is runnable by any worker, waking one is enough.
+  tasks_available_cond_.notify_one();
+}
 
-    std::lock_guard<std::mutex> lock(delayed_queue_access_mutex_);
-    delayed_task_queue_.push(std::make_pair(deadline, std::move(task)));
-    delayed_tasks_available_cond_.notify_all();
+void WorkerThreadsTaskRunner::PostDelayedTask(std::unique_ptr<v8::Task> task, double delay_in_seconds) {
+  if (delay_in_seconds <= 0) {
+    PostTask(std::move(task));
+    return;
   }
+
+  // std::function has to be copyable.
+  std::shared_ptr<v8::Task> s_task(task.release());
+  delayed_task_scheduler_.Schedule([this, s_task]() {
+    PostTask(std::unique_ptr<v8::Task>(new SharedTask(s_task)));
+  }, delay_in_seconds);
 }
 
 void WorkerThreadsTaskRunner::WorkerFunc() {
@@ -79,77 +161,126 @@ void WorkerThreadsTaskRunner::WorkerFunc() {
     nexttask->Run();
   }
 
-  worker_stopped_ = true;
-  worker_stopped_cond_.notify_all();
+  std::lock_guard<std::mutex> lock(workers_stopped_mutex_);
+  if (--workers_running_ == 0) {
+    workers_stopped_cond_.notify_all();
+  }
 }
 
-void WorkerThreadsTaskRunner::TimerFunc() {
-  while (true) {
+void ForegroundTaskRunner::PostTask(std::unique_ptr<v8::Task> task) {
+  PostSharedTask(std::shared_ptr<v8::Task>(task.release()));
+}
 
-    std::unique_lock<std::mutex> delayed_lock(delayed_queue_access_mutex_);
-    delayed_tasks_available_cond_.wait(delayed_lock, [this]() {return !delayed_task_queue_.empty() || stop_requested_; });
+void ForegroundTaskRunner::PostSharedTask(std::shared_ptr<v8::Task> task) {
+  // Note :: We assume that the underlying message queue implementation is properly syncronized.
+  std::shared_ptr<ForegroundTaskRunner> self = shared_from_this();
+  queue_->runOnQueue([self, s_task2=std::move(task)]() {
+    if (!self->terminated_) {
+      s_task2->Run();
+    }
+  });
+}
 
-    if (stop_requested_)
-      break;
+void ForegroundTaskRunner::PostDelayedTask(std::unique_ptr<v8::Task> task, double delay_in_seconds) {
+  if (delay_in_seconds <= 0) {
+    PostTask(std::move(task));
+    return;
+  }
 
-    if (delayed_task_queue_.empty())
-      continue; // Loop back and block the thread.
+  // MessageQueueThread has no delayed dispatch; wait on the timer thread and hop over to the JS queue.
+  std::shared_ptr<ForegroundTaskRunner> self = shared_from_this();
+  std::shared_ptr<v8::Task> s_task(task.release());
+  delayed_task_scheduler_.Schedule([self, s_task]() {
+    if (!self->terminated_) {
+      self->PostSharedTask(s_task);
+    }
+  }, delay_in_seconds);
+}
 
-    std::queue<std::unique_ptr<v8::Task>> new_ready_tasks;
+void ForegroundTaskRunner::PostIdleTask(std::unique_ptr<v8::IdleTask> task) {
+  {
+    std::lock_guard<std::mutex> lock(idle_tasks_access_mutex_);
+    idle_tasks_queue_.push(std::move(task));
+    if (idle_tasks_scheduled_) {
+      return;
+    }
+    idle_tasks_scheduled_ = true;
+  }
 
-    do {
-      const DelayedEntry& delayed_entry = delayed_task_queue_.top();
-      if (delayed_entry.first < std::chrono::steady_clock::now().time_since_epoch().count()) {
-        new_ready_tasks.push(std::move(const_cast<DelayedEntry&>(delayed_entry).second));
-        delayed_task_queue_.pop();
-      }
-      else
-      {
-        // The rest are not ready ..
-        break;
-      }
+  ScheduleIdleTasks(0);
+}
 
-    } while (!delayed_task_queue_.empty());
+void ForegroundTaskRunner::ScheduleIdleTasks(double delay_in_seconds) {
+  std::shared_ptr<ForegroundTaskRunner> self = shared_from_this();
+  auto runIdleTasks = [self]() {
+    if (!self->terminated_) {
+      self->RunIdleTasks();
+    }
+  };
 
-    delayed_lock.unlock();
+  if (delay_in_seconds <= 0) {
+    // The JS queue is FIFO, so this runs once the work queued before it is done.
+    queue_->runOnQueue(std::move(runIdleTasks));
+    return;
+  }
 
-    if (!new_ready_tasks.empty()) {
-      std::lock_guard<std::mutex> lock(queue_access_mutex_);
+  delayed_task_scheduler_.Schedule([self, runIdleTasks]() mutable {
+    if (!self->terminated_) {
+      self->queue_->runOnQueue(std::move(runIdleTasks));
+    }
+  }, delay_in_seconds);
+}
 
-      do {
-        tasks_queue_.push(std::move(new_ready_tasks.front()));
-        new_ready_tasks.pop();
-      } while (!new_ready_tasks.empty());
+void ForegroundTaskRunner::RunIdleTasks() {
+  const double deadline_in_seconds = MonotonicTimeInSeconds() + kIdleTaskBudgetInSeconds;
 
-      tasks_available_cond_.notify_all();
+  while (MonotonicTimeInSeconds() < deadline_in_seconds) {
+    std::unique_ptr<v8::IdleTask> task;
+    {
+      std::lock_guard<std::mutex> lock(idle_tasks_access_mutex_);
+      if (idle_tasks_queue_.empty()) {
+        idle_tasks_scheduled_ = false;
+        return;
+      }
+      task = std::move(idle_tasks_queue_.front());
+      idle_tasks_queue_.pop();
     }
 
-    if (!delayed_task_queue_.empty()) {
-      std::this_thread::sleep_for(std::chrono::seconds(1)); // Wait for a second and loop back and recompute again.
-    } // else loop back and block the thread.
-
+    task->Run(deadline_in_seconds);
   }
 
-  timer_stopped_ = true;
-  timer_stopped_cond_.notify_all();
+  ScheduleIdleTasks(kIdleTaskRetryDelayInSeconds);
 }
 
-void ForegroundTaskRunner::PostTask(std::unique_ptr<v8::Task> task) {
-  // Note :: We assume that the underlying message queue implementation is properly syncronized.
-  std::shared_ptr<v8::Task> s_task(task.release());
-  queue_->runOnQueue([s_task2=std::move(s_task)]() { s_task2->Run(); });
+void ForegroundTaskRunner::Terminate() {
+  terminated_ = true;
+
+  std::lock_guard<std::mutex> lock(idle_tasks_access_mutex_);
+  std::queue<std::unique_ptr<v8::IdleTask>>().swap(idle_tasks_queue_);
 }
 
-V8Platform::V8Platform() : tracing_controller_(std::make_unique<v8::TracingController>()), worker_task_runner_(std::make_unique<WorkerThreadsTaskRunner>()) {}
+V8Platform::V8Platform(int worker_thread_count)
+  : tracing_controller_(std::make_unique<v8::TracingController>()),
+    delayed_task_scheduler_(std::make_unique<DelayedTaskScheduler>()),
+    worker_task_runner_(std::make_unique<WorkerThreadsTaskRunner>(worker_thread_count, *delayed_task_scheduler_)) {}
+
+V8Platform::~V8Platform() {
+  // The timer goes first, its callbacks post to the worker threads.
+  delayed_task_scheduler_.reset();
+  worker_task_runner_.reset();
+}
 
-V8Platform::~V8Platform() {}
+/*static*/ int V8Platform::DefaultWorkerThreadCount() {
+  int hardware_threads = static_cast<int>(std::thread::hardware_concurrency());
+  return std::min(std::max(hardware_threads - 1, 1), kMaxWorkerThreadCount);
+}
 
 std::shared_ptr<v8::TaskRunner> V8Platform::GetForegroundTaskRunner(v8::Isolate* isolate) {
   std::lock_guard<std::mutex> lock(foreground_task_runner_map_access_mutex);
 
   if (foreground_task_runner_map_.find(isolate) == foreground_task_runner_map_.end()) {
     facebook::v8runtime::IsolateData* isolate_data = reinterpret_cast<facebook::v8runtime::IsolateData*>(isolate->GetData(facebook::v8runtime::ISOLATE_DATA_SLOT));
-    foreground_task_runner_map_.insert(std::make_pair(isolate, std::make_shared<ForegroundTaskRunner>(isolate_data->jsQueue_)));
+    foreground_task_runner_map_.insert(std::make_pair(isolate, std::make_shared<ForegroundTaskRunner>(isolate_data->jsQueue_, *delayed_task_scheduler_)));
   }
 
   return foreground_task_runner_map_[isolate];
@@ -168,29 +299,44 @@ void V8Platform::CallOnForegroundThread(v8::Isolate* isolate, v8::Task* task) {
 }
 
 void V8Platform::CallDelayedOnForegroundThread(v8::Isolate* isolate, v8::Task* task, double delay_in_seconds) {
-  // We don't need it as of now.
-  std::abort();
+  GetForegroundTaskRunner(isolate)->PostDelayedTask(std::unique_ptr<v8::Task>(task), delay_in_seconds);
 }
 
 void V8Platform::CallIdleOnForegroundThread(v8::Isolate* isolate, v8::IdleTask* task) {
-  std::abort();
+  GetForegroundTaskRunner(isolate)->PostIdleTask(std::unique_ptr<v8::IdleTask>(task));
 }
 
-bool V8Platform::IdleTasksEnabled(v8::Isolate* isolate) { return false; }
+bool V8Platform::IdleTasksEnabled(v8::Isolate* isolate) { return true; }
 
 
-int V8Platform::NumberOfWorkerThreads() { return 1; }
+int V8Platform::NumberOfWorkerThreads() { return worker_task_runner_->NumberOfWorkerThreads(); }
 
+// V8 expects seconds here, and the idle task deadlines are measured against it.
 double V8Platform::MonotonicallyIncreasingTime() {
-  return static_cast<double>(std::chrono::steady_clock::now().time_since_epoch().count());
+  return MonotonicTimeInSeconds();
 }
 
 double V8Platform::CurrentClockTimeMillis() {
-  return static_cast<double>(std::chrono::system_clock::now().time_since_epoch().count());
+  return std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count();
 }
 
 v8::TracingController* V8Platform::GetTracingController() {
   return tracing_controller_.get();
 }
 
+void V8Platform::NotifyIsolateShutdown(v8::Isolate* isolate) {
+  std::shared_ptr<ForegroundTaskRunner> foreground_task_runner;
+  {
+    std::lock_guard<std::mutex> lock(foreground_task_runner_map_access_mutex);
+    auto it = foreground_task_runner_map_.find(isolate);
+    if (it == foreground_task_runner_map_.end()) {
+      return;
+    }
+    foreground_task_runner = std::move(it->second);
+    foreground_task_runner_map_.erase(it);
+  }
+
+  foreground_task_runner->Terminate();
+}
+
 }}
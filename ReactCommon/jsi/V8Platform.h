@@ -9,33 +9,93 @@
 #include <queue>
 #include <condition_variable>
 #include <cstdlib>
+#include <functional>
+#include <memory>
+#include <vector>
 
 #include <jsi/V8Runtime.h>
 
 namespace facebook {
 namespace v8runtime {
 
-class ForegroundTaskRunner : public v8::TaskRunner {
+// Runs callbacks on a single timer thread once their delay elapsed. Shared by the foreground and worker task runners.
+class DelayedTaskScheduler {
 public:
 
-  ForegroundTaskRunner(std::shared_ptr<facebook::react::MessageQueueThread> queue):queue_(queue){}
+  DelayedTaskScheduler();
+  ~DelayedTaskScheduler();
+
+  void Schedule(std::function<void()> callback, double delay_in_seconds);
+
+private:
+  void TimerFunc();
+
+private:
+
+  using DelayedEntry = std::pair<std::chrono::steady_clock::time_point, std::function<void()>>;
+
+  // Define a comparison operator for the delayed_task_queue_ to make sure
+  // that the callback in the DelayedEntry is not accessed in the priority
+  // queue. This is necessary because we have to move the callback out when we
+  // remove a DelayedEntry from the priority queue.
+  struct DelayedEntryCompare {
+    bool operator()(DelayedEntry& left, DelayedEntry& right) {
+      return left.first > right.first;
+    }
+  };
+
+  std::priority_queue<DelayedEntry, std::vector<DelayedEntry>, DelayedEntryCompare> delayed_task_queue_;
+
+  std::mutex delayed_queue_access_mutex_;
+  std::condition_variable delayed_tasks_available_cond_;
+
+  std::atomic<bool> stop_requested_{ false };
+
+  std::mutex timer_stopped_mutex_;
+  std::condition_variable timer_stopped_cond_;
+  bool timer_stopped_{ false };
+};
+
+// Runs the tasks of one isolate on its JS queue. Idle tasks run behind whatever is queued at the time they are
+// posted, and get a short budget each, so that V8 can do GC work in the gaps between frames.
+class ForegroundTaskRunner : public v8::TaskRunner, public std::enable_shared_from_this<ForegroundTaskRunner> {
+public:
+
+  ForegroundTaskRunner(std::shared_ptr<facebook::react::MessageQueueThread> queue, DelayedTaskScheduler& delayed_task_scheduler)
+    : queue_(queue), delayed_task_scheduler_(delayed_task_scheduler) {}
 
   void PostTask(std::unique_ptr<v8::Task> task) override;
 
-  void PostDelayedTask(std::unique_ptr<v8::Task> task, double delay_in_seconds) override { std::abort(); }
+  void PostDelayedTask(std::unique_ptr<v8::Task> task, double delay_in_seconds) override;
 
-  void PostIdleTask(std::unique_ptr<v8::IdleTask> task) override { std::abort(); }
+  void PostIdleTask(std::unique_ptr<v8::IdleTask> task) override;
+
+  bool IdleTasksEnabled() override { return true; };
+
+  // Drops pending tasks, the isolate they belong to is gone.
+  void Terminate();
+
+private:
+  void PostSharedTask(std::shared_ptr<v8::Task> task);
+  void ScheduleIdleTasks(double delay_in_seconds);
+  void RunIdleTasks();
 
-  bool IdleTasksEnabled() override { return false; };
 private:
 
   std::shared_ptr<facebook::react::MessageQueueThread> queue_;
+  DelayedTaskScheduler& delayed_task_scheduler_;
+
+  std::atomic<bool> terminated_{ false };
+
+  std::mutex idle_tasks_access_mutex_;
+  std::queue<std::unique_ptr<v8::IdleTask>> idle_tasks_queue_;
+  bool idle_tasks_scheduled_{ false };
 };
 
 class WorkerThreadsTaskRunner : public v8::TaskRunner {
 public:
 
-  WorkerThreadsTaskRunner();
+  WorkerThreadsTaskRunner(int thread_count, DelayedTaskScheduler& delayed_task_scheduler);
   ~WorkerThreadsTaskRunner();
 
   void PostTask(std::unique_ptr<v8::Task> task) override;
@@ -46,43 +106,28 @@ public:
 
   bool IdleTasksEnabled() override { return false; };
 
+  int NumberOfWorkerThreads() const { return thread_count_; }
+
 private:
   void WorkerFunc();
-  void TimerFunc();
 
 private:
 
-  using DelayedEntry = std::pair<double, std::unique_ptr<v8::Task>>;
+  const int thread_count_;
+  DelayedTaskScheduler& delayed_task_scheduler_;
 
-  // Define a comparison operator for the delayed_task_queue_ to make sure
-  // that the unique_ptr in the DelayedEntry is not accessed in the priority
-  // queue. This is necessary because we have to reset the unique_ptr when we
-  // remove a DelayedEntry from the priority queue.
-  struct DelayedEntryCompare {
-    bool operator()(DelayedEntry& left, DelayedEntry& right) {
-      return left.first > right.first;
-    }
-  };
-
-  std::priority_queue<DelayedEntry, std::vector<DelayedEntry>, DelayedEntryCompare> delayed_task_queue_;
   std::queue<std::unique_ptr<v8::Task>> tasks_queue_;
 
   std::mutex queue_access_mutex_;
   std::condition_variable tasks_available_cond_;
 
-  std::mutex delayed_queue_access_mutex_;
-  std::condition_variable delayed_tasks_available_cond_;
-
   std::atomic<bool> stop_requested_{ false };
 
-  // TODO -- This should become a semaphore when we support more than one worker thread.
-  std::mutex worker_stopped_mutex_;
-  std::condition_variable worker_stopped_cond_;
-  bool worker_stopped_{ false };
-
-  std::mutex timer_stopped_mutex_;
-  std::condition_variable timer_stopped_cond_;
-  bool timer_stopped_{ false };
+  // Counts down as the worker threads exit. The threads are detached, as joining them from a static destructor
+  // can deadlock on DLL unload.
+  std::mutex workers_stopped_mutex_;
+  std::condition_variable workers_stopped_cond_;
+  int workers_running_{ 0 };
 };
 
 constexpr int ISOLATE_DATA_SLOT = 0;
@@ -97,9 +142,12 @@ struct IsolateData {
 
 class V8Platform : public v8::Platform {
 public:
-  explicit V8Platform();
+  explicit V8Platform(int worker_thread_count = DefaultWorkerThreadCount());
   ~V8Platform() override;
 
+  // Leaves a core to the JS thread, and caps the pool as concurrent compilation and marking gain little beyond that.
+  static int DefaultWorkerThreadCount();
+
   int NumberOfWorkerThreads() override;
 
   std::shared_ptr<v8::TaskRunner> GetForegroundTaskRunner(v8::Isolate* isolate) override;
@@ -117,6 +165,8 @@ public:
   double CurrentClockTimeMillis() override;
   v8::TracingController* GetTracingController() override;
 
+  // Must be called once the isolate is disposed, its pending foreground tasks are dropped.
+  void NotifyIsolateShutdown(v8::Isolate* isolate);
 
 private:
   V8Platform(const V8Platform&) = delete;
@@ -127,6 +177,7 @@ private:
   std::mutex foreground_task_runner_map_access_mutex;
   std::map<v8::Isolate*, std::shared_ptr<ForegroundTaskRunner>> foreground_task_runner_map_;
 
+  std::unique_ptr<DelayedTaskScheduler> delayed_task_scheduler_;
   std::unique_ptr<WorkerThreadsTaskRunner> worker_task_runner_;
 
 public:
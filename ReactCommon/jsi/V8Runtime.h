@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <jsi/jsi.h>
+#include <jsi/ScriptStore.h>
 
 namespace facebook {
   namespace react {
@@ -58,7 +59,9 @@ namespace v8runtime {
     std::unique_ptr<InspectorInterface> inspector = nullptr, /*Optional*/
     std::unique_ptr<const jsi::Buffer> default_snapshot_blob = nullptr, /*Optional*/
     std::unique_ptr<const jsi::Buffer> default_natives_blob = nullptr, /*Optional*/
-    std::unique_ptr<const jsi::Buffer> custom_snapshot = nullptr); /*Optional*/
+    std::unique_ptr<const jsi::Buffer> custom_snapshot = nullptr, /*Optional*/
+    std::unique_ptr<jsi::ScriptStore> scriptStore = nullptr, /*Optional*/
+    std::unique_ptr<jsi::PreparedScriptStore> preparedScriptStore = nullptr); /*Optional*/
 
   std::unique_ptr<jsi::Runtime> makeV8Runtime();
   std::unique_ptr<jsi::Runtime> makeV8Runtime(const folly::dynamic& v8Config, const std::shared_ptr<Logger>& logger);
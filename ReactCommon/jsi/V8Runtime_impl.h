@@ -18,6 +18,7 @@
 #include <atomic>
 #include <list>
 #include <sstream>
+#include <unordered_map>
 
 #include <cstdlib>
 
@@ -48,7 +49,8 @@ namespace facebook { namespace v8runtime {
     V8Runtime(const v8::Platform* platform, std::shared_ptr<Logger>&& logger,
       std::shared_ptr<facebook::react::MessageQueueThread>&& jsQueue, std::shared_ptr<CacheProvider>&& cacheProvider,
       std::unique_ptr<InspectorInterface> inspector, std::unique_ptr<const jsi::Buffer> default_snapshot_blob,
-      std::unique_ptr<const jsi::Buffer> default_natives_blob, std::unique_ptr<const jsi::Buffer> custom_snapshot);
+      std::unique_ptr<const jsi::Buffer> default_natives_blob, std::unique_ptr<const jsi::Buffer> custom_snapshot,
+      std::unique_ptr<jsi::ScriptStore> scriptStore = nullptr, std::unique_ptr<jsi::PreparedScriptStore> preparedScriptStore = nullptr);
 
     ~V8Runtime();
 
@@ -60,12 +62,25 @@ namespace facebook { namespace v8runtime {
 
     bool isInspectable() override;
 
+    // Host objects and host functions whose JS object is still alive, and those which were garbage collected so far.
+    struct HostObjectLifetimeStats {
+      size_t liveCount;
+      size_t collectedCount;
+    };
+    HostObjectLifetimeStats GetHostObjectLifetimeStats() const {
+      return { liveHostObjectLifetimeTrackerCount_, collectedHostObjectLifetimeTrackerCount_ };
+    }
+
   private:
 
     struct IHostProxy {
+      virtual ~IHostProxy() {}
       virtual void destroy() = 0;
     };
 
+    // Owns the proxy of a host object or host function until its JS object is garbage collected or the runtime
+    // is torn down. Trackers are linked into an intrusive list on the runtime, so that a collected tracker can
+    // unlink and delete itself in constant time. Only accessed on the JS thread.
     class HostObjectLifetimeTracker {
     public:
       void ResetHostObject(bool isGC /*whether the call is coming from GC*/) {
@@ -77,25 +92,33 @@ namespace facebook { namespace v8runtime {
         }
       }
 
-      HostObjectLifetimeTracker(V8Runtime& runtime, v8::Local<v8::Object> obj, IHostProxy* hostProxy) : hostProxy_(hostProxy) {
+      HostObjectLifetimeTracker(V8Runtime& runtime, v8::Local<v8::Object> obj, IHostProxy* hostProxy) : runtime_(runtime), hostProxy_(hostProxy) {
         objectTracker_.Reset(runtime.GetIsolate(), obj);
         objectTracker_.SetWeak(this, HostObjectLifetimeTracker::Destroyed, v8::WeakCallbackType::kParameter);
       }
 
-      // Useful for debugging.
       ~HostObjectLifetimeTracker() {
         assert(isReset_);
-        std::cout << "~HostObjectLifetimeTracker" << std::endl;
       }
 
     private:
+      friend class V8Runtime;
+
+      V8Runtime& runtime_;
       v8::Global<v8::Object> objectTracker_;
       std::atomic<bool> isReset_{ false };
-      IHostProxy* hostProxy_;
+      // The JS object can't reach the proxy anymore once it is collected, so the proxy goes with the tracker.
+      std::unique_ptr<IHostProxy> hostProxy_;
+
+      HostObjectLifetimeTracker* previous_{ nullptr };
+      HostObjectLifetimeTracker* next_{ nullptr };
 
       static void CDECL Destroyed(const v8::WeakCallbackInfo<HostObjectLifetimeTracker>& data) {
         v8::HandleScope handle_scope(v8::Isolate::GetCurrent());
-        data.GetParameter()->ResetHostObject(true /*isGC*/);
+        HostObjectLifetimeTracker* tracker = data.GetParameter();
+        tracker->ResetHostObject(true /*isGC*/);
+        tracker->runtime_.RemoveHostObjectLifetimeTracker(tracker);
+        delete tracker;
       }
 
     };
@@ -110,16 +133,19 @@ namespace facebook { namespace v8runtime {
         if (hostObjectProxy == nullptr)
           std::abort();
 
+        // PropNameIDs are strings, symbol keyed properties are left to the object itself.
+        if (!v8PropName->IsString())
+          return;
+
         V8Runtime& runtime = hostObjectProxy->runtime_;
         std::shared_ptr<jsi::HostObject> hostObject = hostObjectProxy->hostObject_;
 
         v8::Local<v8::String> propNameStr = v8::Local<v8::String>::Cast(v8PropName);
-        std::string propName;
-        propName.resize(propNameStr->Utf8Length(info.GetIsolate()));
-        propNameStr->WriteUtf8(info.GetIsolate(), &propName[0]);
-
-        jsi::PropNameID propNameId = runtime.createPropNameIDFromUtf8(reinterpret_cast<uint8_t*>(&propName[0]), propName.length());
-        info.GetReturnValue().Set(runtime.valueRef(hostObject->get(runtime, propNameId)));
+        if (const jsi::PropNameID* cachedPropNameId = runtime.GetCachedPropNameID(propNameStr)) {
+          info.GetReturnValue().Set(runtime.valueRef(hostObject->get(runtime, *cachedPropNameId)));
+        } else {
+          info.GetReturnValue().Set(runtime.valueRef(hostObject->get(runtime, runtime.createPropNameID(propNameStr))));
+        }
       }
 
       static void Set(v8::Local<v8::Name> v8PropName, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<v8::Value>& info)
@@ -130,16 +156,18 @@ namespace facebook { namespace v8runtime {
         if (hostObjectProxy == nullptr)
           std::abort();
 
+        if (!v8PropName->IsString())
+          return;
+
         V8Runtime& runtime = hostObjectProxy->runtime_;
         std::shared_ptr<jsi::HostObject> hostObject = hostObjectProxy->hostObject_;
 
         v8::Local<v8::String> propNameStr = v8::Local<v8::String>::Cast(v8PropName);
-
-        std::string propName;
-        propName.resize(propNameStr->Utf8Length(info.GetIsolate()));
-        propNameStr->WriteUtf8(info.GetIsolate(), &propName[0]);
-
-        hostObject->set(runtime, runtime.createPropNameIDFromUtf8(reinterpret_cast<uint8_t*>(&propName[0]), propName.length()), runtime.createValue(value));
+        if (const jsi::PropNameID* cachedPropNameId = runtime.GetCachedPropNameID(propNameStr)) {
+          hostObject->set(runtime, *cachedPropNameId, runtime.createValue(value));
+        } else {
+          hostObject->set(runtime, runtime.createPropNameID(propNameStr), runtime.createValue(value));
+        }
       }
 
       static void Enumerator(const v8::PropertyCallbackInfo<v8::Array>& info)
@@ -184,21 +212,38 @@ namespace facebook { namespace v8runtime {
 
     class HostFunctionProxy : public IHostProxy {
     public:
+      // Calls with up to this many arguments marshal them on the stack instead of the heap.
+      static constexpr int kMaxStackArgumentCount = 8;
+
       static void call(HostFunctionProxy& hostFunctionProxy, const v8::FunctionCallbackInfo<v8::Value>& callbackInfo) {
-        V8Runtime& runtime = const_cast<V8Runtime&>(hostFunctionProxy.runtime_);
-        v8::Isolate* isolate = callbackInfo.GetIsolate();
+        const int argumentCount = callbackInfo.Length();
+        if (argumentCount <= kMaxStackArgumentCount) {
+          jsi::Value arguments[kMaxStackArgumentCount];
+          for (int i = 0; i < argumentCount; i++) {
+            arguments[i] = hostFunctionProxy.runtime_.createValue(callbackInfo[i]);
+          }
+          call(hostFunctionProxy, callbackInfo, arguments, argumentCount);
+          return;
+        }
 
         std::vector<jsi::Value> argsVector;
-        for (int i = 0; i < callbackInfo.Length(); i++)
+        argsVector.reserve(argumentCount);
+        for (int i = 0; i < argumentCount; i++)
         {
           argsVector.push_back(hostFunctionProxy.runtime_.createValue(callbackInfo[i]));
         }
+        call(hostFunctionProxy, callbackInfo, argsVector.data(), argumentCount);
+      }
+
+      static void call(HostFunctionProxy& hostFunctionProxy, const v8::FunctionCallbackInfo<v8::Value>& callbackInfo, const jsi::Value* arguments, size_t argumentCount) {
+        V8Runtime& runtime = const_cast<V8Runtime&>(hostFunctionProxy.runtime_);
+        v8::Isolate* isolate = callbackInfo.GetIsolate();
 
         const jsi::Value& thisVal = runtime.createValue(callbackInfo.This());
 
         jsi::Value result;
         try {
-          result = hostFunctionProxy.func_(runtime, thisVal, argsVector.data(), callbackInfo.Length());
+          result = hostFunctionProxy.func_(runtime, thisVal, arguments, argumentCount);
         }
         catch (const jsi::JSError& error) {
           callbackInfo.GetReturnValue().Set(v8::Undefined(isolate));
@@ -285,6 +330,35 @@ namespace facebook { namespace v8runtime {
       std::shared_ptr<const jsi::Buffer> buffer_;
     };
 
+    // Owns the code cache produced by v8::ScriptCompiler::CreateCodeCache.
+    class V8CodeCacheBuffer : public jsi::Buffer {
+    public:
+      explicit V8CodeCacheBuffer(std::unique_ptr<v8::ScriptCompiler::CachedData> cachedData)
+        : cachedData_(std::move(cachedData)) {}
+      size_t size() const override { return static_cast<size_t>(cachedData_->length); }
+      const uint8_t* data() const override { return cachedData_->data; }
+
+    private:
+      std::unique_ptr<v8::ScriptCompiler::CachedData> cachedData_;
+    };
+
+    // The source and code cache of a prepared script. It holds no isolate specific state,
+    // hence can be evaluated by any V8Runtime instance running the same V8 version.
+    class V8PreparedJavaScript : public jsi::PreparedJavaScript {
+    public:
+      V8PreparedJavaScript(std::shared_ptr<const jsi::Buffer> source, std::shared_ptr<const jsi::Buffer> codeCache, std::string sourceURL)
+        : source_(std::move(source)), codeCache_(std::move(codeCache)), sourceURL_(std::move(sourceURL)) {}
+
+      const std::shared_ptr<const jsi::Buffer>& source() const { return source_; }
+      const std::shared_ptr<const jsi::Buffer>& codeCache() const { return codeCache_; }
+      const std::string& sourceURL() const { return sourceURL_; }
+
+    private:
+      std::shared_ptr<const jsi::Buffer> source_;
+      std::shared_ptr<const jsi::Buffer> codeCache_; // Can be null if the cache couldn't be produced.
+      std::string sourceURL_;
+    };
+
     std::shared_ptr<const facebook::jsi::PreparedJavaScript> prepareJavaScript(const std::shared_ptr<const facebook::jsi::Buffer> &, std::string) override;
     facebook::jsi::Value evaluatePreparedJavaScript(const std::shared_ptr<const facebook::jsi::PreparedJavaScript> &) override;
 
@@ -364,14 +438,30 @@ namespace facebook { namespace v8runtime {
 
     bool instanceOf(const jsi::Object& o, const jsi::Function& f) override;
 
-  void AddHostObjectLifetimeTracker(std::shared_ptr<HostObjectLifetimeTracker> hostObjectLifetimeTracker);
+  // The runtime takes ownership of the tracker until the tracker removes itself.
+  void AddHostObjectLifetimeTracker(HostObjectLifetimeTracker* hostObjectLifetimeTracker);
+  void RemoveHostObjectLifetimeTracker(HostObjectLifetimeTracker* hostObjectLifetimeTracker);
 
   static void CDECL OnMessage(v8::Local<v8::Message> message, v8::Local<v8::Value> error);
 
+  // Returns the PropNameID for a property name seen by a host object interceptor. V8 internalizes property
+  // names, so the same name arrives as the same string object, and the cache is keyed by that identity.
+  // Entries live as long as the runtime, so the result stays valid across reentrant host calls. Returns
+  // null for a name which is not internalized, or which is not cached once the cache is full.
+  const jsi::PropNameID* GetCachedPropNameID(v8::Local<v8::String> name);
+
   private:
 
     v8::Local<v8::Context> CreateContext(v8::Isolate* isolate);
 
+    v8::Local<v8::String> CreateSourceString(const std::shared_ptr<const jsi::Buffer>& buffer);
+
+    // Helpers for the PreparedScriptStore backed code cache.
+    jsi::ScriptSignature GetScriptSignature(const std::string& sourceURL);
+    static jsi::JSRuntimeSignature GetRuntimeSignature();
+    const char* GetPrepareTag() const;
+    std::shared_ptr<const jsi::Buffer> CreatePreparedCodeCache(const std::shared_ptr<const jsi::Buffer>& buffer, const std::string& sourceURL);
+
     // Methods to compile and execute JS script.
     v8::ScriptCompiler::CachedData* TryLoadCachedData(const std::string& path);
     void PersistCachedData(std::unique_ptr<v8::ScriptCompiler::CachedData> cachedData, const std::string& path);
@@ -419,7 +509,12 @@ namespace facebook { namespace v8runtime {
     v8::Persistent<v8::FunctionTemplate> hostFunctionTemplate_;
     v8::Persistent<v8::Function> hostObjectConstructor_;
 
-    std::list<std::shared_ptr<HostObjectLifetimeTracker>> hostObjectLifetimeTrackerList_;
+    // Keyed by the identity hash of the name, names sharing a hash are told apart by identity.
+    std::unordered_multimap<int, jsi::PropNameID> propNameIdCache_;
+
+    HostObjectLifetimeTracker* hostObjectLifetimeTrackerHead_{ nullptr };
+    size_t liveHostObjectLifetimeTrackerCount_{ 0 };
+    size_t collectedHostObjectLifetimeTrackerCount_{ 0 };
 
     // These are a few configuration parameter used only on Android now.
     bool isCacheEnabled_ {false};
@@ -433,9 +528,13 @@ namespace facebook { namespace v8runtime {
     std::string desc_;
 
     const v8::Platform* platform_;
+    // Set when the runtime runs on the default V8Platform, which has to learn about the isolate going away.
+    V8Platform* v8Platform_{ nullptr };
     std::shared_ptr<Logger> logger_;
 
     std::shared_ptr<CacheProvider> cacheProvider_;
+    std::unique_ptr<jsi::ScriptStore> scriptStore_;
+    std::unique_ptr<jsi::PreparedScriptStore> preparedScriptStore_;
     std::unique_ptr<InspectorInterface> inspector_{nullptr};
 
     std::unique_ptr<const jsi::Buffer> default_snapshot_blob_;
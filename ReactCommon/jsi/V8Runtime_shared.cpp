@@ -43,12 +43,69 @@ namespace facebook { namespace v8runtime {
     const char* ToCString(const v8::String::Utf8Value& value) {
       return *value ? *value : "<string conversion failed>";
     }
+
+    // V8 doesn't expose String::IsInternalized, but internalizing a string returns the very same object if the
+    // string is already the internalized one. Long names are mostly computed, so they aren't looked up at all.
+    bool IsInternalized(v8::Isolate* isolate, v8::Local<v8::String> string) {
+      constexpr int kMaxLength = 64;
+      int length = string->Length();
+      if (length > kMaxLength) {
+        return false;
+      }
+
+      uint16_t buffer[kMaxLength];
+      string->Write(isolate, buffer, 0, length, v8::String::NO_NULL_TERMINATION);
+      v8::Local<v8::String> internalized;
+      return v8::String::NewFromTwoByte(isolate, buffer, v8::NewStringType::kInternalized, length).ToLocal(&internalized) &&
+        internalized == string;
+    }
   } // namespace
 
-  void V8Runtime::AddHostObjectLifetimeTracker(std::shared_ptr<HostObjectLifetimeTracker> hostObjectLifetimeTracker) {
-    // Note that we are letting the list grow in definitely as of now.. The list gets cleaned up when the runtime is teared down.
-    // TODO :: We should remove entries from the list as the objects are garbage collected.
-    hostObjectLifetimeTrackerList_.push_back(hostObjectLifetimeTracker);
+  void V8Runtime::AddHostObjectLifetimeTracker(HostObjectLifetimeTracker* hostObjectLifetimeTracker) {
+    hostObjectLifetimeTracker->next_ = hostObjectLifetimeTrackerHead_;
+    if (hostObjectLifetimeTrackerHead_) {
+      hostObjectLifetimeTrackerHead_->previous_ = hostObjectLifetimeTracker;
+    }
+    hostObjectLifetimeTrackerHead_ = hostObjectLifetimeTracker;
+    liveHostObjectLifetimeTrackerCount_++;
+  }
+
+  void V8Runtime::RemoveHostObjectLifetimeTracker(HostObjectLifetimeTracker* hostObjectLifetimeTracker) {
+    if (hostObjectLifetimeTracker->previous_) {
+      hostObjectLifetimeTracker->previous_->next_ = hostObjectLifetimeTracker->next_;
+    } else {
+      hostObjectLifetimeTrackerHead_ = hostObjectLifetimeTracker->next_;
+    }
+    if (hostObjectLifetimeTracker->next_) {
+      hostObjectLifetimeTracker->next_->previous_ = hostObjectLifetimeTracker->previous_;
+    }
+    hostObjectLifetimeTracker->previous_ = nullptr;
+    hostObjectLifetimeTracker->next_ = nullptr;
+
+    liveHostObjectLifetimeTrackerCount_--;
+    collectedHostObjectLifetimeTrackerCount_++;
+  }
+
+  const jsi::PropNameID* V8Runtime::GetCachedPropNameID(v8::Local<v8::String> name) {
+    // Property names are a small vocabulary in practice, the bound only guards against computed names.
+    constexpr size_t kMaxCachedPropNameIDs = 1024;
+
+    int hash = name->GetIdentityHash();
+    auto range = propNameIdCache_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (static_cast<const V8StringValue*>(getPointerValue(it->second))->v8String_ == name) {
+        return &it->second;
+      }
+    }
+
+    // Names which aren't internalized (e.g. computed ones) aren't cached, as the same name will arrive as
+    // another object next time; they would only take the place of names which are used again.
+    if (propNameIdCache_.size() >= kMaxCachedPropNameIDs || !IsInternalized(GetIsolate(), name)) {
+      return nullptr;
+    }
+
+    // The map is node based, so the entries don't move when it grows.
+    return &propNameIdCache_.emplace(hash, createPropNameID(name))->second;
   }
 
   /*static */void V8Runtime::OnMessage(v8::Local<v8::Message> message, v8::Local<v8::Value> error) {
@@ -77,11 +134,13 @@ namespace facebook { namespace v8runtime {
   V8Runtime::V8Runtime(const v8::Platform* platform, std::shared_ptr<Logger>&& logger,
     std::shared_ptr<facebook::react::MessageQueueThread>&& jsQueue, std::shared_ptr<CacheProvider>&& cacheProvider,
     std::unique_ptr<InspectorInterface> inspector, std::unique_ptr<const jsi::Buffer> default_snapshot_blob,
-    std::unique_ptr<const jsi::Buffer> default_natives_blob, std::unique_ptr<const jsi::Buffer> custom_snapshot)
-    : platform_(platform), logger_(std::move(logger)), cacheProvider_(std::move(cacheProvider)), inspector_(std::move(inspector)), default_snapshot_blob_(std::move(default_snapshot_blob)), default_natives_blob_(std::move(default_natives_blob)), custom_snapshot_blob_(std::move(custom_snapshot)) {
+    std::unique_ptr<const jsi::Buffer> default_natives_blob, std::unique_ptr<const jsi::Buffer> custom_snapshot,
+    std::unique_ptr<jsi::ScriptStore> scriptStore, std::unique_ptr<jsi::PreparedScriptStore> preparedScriptStore)
+    : platform_(platform), logger_(std::move(logger)), cacheProvider_(std::move(cacheProvider)), scriptStore_(std::move(scriptStore)), preparedScriptStore_(std::move(preparedScriptStore)), inspector_(std::move(inspector)), default_snapshot_blob_(std::move(default_snapshot_blob)), default_natives_blob_(std::move(default_natives_blob)), custom_snapshot_blob_(std::move(custom_snapshot)) {
 
     if (!platform_) {
-      platform_ = &V8Platform::Get();
+      v8Platform_ = &V8Platform::Get();
+      platform_ = v8Platform_;
       v8::V8::InitializePlatform(const_cast<v8::Platform*>(platform_));
     }
 
@@ -143,16 +202,26 @@ namespace facebook { namespace v8runtime {
 
   V8Runtime::~V8Runtime() {
 
+    // The cached names hold handles, which have to go before the isolate.
+    propNameIdCache_.clear();
+
     hostObjectConstructor_.Reset();
     context_.Reset();
 
-    for (std::shared_ptr<HostObjectLifetimeTracker> hostObjectLifetimeTracker : hostObjectLifetimeTrackerList_) {
+    while (HostObjectLifetimeTracker* hostObjectLifetimeTracker = hostObjectLifetimeTrackerHead_) {
+      hostObjectLifetimeTrackerHead_ = hostObjectLifetimeTracker->next_;
       hostObjectLifetimeTracker->ResetHostObject(false /*isGC*/);
+      delete hostObjectLifetimeTracker;
     }
+    liveHostObjectLifetimeTrackerCount_ = 0;
 
     isolate_->Exit();
     isolate_->Dispose();
 
+    if (v8Platform_) {
+      v8Platform_->NotifyIsolateShutdown(isolate_);
+    }
+
     delete create_params_.array_buffer_allocator;
 
     {
@@ -170,6 +239,21 @@ namespace facebook { namespace v8runtime {
 
     _ISOLATE_CONTEXT_ENTER
 
+    v8::Local<v8::String> sourceV8String = CreateSourceString(buffer);
+
+    if (cacheProvider_) {
+      v8::Local<v8::String> urlV8String = v8::String::NewFromUtf8(isolate, reinterpret_cast<const char*>(sourceURL.c_str()));
+      std::unique_ptr<const jsi::Buffer> cache{ (*cacheProvider_)(sourceURL) };
+      return ExecuteString(sourceV8String, cache.get(), urlV8String, true);
+    } else {
+      return ExecuteString(sourceV8String, sourceURL);
+    }
+  }
+
+  // Must be called with an active HandleScope.
+  v8::Local<v8::String> V8Runtime::CreateSourceString(const std::shared_ptr<const jsi::Buffer>& buffer) {
+    v8::Isolate* isolate = GetIsolate();
+
     // TODO :: assert if not one byte.
     ExternalOwningOneByteStringResource* external_string_resource = new ExternalOwningOneByteStringResource(buffer);
     v8::Local<v8::String> sourceV8String;
@@ -182,13 +266,7 @@ namespace facebook { namespace v8runtime {
       delete external_string_resource;
     }
 
-    if (cacheProvider_) {
-      v8::Local<v8::String> urlV8String = v8::String::NewFromUtf8(isolate, reinterpret_cast<const char*>(sourceURL.c_str()));
-      std::unique_ptr<const jsi::Buffer> cache{ (*cacheProvider_)(sourceURL) };
-      return ExecuteString(sourceV8String, cache.get(), urlV8String, true);
-    } else {
-      return ExecuteString(sourceV8String, sourceURL);
-    }
+    return sourceV8String;
   }
 
   v8::Local<v8::Context> V8Runtime::CreateContext(v8::Isolate* isolate) {
@@ -239,12 +317,121 @@ namespace facebook { namespace v8runtime {
     }
   }
 
-  std::shared_ptr<const facebook::jsi::PreparedJavaScript>V8Runtime::prepareJavaScript(const std::shared_ptr<const facebook::jsi::Buffer> &, std::string) {
-    throw jsi::JSINativeException("V8Runtime::prepareJavaScript is not implemented!");
+  jsi::ScriptSignature V8Runtime::GetScriptSignature(const std::string& sourceURL) {
+    // Version 0 implies that the script is not versioned, and the prepared script can't be persisted.
+    return { sourceURL, scriptStore_ ? scriptStore_->getScriptVersion(sourceURL) : 0 };
   }
 
-  facebook::jsi::Value V8Runtime::evaluatePreparedJavaScript(const std::shared_ptr<const facebook::jsi::PreparedJavaScript> &) {
-    throw jsi::JSINativeException("V8Runtime::evaluatePreparedJavaScript is not implemented!");
+  /*static */jsi::JSRuntimeSignature V8Runtime::GetRuntimeSignature() {
+    // V8 only accepts code cache produced by the exact same build, hence all the version components go into the key.
+    return { "V8",
+      (static_cast<jsi::JSRuntimeVersion_t>(V8_MAJOR_VERSION) << 48) |
+      (static_cast<jsi::JSRuntimeVersion_t>(V8_MINOR_VERSION) << 32) |
+      (static_cast<jsi::JSRuntimeVersion_t>(V8_BUILD_NUMBER) << 16) |
+      static_cast<jsi::JSRuntimeVersion_t>(V8_PATCH_LEVEL) };
+  }
+
+  const char* V8Runtime::GetPrepareTag() const {
+    return shouldProduceFullCache_ ? "V8FullCodeCache" : "V8CodeCache";
+  }
+
+  std::shared_ptr<const jsi::Buffer> V8Runtime::CreatePreparedCodeCache(const std::shared_ptr<const jsi::Buffer>& buffer, const std::string& sourceURL) {
+    _ISOLATE_CONTEXT_ENTER
+    v8::TryCatch try_catch(isolate);
+    v8::Local<v8::String> urlV8String = v8::String::NewFromUtf8(isolate, sourceURL.c_str(), v8::NewStringType::kNormal).ToLocalChecked();
+    v8::ScriptOrigin origin(urlV8String);
+    v8::ScriptCompiler::Source source(CreateSourceString(buffer), origin);
+
+    // Eagerly compiling all the functions makes the cache bigger, but saves the lazy compilation of functions on subsequent runs.
+    v8::ScriptCompiler::CompileOptions options = shouldProduceFullCache_ ? v8::ScriptCompiler::kEagerCompile : v8::ScriptCompiler::kNoCompileOptions;
+
+    v8::Local<v8::UnboundScript> unboundScript;
+    if (!v8::ScriptCompiler::CompileUnboundScript(isolate, &source, options).ToLocal(&unboundScript)) {
+      ReportException(&try_catch);
+    }
+
+    // CreateCodeCache always create buffer with BufferPolicy::BufferOwned.
+    std::unique_ptr<v8::ScriptCompiler::CachedData> cachedData{ v8::ScriptCompiler::CreateCodeCache(unboundScript) };
+    if (!cachedData) {
+      Log("Code cache creation failed for " + sourceURL, 2 /*logLevel warning*/);
+      return nullptr;
+    }
+
+    return std::make_shared<V8CodeCacheBuffer>(std::move(cachedData));
+  }
+
+  std::shared_ptr<const facebook::jsi::PreparedJavaScript> V8Runtime::prepareJavaScript(const std::shared_ptr<const facebook::jsi::Buffer>& buffer, std::string sourceURL) {
+    jsi::ScriptSignature scriptSignature = GetScriptSignature(sourceURL);
+    jsi::JSRuntimeSignature runtimeSignature = GetRuntimeSignature();
+    const char* prepareTag = GetPrepareTag();
+
+    bool canUsePreparedScriptStore = preparedScriptStore_ && scriptSignature.version != 0;
+
+    std::shared_ptr<const jsi::Buffer> codeCache;
+    if (canUsePreparedScriptStore) {
+      codeCache = preparedScriptStore_->tryGetPreparedScript(scriptSignature, runtimeSignature, prepareTag);
+    }
+
+    if (!codeCache) {
+      codeCache = CreatePreparedCodeCache(buffer, sourceURL);
+
+      if (codeCache && canUsePreparedScriptStore) {
+        preparedScriptStore_->persistPreparedScript(codeCache, scriptSignature, runtimeSignature, prepareTag);
+      }
+    }
+
+    return std::make_shared<V8PreparedJavaScript>(buffer, std::move(codeCache), std::move(sourceURL));
+  }
+
+  facebook::jsi::Value V8Runtime::evaluatePreparedJavaScript(const std::shared_ptr<const facebook::jsi::PreparedJavaScript>& js) {
+    // PreparedJavaScript can only be created by V8Runtime::prepareJavaScript.
+    const V8PreparedJavaScript* prepared = static_cast<const V8PreparedJavaScript*>(js.get());
+
+    _ISOLATE_CONTEXT_ENTER
+    v8::TryCatch try_catch(isolate);
+    v8::Local<v8::Context> context(isolate->GetCurrentContext());
+    v8::Local<v8::String> urlV8String = v8::String::NewFromUtf8(isolate, prepared->sourceURL().c_str(), v8::NewStringType::kNormal).ToLocalChecked();
+    v8::ScriptOrigin origin(urlV8String);
+
+    v8::ScriptCompiler::CompileOptions options = v8::ScriptCompiler::kNoCompileOptions;
+    v8::ScriptCompiler::CachedData* cachedData = nullptr;
+    if (prepared->codeCache()) {
+      // The cache bytes are owned by the prepared script which outlives the compilation.
+      cachedData = new v8::ScriptCompiler::CachedData(prepared->codeCache()->data(), static_cast<int>(prepared->codeCache()->size()), v8::ScriptCompiler::CachedData::BufferNotOwned);
+      options = v8::ScriptCompiler::kConsumeCodeCache;
+    }
+
+    // No need to delete cachedData as ScriptCompiler::Source will take its ownership.
+    v8::ScriptCompiler::Source source(CreateSourceString(prepared->source()), origin, cachedData);
+
+    v8::Local<v8::Script> script;
+    if (!v8::ScriptCompiler::Compile(context, &source, options).ToLocal(&script)) {
+      ReportException(&try_catch);
+    }
+
+    if (cachedData && cachedData->rejected) {
+      // V8 fell back to a full compile. The stale entry is replaced with a cache of this compilation, so later launches don't pay for it again.
+      Log("Code cache rejected for " + prepared->sourceURL(), 2 /*logLevel warning*/);
+
+      jsi::ScriptSignature scriptSignature = GetScriptSignature(prepared->sourceURL());
+      if (preparedScriptStore_ && scriptSignature.version != 0) {
+        // CreateCodeCache always create buffer with BufferPolicy::BufferOwned.
+        std::unique_ptr<v8::ScriptCompiler::CachedData> newCachedData{ v8::ScriptCompiler::CreateCodeCache(script->GetUnboundScript()) };
+        if (newCachedData) {
+          preparedScriptStore_->persistPreparedScript(std::make_shared<V8CodeCacheBuffer>(std::move(newCachedData)), scriptSignature, GetRuntimeSignature(), GetPrepareTag());
+        } else {
+          Log("Code cache creation failed for " + prepared->sourceURL(), 2 /*logLevel warning*/);
+        }
+      }
+    }
+
+    v8::Local<v8::Value> result;
+    if (!script->Run(context).ToLocal(&result)) {
+      assert(try_catch.HasCaught());
+      ReportException(&try_catch);
+    }
+
+    return createValue(result);
   }
 
   void V8Runtime::ReportException(v8::TryCatch* try_catch) {
@@ -455,7 +642,7 @@ namespace facebook { namespace v8runtime {
 
     newObject->SetInternalField(0, v8::Local<v8::External>::New(GetIsolate(), v8::External::New(GetIsolate(), hostObjectProxy)));
 
-   AddHostObjectLifetimeTracker(std::make_shared<HostObjectLifetimeTracker>(*this, newObject, hostObjectProxy));
+   AddHostObjectLifetimeTracker(new HostObjectLifetimeTracker(*this, newObject, hostObjectProxy));
 
   return createObject(newObject);
   }
@@ -585,7 +772,7 @@ namespace facebook { namespace v8runtime {
       throw jsi::JSError(*this, "Creation of HostFunction failed.");
     }
 
-  AddHostObjectLifetimeTracker(std::make_shared<HostObjectLifetimeTracker>(*this, newFunction, hostFunctionProxy));
+  AddHostObjectLifetimeTracker(new HostObjectLifetimeTracker(*this, newFunction, hostFunctionProxy));
 
   return createObject(newFunction).getFunction(*this);
   }
@@ -756,9 +943,10 @@ namespace facebook { namespace v8runtime {
   std::unique_ptr<jsi::Runtime> makeV8Runtime(const v8::Platform* platform, std::shared_ptr<Logger>&& logger,
     std::shared_ptr<facebook::react::MessageQueueThread>&& jsQueue, std::shared_ptr<CacheProvider>&& cacheProvider,
     std::unique_ptr<InspectorInterface> inspector, std::unique_ptr<const jsi::Buffer> default_snapshot_blob,
-    std::unique_ptr<const jsi::Buffer> default_natives_blob, std::unique_ptr<const jsi::Buffer> custom_snapshot) {
+    std::unique_ptr<const jsi::Buffer> default_natives_blob, std::unique_ptr<const jsi::Buffer> custom_snapshot,
+    std::unique_ptr<jsi::ScriptStore> scriptStore, std::unique_ptr<jsi::PreparedScriptStore> preparedScriptStore) {
     return std::make_unique<V8Runtime>(platform, std::move(logger), std::move(jsQueue), std::move(cacheProvider), std::move(inspector)
-      , std::move(default_snapshot_blob), std::move(default_natives_blob), std::move(custom_snapshot));
+      , std::move(default_snapshot_blob), std::move(default_natives_blob), std::move(custom_snapshot), std::move(scriptStore), std::move(preparedScriptStore));
   }
 
   std::unique_ptr<jsi::Runtime> makeV8Runtime() {
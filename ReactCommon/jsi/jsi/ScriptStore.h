@@ -29,6 +29,8 @@ struct JSRuntimeSignature {
 // Embedders can provide an instance of this interface (through JSI::Runtime implementation's factory method),
 // to enable persistance of the prepared script and retrieval on subsequent evaluation of a script.
 struct PreparedScriptStore {
+  virtual ~PreparedScriptStore() = default;
+
   // Try to retrieve the prepared javascript for a given combination of script & runtime.
   // scriptSignature : Javascript url and version
   // RuntimeSignature : Javascript engine type and version
@@ -57,6 +59,8 @@ struct PreparedScriptStore {
 // JSI::Runtime implementation must be provided an instance on this interface to enable version sensitive capabilities such as usage of pre-prepared javascript script.
 // Alternatively, this entity can be used to directly provide the Javascript buffer and rich metadata to the JSI::Runtime instance.
 struct ScriptStore {
+  virtual ~ScriptStore() = default;
+
   // Return the Javascript buffer and version corresponding to a given url.
   virtual VersionedBuffer getVersionedScript(const std::string& url) noexcept = 0;
 
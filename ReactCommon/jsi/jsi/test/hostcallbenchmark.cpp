@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <jsi/test/testlib.h>
+#include <gtest/gtest.h>
+#include <jsi/jsi.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace facebook::jsi;
+
+// Measures the overhead of calls from JS into native, which TurboModules and
+// host objects pay on every method call and property access. The loops run
+// in JS, so the numbers cover the runtime's marshalling and not the call
+// from native into JS. Run with --gtest_filter=Runtimes/JSIHostCallBenchmark.*
+class JSIHostCallBenchmark : public JSITestBase {
+ protected:
+  static constexpr int kIterations = 200000;
+
+  void report(const char* name, std::chrono::steady_clock::duration elapsed) {
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    double callsPerSecond = seconds > 0 ? kIterations / seconds : 0;
+    std::cout << name << ": " << static_cast<long long>(callsPerSecond)
+              << " calls/s" << std::endl;
+    RecordProperty(name, std::to_string(static_cast<long long>(callsPerSecond)));
+  }
+
+  void benchmarkHostFunction(const char* name, const std::string& args) {
+    int calls = 0;
+    rt.global().setProperty(
+        rt,
+        "hostFunction",
+        Function::createFromHostFunction(
+            rt,
+            PropNameID::forAscii(rt, "hostFunction"),
+            0,
+            [&calls](Runtime&, const Value&, const Value* a, size_t count) {
+              calls++;
+              return count > 0 ? Value(a[0].getNumber()) : Value(0);
+            }));
+    Function loop = function(
+        "function(n) { var r = 0; for (var i = 0; i < n; i++) { r += hostFunction(" +
+        args + "); } return r; }");
+
+    auto start = std::chrono::steady_clock::now();
+    loop.call(rt, kIterations);
+    report(name, std::chrono::steady_clock::now() - start);
+
+    EXPECT_EQ(calls, kIterations);
+  }
+};
+
+constexpr int JSIHostCallBenchmark::kIterations;
+
+TEST_P(JSIHostCallBenchmark, HostFunctionNoArguments) {
+  benchmarkHostFunction("HostFunctionNoArguments", "");
+}
+
+TEST_P(JSIHostCallBenchmark, HostFunctionThreeArguments) {
+  benchmarkHostFunction("HostFunctionThreeArguments", "i, 'a', true");
+}
+
+TEST_P(JSIHostCallBenchmark, HostFunctionTwelveArguments) {
+  benchmarkHostFunction(
+      "HostFunctionTwelveArguments", "i, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11");
+}
+
+TEST_P(JSIHostCallBenchmark, HostObjectGet) {
+  class CountingHostObject : public HostObject {
+   public:
+    Value get(Runtime&, const PropNameID&) override {
+      return ++gets;
+    }
+
+    int gets = 0;
+  };
+
+  auto hostObject = std::make_shared<CountingHostObject>();
+  Function loop = function(
+      "function(obj, n) { var r = 0; for (var i = 0; i < n; i++) { r += obj.someProperty; } return r; }");
+
+  auto start = std::chrono::steady_clock::now();
+  loop.call(rt, Object::createFromHostObject(rt, hostObject), kIterations);
+  report("HostObjectGet", std::chrono::steady_clock::now() - start);
+
+  EXPECT_EQ(hostObject->gets, kIterations);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    Runtimes,
+    JSIHostCallBenchmark,
+    ::testing::ValuesIn(runtimeGenerators()));
@@ -748,6 +748,160 @@ TEST_P(JSITest, HostFunctionTest) {
                   .getBool());
 }
 
+TEST_P(JSITest, HostFunctionArgumentCountTest) {
+  // Runtimes may marshal short and long argument lists differently; all of
+  // them have to arrive complete and in order.
+  Function join = Function::createFromHostFunction(
+      rt,
+      PropNameID::forAscii(rt, "join"),
+      0,
+      [](Runtime& rt, const Value& thisVal, const Value* args, size_t count) {
+        std::string result;
+        for (size_t i = 0; i < count; i++) {
+          result += (i > 0 ? "," : "") + args[i].toString(rt).utf8(rt);
+        }
+        return String::createFromUtf8(rt, result);
+      });
+  rt.global().setProperty(rt, "join", join);
+
+  EXPECT_EQ(eval("join()").getString(rt).utf8(rt), "");
+  EXPECT_EQ(
+      eval("join(1, 2, 3, 4, 5, 6, 7, 8)").getString(rt).utf8(rt),
+      "1,2,3,4,5,6,7,8");
+  EXPECT_EQ(
+      eval("join(1, 2, 3, 4, 5, 6, 7, 8, 9)").getString(rt).utf8(rt),
+      "1,2,3,4,5,6,7,8,9");
+  EXPECT_EQ(
+      eval("join(1, 'a', true, null, undefined, {}, [2], 8, 9, 10, 11, 'z')")
+          .getString(rt)
+          .utf8(rt),
+      "1,a,true,null,undefined,[object Object],2,8,9,10,11,z");
+
+  std::string expected;
+  for (int i = 0; i < 100; i++) {
+    expected += (i > 0 ? "," : "") + std::to_string(i);
+  }
+  EXPECT_EQ(
+      eval("join.apply(null, Array.from({length: 100}, (_, i) => i))")
+          .getString(rt)
+          .utf8(rt),
+      expected);
+}
+
+TEST_P(JSITest, HostObjectReentrantPropNameTest) {
+  // Reads the property named by the rest of its name (through JS) before it
+  // returns, so "abc" reads "bc", which reads "c". The name it was called
+  // with has to stay valid across the nested accesses.
+  class ReentrantHostObject : public HostObject {
+   public:
+    Value get(Runtime& rt, const PropNameID& name) override {
+      std::string utf8 = name.utf8(rt);
+      if (utf8.size() <= 1) {
+        return String::createFromUtf8(rt, utf8);
+      }
+      std::string nested = rt.global()
+                               .getPropertyAsFunction(rt, "readFromObj")
+                               .call(rt, utf8.substr(1))
+                               .getString(rt)
+                               .utf8(rt);
+      EXPECT_EQ(name.utf8(rt), utf8);
+      return String::createFromUtf8(rt, name.utf8(rt) + "|" + nested);
+    }
+  };
+
+  rt.global().setProperty(
+      rt,
+      "obj",
+      Object::createFromHostObject(
+          rt, std::make_shared<ReentrantHostObject>()));
+  eval("readFromObj = function(name) { return obj[name]; }");
+
+  // The second round reads names which have been seen before.
+  for (int round = 0; round < 2; round++) {
+    EXPECT_EQ(eval("obj.abc").getString(rt).utf8(rt), "abc|bc|c");
+    EXPECT_EQ(eval("obj.bc").getString(rt).utf8(rt), "bc|c");
+    EXPECT_EQ(eval("obj.cbc").getString(rt).utf8(rt), "cbc|bc|c");
+  }
+}
+
+TEST_P(JSITest, HostObjectManyPropNamesTest) {
+  // More distinct names than a runtime would reasonably keep around.
+  class EchoHostObject : public HostObject {
+   public:
+    Value get(Runtime& rt, const PropNameID& name) override {
+      return String::createFromUtf8(rt, name.utf8(rt));
+    }
+
+    void set(Runtime& rt, const PropNameID& name, const Value& value)
+        override {
+      values[name.utf8(rt)] = value.getNumber();
+    }
+
+    std::unordered_map<std::string, double> values;
+  };
+
+  auto echo = std::make_shared<EchoHostObject>();
+  EXPECT_TRUE(function(
+                  "function (obj) {"
+                  "  for (var round = 0; round < 2; round++) {"
+                  "    for (var i = 0; i < 3000; i++) {"
+                  "      if (obj['p' + i] !== 'p' + i) { return false; }"
+                  "      obj['p' + i] = i + round;"
+                  "    }"
+                  "  }"
+                  "  return obj.p0 === 'p0' && obj.p2999 === 'p2999';"
+                  "}")
+                  .call(rt, Object::createFromHostObject(rt, echo))
+                  .getBool());
+  EXPECT_EQ(echo->values.size(), 3000);
+  EXPECT_EQ(echo->values["p0"], 1);
+  EXPECT_EQ(echo->values["p1023"], 1024);
+  EXPECT_EQ(echo->values["p2999"], 3000);
+}
+
+TEST_P(JSITest, HostObjectSymbolKeyTest) {
+  if (!rt.global().hasProperty(rt, "Symbol")) {
+    return;
+  }
+
+  class CountingHostObject : public HostObject {
+   public:
+    Value get(Runtime&, const PropNameID&) override {
+      gets++;
+      return 1;
+    }
+
+    void set(Runtime&, const PropNameID&, const Value&) override {
+      sets++;
+    }
+
+    int gets = 0;
+    int sets = 0;
+  };
+
+  // Symbols are not property names, so accesses with them are left to the
+  // object itself.
+  auto counting = std::make_shared<CountingHostObject>();
+  Object obj = Object::createFromHostObject(rt, counting);
+  EXPECT_TRUE(function(
+                  "function (obj) {"
+                  "  var s = Symbol('s');"
+                  "  var before = obj[s];"
+                  "  obj[s] = 2;"
+                  "  return before === undefined && obj[s] === 2;"
+                  "}")
+                  .call(rt, obj)
+                  .getBool());
+  EXPECT_EQ(counting->gets, 0);
+  EXPECT_EQ(counting->sets, 0);
+
+  EXPECT_TRUE(function("function (obj) { obj.s = 2; return obj.s === 1; }")
+                  .call(rt, obj)
+                  .getBool());
+  EXPECT_EQ(counting->gets, 1);
+  EXPECT_EQ(counting->sets, 1);
+}
+
 TEST_P(JSITest, ValueTest) {
   EXPECT_TRUE(checkValue(Value::undefined(), "undefined"));
   EXPECT_TRUE(checkValue(Value(), "undefined"));
@@ -5,9 +5,17 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#pragma once
+
+#include <algorithm>
+#include <atomic>
 #include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
 
 #include <better/optional.h>
 #include <folly/container/EvictingCacheMap.h>
@@ -17,11 +25,43 @@ namespace react {
 
 /*
  * Simple thread-safe LRU cache.
+ * `maxSize` is the default capacity, which can be overridden on construction.
+ *
+ * Large caches are split into shards (each one is a separate LRU cache with
+ * its own lock) selected by the hash of a key, so threads which access
+ * different keys rarely contend. Values are generated without holding any
+ * lock; concurrent misses on the same key wait for a single generation.
  */
 template<typename KeyT, typename ValueT, int maxSize>
 class SimpleThreadSafeCache {
 public:
-  SimpleThreadSafeCache() : map_{maxSize} {}
+  /*
+   * Counters of cache accesses since the cache was created.
+   * A `get` call which waits for a value being generated by another thread
+   * counts as a hit.
+   */
+  struct Statistics {
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+  };
+
+  SimpleThreadSafeCache() : SimpleThreadSafeCache(maxSize) {}
+
+  explicit SimpleThreadSafeCache(int capacity) {
+    assert(capacity > 0 && "Capacity must be positive.");
+
+    // Small caches are not split, so they stay exact LRU caches.
+    auto shardCount = std::max(
+        std::min(capacity / kMinimumShardCapacity, kMaximumShardCount), 1);
+    shards_.reserve(shardCount);
+    for (int index = 0; index < shardCount; index++) {
+      // Distributes the capacity evenly; the first shards get the remainder.
+      auto shardCapacity =
+          capacity / shardCount + (index < capacity % shardCount ? 1 : 0);
+      shards_.push_back(std::make_unique<Shard>(shardCapacity));
+    }
+  }
 
   /*
    * Returns a value from the map with a given key.
@@ -30,15 +70,110 @@ public:
    * Can be called from any thread.
    */
   ValueT get(const KeyT &key, std::function<ValueT(const KeyT &key)> generator) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto iterator = map_.find(key);
-    if (iterator == map_.end()) {
+    auto &shard = shardForKey(key);
+
+    std::unique_lock<std::mutex> lock(shard.mutex);
+    auto iterator = shard.map.find(key);
+    if (iterator != shard.map.end()) {
+      hits_++;
+      return iterator->second;
+    }
+
+    auto inflightIterator = shard.inflight.find(key);
+    if (inflightIterator != shard.inflight.end()) {
+      auto future = inflightIterator->second;
+      hits_++;
+      lock.unlock();
+      return future.get();
+    }
+
+    misses_++;
+    auto promise = std::promise<ValueT>{};
+    shard.inflight.emplace(key, promise.get_future().share());
+    lock.unlock();
+
+    try {
       auto value = generator(key);
-      map_.set(key, value);
+      lock.lock();
+      setLocked(shard, key, value);
+      shard.inflight.erase(key);
+      lock.unlock();
+      promise.set_value(value);
       return value;
+    } catch (...) {
+      if (!lock.owns_lock()) {
+        lock.lock();
+      }
+      shard.inflight.erase(key);
+      lock.unlock();
+      promise.set_exception(std::current_exception());
+      throw;
     }
+  }
 
-    return iterator->second;
+  /*
+   * Generates values for all given keys which are neither stored in the cache
+   * nor being generated at the moment, using a single call of given
+   * generator function, and stores them inside a cache. The generator gets
+   * the missing keys and must return their values in the same order.
+   * Concurrent `get` calls with these keys wait for the generation.
+   * If the generator throws or returns a wrong number of values, nothing is
+   * stored, the waiting `get` calls fail and the exception is rethrown
+   * (`std::length_error` for the wrong number of values).
+   * Does not affect statistics (as it does not return anything).
+   * Can be called from any thread.
+   */
+  void generate(
+      const std::vector<KeyT> &keys,
+      std::function<std::vector<ValueT>(const std::vector<KeyT> &keys)>
+          generator) const {
+    auto missingKeys = std::vector<KeyT>{};
+    auto promises = std::vector<std::promise<ValueT>>{};
+    for (const auto &key : keys) {
+      auto &shard = shardForKey(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      if (shard.map.exists(key) ||
+          shard.inflight.find(key) != shard.inflight.end()) {
+        continue;
+      }
+
+      promises.emplace_back();
+      shard.inflight.emplace(key, promises.back().get_future().share());
+      missingKeys.push_back(key);
+    }
+
+    if (missingKeys.empty()) {
+      return;
+    }
+
+    auto values = std::vector<ValueT>{};
+    try {
+      values = generator(missingKeys);
+      if (values.size() != missingKeys.size()) {
+        throw std::length_error(
+            "The generator must return a value for every key.");
+      }
+    } catch (...) {
+      for (size_t index = 0; index < missingKeys.size(); index++) {
+        auto &shard = shardForKey(missingKeys[index]);
+        {
+          std::lock_guard<std::mutex> lock(shard.mutex);
+          shard.inflight.erase(missingKeys[index]);
+        }
+        promises[index].set_exception(std::current_exception());
+      }
+      throw;
+    }
+
+    for (size_t index = 0; index < missingKeys.size(); index++) {
+      auto &shard = shardForKey(missingKeys[index]);
+      {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        setLocked(shard, missingKeys[index], values[index]);
+        shard.inflight.erase(missingKeys[index]);
+      }
+      promises[index].set_value(values[index]);
+    }
   }
 
   /*
@@ -47,12 +182,15 @@ public:
    * Can be called from any thread.
    */
   better::optional<ValueT> get(const KeyT &key) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto iterator = map_.find(key);
-    if (iterator == map_.end()) {
+    auto &shard = shardForKey(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto iterator = shard.map.find(key);
+    if (iterator == shard.map.end()) {
+      misses_++;
       return {};
     }
 
+    hits_++;
     return iterator->second;
   }
 
@@ -61,14 +199,59 @@ public:
    * Can be called from any thread.
    */
   void set(const KeyT &key, const ValueT &value) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    map_.set(std::move(key), std::move(value));
+    auto &shard = shardForKey(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    setLocked(shard, key, value);
+  }
+
+  /*
+   * Returns the counters of cache accesses.
+   * Can be called from any thread.
+   */
+  Statistics getStatistics() const {
+    return {hits_, misses_, evictions_};
   }
 
 private:
-  mutable folly::EvictingCacheMap<KeyT, ValueT> map_;
-  mutable std::mutex mutex_;
+  static constexpr int kMinimumShardCapacity = 32;
+  static constexpr int kMaximumShardCount = 8;
+
+  struct Shard {
+    explicit Shard(int capacity) : capacity(capacity), map{(size_t)capacity} {}
+
+    const size_t capacity;
+    std::mutex mutex;
+    // Protected by `mutex`.
+    folly::EvictingCacheMap<KeyT, ValueT> map;
+    // Values which are being generated at the moment. Protected by `mutex`.
+    std::unordered_map<KeyT, std::shared_future<ValueT>> inflight;
+  };
+
+  Shard &shardForKey(const KeyT &key) const {
+    if (shards_.size() == 1) {
+      return *shards_.front();
+    }
+    return *shards_[std::hash<KeyT>{}(key) % shards_.size()];
+  }
+
+  void setLocked(Shard &shard, const KeyT &key, const ValueT &value) const {
+    if (shard.map.size() == shard.capacity && !shard.map.exists(key)) {
+      evictions_++;
+    }
+    shard.map.set(key, value);
+  }
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  mutable std::atomic<size_t> hits_{0};
+  mutable std::atomic<size_t> misses_{0};
+  mutable std::atomic<size_t> evictions_{0};
 };
 
+template<typename KeyT, typename ValueT, int maxSize>
+constexpr int SimpleThreadSafeCache<KeyT, ValueT, maxSize>::kMinimumShardCapacity;
+
+template<typename KeyT, typename ValueT, int maxSize>
+constexpr int SimpleThreadSafeCache<KeyT, ValueT, maxSize>::kMaximumShardCount;
+
 } // namespace react
 } // namespace facebook
@@ -23,5 +23,26 @@ LOCAL_SHARED_LIBRARIES := libfolly_json libv8
 
 include $(BUILD_STATIC_LIBRARY)
 
+# Unit tests, built with the googletest module of the NDK. Run the binary on
+# a device or an emulator (e.g. with `adb push` and `adb shell`).
+include $(CLEAR_VARS)
+
+LOCAL_MODULE := v8helpers_tests
+
+LOCAL_SRC_FILES := \
+  tests/V8UtilsTest.cpp \
+
+LOCAL_CFLAGS := \
+  -DLOG_TAG=\"ReactNative\"
+
+LOCAL_CXXFLAGS += -frtti -fexceptions
+LOCAL_CFLAGS += $(CXX14_FLAGS)
+
+LOCAL_STATIC_LIBRARIES := v8helpers googletest_main
+LOCAL_SHARED_LIBRARIES := libfolly_json libv8 libv8platform libv8base
+
+include $(BUILD_EXECUTABLE)
+
 $(call import-module,folly)
 $(call import-module,v8)
+$(call import-module,third_party/googletest)
@@ -1,5 +1,9 @@
 #include "V8Utils.h"
 
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
 namespace v8 {
 
 static const char TAG[] = "V8Application";
@@ -87,14 +91,195 @@ Local<Value> fromJsonString(Local<Context> context, const Local<String> &jsonStr
 }
 
 Local<Value> fromDynamic(Isolate *isolate, Local<v8::Context> context, const folly::dynamic &value) {
-    const std::string &json = folly::toJson(std::move(value));
-    Local<Value> result;
-    if (v8::JSON::Parse(context, toLocalString(isolate, std::move(json))).ToLocal(&result)) {
-        return result;
+    switch (value.type()) {
+        case folly::dynamic::NULLT:
+            return Null(isolate);
+        case folly::dynamic::BOOL:
+            return Boolean::New(isolate, value.getBool());
+        case folly::dynamic::INT64:
+            return Number::New(isolate, static_cast<double>(value.getInt()));
+        case folly::dynamic::DOUBLE:
+            return Number::New(isolate, value.getDouble());
+        case folly::dynamic::STRING:
+            return toLocalString(isolate, value.getString());
+        case folly::dynamic::ARRAY: {
+            Local<Array> array = Array::New(isolate, static_cast<int>(value.size()));
+            for (size_t i = 0; i < value.size(); i++) {
+                array->Set(context, static_cast<uint32_t>(i), fromDynamic(isolate, context, value[i])).FromJust();
+            }
+            return array;
+        }
+        case folly::dynamic::OBJECT: {
+            Local<Object> object = Object::New(isolate);
+            for (const auto &item : value.items()) {
+                object->Set(context, toLocalString(isolate, item.first.asString()), fromDynamic(isolate, context, item.second)).FromJust();
+            }
+            return object;
+        }
     }
     return Local<Value>();
 }
 
+namespace {
+
+// Bridge payloads are shallow; the limit keeps malformed ones from exhausting the native stack.
+const size_t kMaxToDynamicDepth = 256;
+
+// JSON.stringify skips these in objects and writes null for them in arrays.
+bool isJsonUnrepresentable(const Local<Value> &value) {
+    return value->IsUndefined() || value->IsFunction() || value->IsSymbol();
+}
+
+class DynamicConverter {
+public:
+    DynamicConverter(Isolate *isolate, Local<v8::Context> context)
+        : isolate_(isolate), context_(context), toJsonKey_(toLocalString(isolate, "toJSON")) {}
+
+    // Returns false if JSON.stringify would skip the value.
+    bool convert(Local<Value> value, Local<Value> key, folly::dynamic &result) {
+        value = toJsonValue(value, key);
+        if (value.IsEmpty() || value->IsNull()) {
+            result = nullptr;
+            return true;
+        }
+        if (isJsonUnrepresentable(value)) {
+            return false;
+        }
+        if (value->IsBoolean()) {
+            result = value->IsTrue();
+            return true;
+        }
+        if (value->IsInt32()) {
+            result = static_cast<int64_t>(Local<Int32>::Cast(value)->Value());
+            return true;
+        }
+        if (value->IsNumber()) {
+            result = toDynamic(Local<Number>::Cast(value)->Value());
+            return true;
+        }
+        if (value->IsString()) {
+            result = toStdString(Local<String>::Cast(value));
+            return true;
+        }
+        if (!value->IsObject()) {
+            result = nullptr;
+            return true;
+        }
+
+        Local<Object> object = Local<Object>::Cast(value);
+        enter(object);
+        if (value->IsArray()) {
+            result = convertArray(Local<Array>::Cast(object));
+        } else {
+            result = convertObject(object);
+        }
+        ancestors_.pop_back();
+        return true;
+    }
+
+private:
+    static folly::dynamic toDynamic(double number) {
+        if (!std::isfinite(number)) {
+            return nullptr;
+        }
+        // Matches folly::parseJson, which reads integral JSON numbers as int64.
+        if (std::trunc(number) == number && std::fabs(number) <= 9007199254740992.0) {
+            return static_cast<int64_t>(number);
+        }
+        return number;
+    }
+
+    // Applies what JSON.stringify does before serializing a value: calls `toJSON` (which turns a Date into
+    // an ISO string) and unwraps primitive wrapper objects.
+    Local<Value> toJsonValue(Local<Value> value, Local<Value> key) {
+        if (value.IsEmpty() || !value->IsObject()) {
+            return value;
+        }
+        Local<Object> object = Local<Object>::Cast(value);
+        Local<Value> toJson = check(object->Get(context_, toJsonKey_));
+        if (toJson->IsFunction()) {
+            Local<Value> argv[1] = {check(key->ToString(context_))};
+            value = check(Local<Function>::Cast(toJson)->Call(context_, object, 1, argv));
+        }
+        if (value->IsNumberObject()) {
+            return Number::New(isolate_, Local<NumberObject>::Cast(value)->ValueOf());
+        }
+        if (value->IsStringObject()) {
+            return Local<StringObject>::Cast(value)->ValueOf();
+        }
+        if (value->IsBooleanObject()) {
+            return Boolean::New(isolate_, Local<BooleanObject>::Cast(value)->ValueOf());
+        }
+        return value;
+    }
+
+    void enter(Local<Object> object) {
+        if (ancestors_.size() >= kMaxToDynamicDepth) {
+            throw std::invalid_argument("Value is nested too deeply to be converted");
+        }
+        for (const auto &ancestor : ancestors_) {
+            if (ancestor == object) {
+                throw std::invalid_argument("Converting circular structure to dynamic");
+            }
+        }
+        ancestors_.push_back(object);
+    }
+
+    folly::dynamic convertArray(Local<Array> array) {
+        uint32_t length = array->Length();
+        folly::dynamic result = folly::dynamic::array;
+        for (uint32_t i = 0; i < length; i++) {
+            folly::dynamic item;
+            if (!convert(check(array->Get(context_, i)), Integer::NewFromUnsigned(isolate_, i), item)) {
+                item = nullptr;
+            }
+            result.push_back(std::move(item));
+        }
+        return result;
+    }
+
+    folly::dynamic convertObject(Local<Object> object) {
+        Local<Array> keys = check(object->GetOwnPropertyNames(context_));
+        uint32_t length = keys->Length();
+        folly::dynamic result = folly::dynamic::object;
+        for (uint32_t i = 0; i < length; i++) {
+            // Index keys may come back as numbers.
+            Local<String> key = check(check(keys->Get(context_, i))->ToString(context_));
+            folly::dynamic property;
+            if (convert(check(object->Get(context_, key)), key, property)) {
+                result.insert(toStdString(key), std::move(property));
+            }
+        }
+        return result;
+    }
+
+    // An empty result means that JavaScript code (a getter or `toJSON`) threw; the exception stays
+    // pending in the isolate.
+    template <typename T>
+    static Local<T> check(MaybeLocal<T> maybeLocal) {
+        Local<T> local;
+        if (!maybeLocal.ToLocal(&local)) {
+            throw std::invalid_argument("Exception thrown while converting value to dynamic");
+        }
+        return local;
+    }
+
+    Isolate *isolate_;
+    Local<v8::Context> context_;
+    Local<String> toJsonKey_;
+    std::vector<Local<Object>> ancestors_;
+};
+}
+
+folly::dynamic toDynamic(Isolate *isolate, Local<v8::Context> context, Local<Value> value) {
+    DynamicConverter converter(isolate, context);
+    folly::dynamic result;
+    if (!converter.convert(value, String::Empty(isolate), result)) {
+        return nullptr;
+    }
+    return result;
+}
+
 Local<Value> safeToLocal(const MaybeLocal<Value> &maybeLocal) {
     Local<Value> res;
     if(maybeLocal.ToLocal(&res)) {
@@ -50,8 +50,15 @@ namespace v8 {
 
   Local<Value> fromJsonString(Isolate *isolate, Local<Context> context, const Local<String> &jsonStr);
 
+  // Direct conversions between V8 values and folly::dynamic, following JSON semantics
+  // (undefined and functions are dropped from objects and become null in arrays, non finite numbers become null)
+  // without going through an intermediate JSON string.
   Local<Value> fromDynamic(Isolate *isolate, Local<v8::Context> context, const folly::dynamic &value);
 
+  // Like JSON.stringify, calls `toJSON` and throws (std::invalid_argument) on circular or too deeply nested
+  // values. It also throws if a getter or `toJSON` throws; the JavaScript exception is left pending.
+  folly::dynamic toDynamic(Isolate *isolate, Local<v8::Context> context, Local<Value> value);
+
   Local<Value> safeToLocal(const MaybeLocal<Value> &maybeLocal);
 
   std::pair<Local<Uint32>, Local<Uint32>> parseNativeRequireParameters(const v8::FunctionCallbackInfo<v8::Value> &args);
@@ -0,0 +1,119 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <memory>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+#include <libplatform/libplatform.h>
+#include <v8helpers/V8Utils.h>
+
+using namespace v8;
+
+namespace {
+
+class V8UtilsTest : public ::testing::Test {
+protected:
+  static void SetUpTestCase() {
+    // V8 can be initialized only once per process.
+    static std::unique_ptr<Platform> platform = [] {
+      auto platform = platform::NewDefaultPlatform();
+      V8::InitializePlatform(platform.get());
+      V8::Initialize();
+      return platform;
+    }();
+  }
+
+  void SetUp() override {
+    allocator_.reset(ArrayBuffer::Allocator::NewDefaultAllocator());
+    Isolate::CreateParams params;
+    params.array_buffer_allocator = allocator_.get();
+    isolate_ = Isolate::New(params);
+    isolateScope_ = std::make_unique<Isolate::Scope>(isolate_);
+    handleScope_ = std::make_unique<HandleScope>(isolate_);
+  }
+
+  void TearDown() override {
+    handleScope_.reset();
+    isolateScope_.reset();
+    isolate_->Dispose();
+  }
+
+  // Evaluates `source` and converts the result.
+  folly::dynamic toDynamic(const char *source) {
+    Local<Context> context = Context::New(isolate_);
+    Context::Scope contextScope(context);
+    Local<Script> script = Script::Compile(context, toLocalString(isolate_, source)).ToLocalChecked();
+    Local<Value> value = script->Run(context).ToLocalChecked();
+    return v8::toDynamic(isolate_, context, value);
+  }
+
+  // Like `toDynamic`, but returns the message of the JavaScript exception which is left pending after
+  // the conversion throws.
+  std::string toDynamicPendingException(const char *source) {
+    TryCatch tryCatch(isolate_);
+    EXPECT_THROW(toDynamic(source), std::invalid_argument);
+    EXPECT_TRUE(tryCatch.HasCaught());
+    String::Utf8Value message(isolate_, tryCatch.Exception());
+    return *message;
+  }
+
+  std::unique_ptr<ArrayBuffer::Allocator> allocator_;
+  Isolate *isolate_;
+  std::unique_ptr<Isolate::Scope> isolateScope_;
+  std::unique_ptr<HandleScope> handleScope_;
+};
+
+} // namespace
+
+TEST_F(V8UtilsTest, convertsLikeJsonStringify) {
+  EXPECT_EQ(
+      toDynamic("[1, 2.5, 'a', true, null, undefined, () => 1, NaN]"),
+      folly::parseJson("[1, 2.5, \"a\", true, null, null, null, null]"));
+  EXPECT_EQ(
+      toDynamic("({a: 1, u: undefined, f() {}, s: Symbol()})"),
+      folly::parseJson("{\"a\": 1}"));
+  EXPECT_EQ(
+      toDynamic("[new Number(3), new String('s'), new Boolean(false)]"),
+      folly::parseJson("[3, \"s\", false]"));
+
+  // The same object may appear more than once as long as it's not its own ancestor.
+  EXPECT_EQ(
+      toDynamic("var shared = {v: 1}; [shared, {shared}]"),
+      folly::parseJson("[{\"v\": 1}, {\"shared\": {\"v\": 1}}]"));
+}
+
+TEST_F(V8UtilsTest, callsToJson) {
+  EXPECT_EQ(
+      toDynamic("({when: new Date(Date.UTC(2020, 0, 2, 3, 4, 5))})"),
+      folly::parseJson("{\"when\": \"2020-01-02T03:04:05.000Z\"}"));
+  EXPECT_EQ(toDynamic("new Date(0)"), "1970-01-01T00:00:00.000Z");
+  EXPECT_EQ(
+      toDynamic("({x: {toJSON(key) { return key; }}, y: [{toJSON(key) { return typeof key + key; }}]})"),
+      folly::parseJson("{\"x\": \"x\", \"y\": [\"string0\"]}"));
+  EXPECT_EQ(toDynamic("({x: {toJSON() { return undefined; }}})"), folly::dynamic::object());
+}
+
+TEST_F(V8UtilsTest, throwsOnCircularValues) {
+  EXPECT_THROW(toDynamic("var object = {}; object.self = object; object"), std::invalid_argument);
+  EXPECT_THROW(toDynamic("var array = [1]; array.push([array]); array"), std::invalid_argument);
+}
+
+TEST_F(V8UtilsTest, throwsOnDeeplyNestedValues) {
+  EXPECT_THROW(
+      toDynamic("var value = {}; for (var i = 0; i < 100000; i++) { value = {value}; } value"),
+      std::invalid_argument);
+}
+
+TEST_F(V8UtilsTest, leavesExceptionsFromGettersPending) {
+  EXPECT_EQ(
+      toDynamicPendingException(
+          "var object = {}; Object.defineProperty(object, 'boom', "
+          "{enumerable: true, get() { throw new Error('getter'); }}); object"),
+      "Error: getter");
+  EXPECT_EQ(
+      toDynamicPendingException("[{toJSON() { throw new Error('toJSON'); }}]"),
+      "Error: toJSON");
+}
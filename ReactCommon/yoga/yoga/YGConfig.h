@@ -22,6 +22,14 @@ struct YGConfig {
       YGNodeRef owner,
       int childIndex,
       void* cloneContext);
+  using TaskFn = void (*)(size_t taskIndex, void* taskContext);
+  // Calls `task` for every index in [0, taskCount) and returns once all calls
+  // have returned. The calls may run concurrently on any threads.
+  using RunTasksFn = void (*)(
+      YGConfigRef config,
+      size_t taskCount,
+      TaskFn task,
+      void* taskContext);
 
 private:
   union {
@@ -41,10 +49,17 @@ public:
   bool shouldDiffLayoutWithoutLegacyStretchBehaviour = false;
   bool printTree = false;
   float pointScaleFactor = 1.0f;
+  // Number of measurement cache entries kept per node (at least 1).
+  uint32_t maxCachedMeasurements = YG_MAX_CACHED_RESULT_COUNT;
   std::array<bool, facebook::yoga::enums::count<YGExperimentalFeature>()>
       experimentalFeatures = {};
   void* context = nullptr;
   YGMarkerCallbacks markerCallbacks = {nullptr, nullptr};
+  // If set (on the config of the root node), children which get exact
+  // constraints on both axes from their parent are laid out through it, so
+  // these independent subtrees can be laid out concurrently. Measure and
+  // clone callbacks must be thread-safe then.
+  RunTasksFn runTasks = nullptr;
 
   YGConfig(YGLogger logger);
   void log(YGConfig*, YGNode*, YGLogLevel, void*, const char*, va_list);
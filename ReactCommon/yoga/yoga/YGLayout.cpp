@@ -9,7 +9,7 @@
 
 using namespace facebook;
 
-bool YGLayout::operator==(YGLayout layout) const {
+bool YGLayout::operator==(const YGLayout& layout) const {
   bool isEqual = YGFloatArrayEqual(position, layout.position) &&
       YGFloatArrayEqual(dimensions, layout.dimensions) &&
       YGFloatArrayEqual(margin, layout.margin) &&
@@ -17,14 +17,10 @@ bool YGLayout::operator==(YGLayout layout) const {
       YGFloatArrayEqual(padding, layout.padding) &&
       direction == layout.direction && hadOverflow == layout.hadOverflow &&
       lastOwnerDirection == layout.lastOwnerDirection &&
-      nextCachedMeasurementsIndex == layout.nextCachedMeasurementsIndex &&
+      cachedMeasurements == layout.cachedMeasurements &&
       cachedLayout == layout.cachedLayout &&
       computedFlexBasis == layout.computedFlexBasis;
 
-  for (uint32_t i = 0; i < YG_MAX_CACHED_RESULT_COUNT && isEqual; ++i) {
-    isEqual = isEqual && cachedMeasurements[i] == layout.cachedMeasurements[i];
-  }
-
   if (!yoga::isUndefined(measuredDimensions[0]) ||
       !yoga::isUndefined(layout.measuredDimensions[0])) {
     isEqual =
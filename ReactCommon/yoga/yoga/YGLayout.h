@@ -17,6 +17,8 @@ struct YGLayout {
   std::array<float, 4> margin = {};
   std::array<float, 4> border = {};
   std::array<float, 4> padding = {};
+  // Position relative to the root before rounding to the pixel grid.
+  std::array<float, 2> absolutePosition = {};
   YGDirection direction : 2;
   bool didUseLegacyFlag : 1;
   bool doesLegacyStretchFlagAffectsLayout : 1;
@@ -30,9 +32,7 @@ struct YGLayout {
   uint32_t generationCount = 0;
   YGDirection lastOwnerDirection = (YGDirection) -1;
 
-  uint32_t nextCachedMeasurementsIndex = 0;
-  std::array<YGCachedMeasurement, YG_MAX_CACHED_RESULT_COUNT>
-      cachedMeasurements = {};
+  YGCachedMeasurements cachedMeasurements = {};
   std::array<float, 2> measuredDimensions = kYGDefaultDimensionValues;
 
   YGCachedMeasurement cachedLayout = YGCachedMeasurement();
@@ -43,6 +43,6 @@ struct YGLayout {
         doesLegacyStretchFlagAffectsLayout(false),
         hadOverflow(false) {}
 
-  bool operator==(YGLayout layout) const;
-  bool operator!=(YGLayout layout) const { return !(*this == layout); }
+  bool operator==(const YGLayout& layout) const;
+  bool operator!=(const YGLayout& layout) const { return !(*this == layout); }
 };
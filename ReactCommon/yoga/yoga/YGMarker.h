@@ -25,6 +25,11 @@ typedef struct {
   int maxMeasureCache;
   int cachedLayouts;
   int cachedMeasures;
+  // Measurements (misses) and cached measurements (hits) of nodes of type
+  // `YGNodeTypeText` (nodes with measure functions); these are included in
+  // `measures` and `cachedMeasures` as well.
+  int textMeasures;
+  int textCachedMeasures;
 } YGMarkerLayoutData;
 
 typedef struct {
@@ -53,14 +53,14 @@ YGFloatOptional YGNode::getLeadingPosition(
     const float axisSize) const {
   if (YGFlexDirectionIsRow(axis)) {
     auto leadingPosition = YGComputedEdgeValue(
-        style_.position(), YGEdgeStart, CompactValue::ofUndefined());
+        style_->position(), YGEdgeStart, CompactValue::ofUndefined());
     if (!leadingPosition.isUndefined()) {
       return YGResolveValue(leadingPosition, axisSize);
     }
   }
 
   auto leadingPosition = YGComputedEdgeValue(
-      style_.position(), leading[axis], CompactValue::ofUndefined());
+      style_->position(), leading[axis], CompactValue::ofUndefined());
 
   return leadingPosition.isUndefined()
       ? YGFloatOptional{0}
@@ -72,14 +72,14 @@ YGFloatOptional YGNode::getTrailingPosition(
     const float axisSize) const {
   if (YGFlexDirectionIsRow(axis)) {
     auto trailingPosition = YGComputedEdgeValue(
-        style_.position(), YGEdgeEnd, CompactValue::ofUndefined());
+        style_->position(), YGEdgeEnd, CompactValue::ofUndefined());
     if (!trailingPosition.isUndefined()) {
       return YGResolveValue(trailingPosition, axisSize);
     }
   }
 
   auto trailingPosition = YGComputedEdgeValue(
-      style_.position(), trailing[axis], CompactValue::ofUndefined());
+      style_->position(), trailing[axis], CompactValue::ofUndefined());
 
   return trailingPosition.isUndefined()
       ? YGFloatOptional{0}
@@ -89,20 +89,20 @@ YGFloatOptional YGNode::getTrailingPosition(
 bool YGNode::isLeadingPositionDefined(const YGFlexDirection axis) const {
   return (YGFlexDirectionIsRow(axis) &&
           !YGComputedEdgeValue(
-               style_.position(), YGEdgeStart, CompactValue::ofUndefined())
+               style_->position(), YGEdgeStart, CompactValue::ofUndefined())
                .isUndefined()) ||
       !YGComputedEdgeValue(
-           style_.position(), leading[axis], CompactValue::ofUndefined())
+           style_->position(), leading[axis], CompactValue::ofUndefined())
            .isUndefined();
 }
 
 bool YGNode::isTrailingPosDefined(const YGFlexDirection axis) const {
   return (YGFlexDirectionIsRow(axis) &&
           !YGComputedEdgeValue(
-               style_.position(), YGEdgeEnd, CompactValue::ofUndefined())
+               style_->position(), YGEdgeEnd, CompactValue::ofUndefined())
                .isUndefined()) ||
       !YGComputedEdgeValue(
-           style_.position(), trailing[axis], CompactValue::ofUndefined())
+           style_->position(), trailing[axis], CompactValue::ofUndefined())
            .isUndefined();
 }
 
@@ -110,26 +110,27 @@ YGFloatOptional YGNode::getLeadingMargin(
     const YGFlexDirection axis,
     const float widthSize) const {
   if (YGFlexDirectionIsRow(axis) &&
-      !style_.margin()[YGEdgeStart].isUndefined()) {
-    return YGResolveValueMargin(style_.margin()[YGEdgeStart], widthSize);
+      !style_->margin()[YGEdgeStart].isUndefined()) {
+    return YGResolveValueMargin(style_->margin()[YGEdgeStart], widthSize);
   }
 
   return YGResolveValueMargin(
       YGComputedEdgeValue(
-          style_.margin(), leading[axis], CompactValue::ofZero()),
+          style_->margin(), leading[axis], CompactValue::ofZero()),
       widthSize);
 }
 
 YGFloatOptional YGNode::getTrailingMargin(
     const YGFlexDirection axis,
     const float widthSize) const {
-  if (YGFlexDirectionIsRow(axis) && !style_.margin()[YGEdgeEnd].isUndefined()) {
-    return YGResolveValueMargin(style_.margin()[YGEdgeEnd], widthSize);
+  if (YGFlexDirectionIsRow(axis) &&
+      !style_->margin()[YGEdgeEnd].isUndefined()) {
+    return YGResolveValueMargin(style_->margin()[YGEdgeEnd], widthSize);
   }
 
   return YGResolveValueMargin(
       YGComputedEdgeValue(
-          style_.margin(), trailing[axis], CompactValue::ofZero()),
+          style_->margin(), trailing[axis], CompactValue::ofZero()),
       widthSize);
 }
 
@@ -258,6 +259,10 @@ void YGNode::setLayoutPosition(float position, int index) {
   layout_.position[index] = position;
 }
 
+void YGNode::setLayoutAbsolutePosition(std::array<float, 2> absolutePosition) {
+  layout_.absolutePosition = absolutePosition;
+}
+
 void YGNode::setLayoutComputedFlexBasisGeneration(
     uint32_t computedFlexBasisGeneration) {
   layout_.computedFlexBasisGeneration = computedFlexBasisGeneration;
@@ -301,7 +306,7 @@ void YGNode::setPosition(
   const YGDirection directionRespectingRoot =
       owner_ != nullptr ? direction : YGDirectionLTR;
   const YGFlexDirection mainAxis =
-      YGResolveFlexDirection(style_.flexDirection(), directionRespectingRoot);
+      YGResolveFlexDirection(style_->flexDirection(), directionRespectingRoot);
   const YGFlexDirection crossAxis =
       YGFlexDirectionCross(mainAxis, directionRespectingRoot);
 
@@ -328,27 +333,28 @@ void YGNode::setPosition(
 
 YGValue YGNode::marginLeadingValue(const YGFlexDirection axis) const {
   if (YGFlexDirectionIsRow(axis) &&
-      !style_.margin()[YGEdgeStart].isUndefined()) {
-    return style_.margin()[YGEdgeStart];
+      !style_->margin()[YGEdgeStart].isUndefined()) {
+    return style_->margin()[YGEdgeStart];
   } else {
-    return style_.margin()[leading[axis]];
+    return style_->margin()[leading[axis]];
   }
 }
 
 YGValue YGNode::marginTrailingValue(const YGFlexDirection axis) const {
-  if (YGFlexDirectionIsRow(axis) && !style_.margin()[YGEdgeEnd].isUndefined()) {
-    return style_.margin()[YGEdgeEnd];
+  if (YGFlexDirectionIsRow(axis) &&
+      !style_->margin()[YGEdgeEnd].isUndefined()) {
+    return style_->margin()[YGEdgeEnd];
   } else {
-    return style_.margin()[trailing[axis]];
+    return style_->margin()[trailing[axis]];
   }
 }
 
 YGValue YGNode::resolveFlexBasisPtr() const {
-  YGValue flexBasis = style_.flexBasis();
+  YGValue flexBasis = style_->flexBasis();
   if (flexBasis.unit != YGUnitAuto && flexBasis.unit != YGUnitUndefined) {
     return flexBasis;
   }
-  if (!style_.flex().isUndefined() && style_.flex().unwrap() > 0.0f) {
+  if (!style_->flex().isUndefined() && style_->flex().unwrap() > 0.0f) {
     return config_->useWebDefaults ? YGValueAuto : YGValueZero;
   }
   return YGValueAuto;
@@ -368,11 +374,11 @@ void YGNode::resolveDimension() {
 }
 
 YGDirection YGNode::resolveDirection(const YGDirection ownerDirection) {
-  if (style_.direction() == YGDirectionInherit) {
+  if (style_->direction() == YGDirectionInherit) {
     return ownerDirection > YGDirectionInherit ? ownerDirection
                                                : YGDirectionLTR;
   } else {
-    return style_.direction();
+    return style_->direction();
   }
 }
 
@@ -409,11 +415,11 @@ float YGNode::resolveFlexGrow() const {
   if (owner_ == nullptr) {
     return 0.0;
   }
-  if (!style_.flexGrow().isUndefined()) {
-    return style_.flexGrow().unwrap();
+  if (!style_->flexGrow().isUndefined()) {
+    return style_->flexGrow().unwrap();
   }
-  if (!style_.flex().isUndefined() && style_.flex().unwrap() > 0.0f) {
-    return style_.flex().unwrap();
+  if (!style_->flex().isUndefined() && style_->flex().unwrap() > 0.0f) {
+    return style_->flex().unwrap();
   }
   return kDefaultFlexGrow;
 }
@@ -422,49 +428,49 @@ float YGNode::resolveFlexShrink() const {
   if (owner_ == nullptr) {
     return 0.0;
   }
-  if (!style_.flexShrink().isUndefined()) {
-    return style_.flexShrink().unwrap();
+  if (!style_->flexShrink().isUndefined()) {
+    return style_->flexShrink().unwrap();
   }
-  if (!config_->useWebDefaults && !style_.flex().isUndefined() &&
-      style_.flex().unwrap() < 0.0f) {
-    return -style_.flex().unwrap();
+  if (!config_->useWebDefaults && !style_->flex().isUndefined() &&
+      style_->flex().unwrap() < 0.0f) {
+    return -style_->flex().unwrap();
   }
   return config_->useWebDefaults ? kWebDefaultFlexShrink : kDefaultFlexShrink;
 }
 
 bool YGNode::isNodeFlexible() {
   return (
-      (style_.positionType() == YGPositionTypeRelative) &&
+      (style_->positionType() == YGPositionTypeRelative) &&
       (resolveFlexGrow() != 0 || resolveFlexShrink() != 0));
 }
 
 float YGNode::getLeadingBorder(const YGFlexDirection axis) const {
   YGValue leadingBorder;
   if (YGFlexDirectionIsRow(axis) &&
-      !style_.border()[YGEdgeStart].isUndefined()) {
-    leadingBorder = style_.border()[YGEdgeStart];
+      !style_->border()[YGEdgeStart].isUndefined()) {
+    leadingBorder = style_->border()[YGEdgeStart];
     if (leadingBorder.value >= 0) {
       return leadingBorder.value;
     }
   }
 
   leadingBorder = YGComputedEdgeValue(
-      style_.border(), leading[axis], CompactValue::ofZero());
+      style_->border(), leading[axis], CompactValue::ofZero());
   return YGFloatMax(leadingBorder.value, 0.0f);
 }
 
 float YGNode::getTrailingBorder(const YGFlexDirection flexDirection) const {
   YGValue trailingBorder;
   if (YGFlexDirectionIsRow(flexDirection) &&
-      !style_.border()[YGEdgeEnd].isUndefined()) {
-    trailingBorder = style_.border()[YGEdgeEnd];
+      !style_->border()[YGEdgeEnd].isUndefined()) {
+    trailingBorder = style_->border()[YGEdgeEnd];
     if (trailingBorder.value >= 0.0f) {
       return trailingBorder.value;
     }
   }
 
   trailingBorder = YGComputedEdgeValue(
-      style_.border(), trailing[flexDirection], CompactValue::ofZero());
+      style_->border(), trailing[flexDirection], CompactValue::ofZero());
   return YGFloatMax(trailingBorder.value, 0.0f);
 }
 
@@ -472,16 +478,16 @@ YGFloatOptional YGNode::getLeadingPadding(
     const YGFlexDirection axis,
     const float widthSize) const {
   const YGFloatOptional paddingEdgeStart =
-      YGResolveValue(style_.padding()[YGEdgeStart], widthSize);
+      YGResolveValue(style_->padding()[YGEdgeStart], widthSize);
   if (YGFlexDirectionIsRow(axis) &&
-      !style_.padding()[YGEdgeStart].isUndefined() &&
+      !style_->padding()[YGEdgeStart].isUndefined() &&
       !paddingEdgeStart.isUndefined() && paddingEdgeStart.unwrap() >= 0.0f) {
     return paddingEdgeStart;
   }
 
   YGFloatOptional resolvedValue = YGResolveValue(
       YGComputedEdgeValue(
-          style_.padding(), leading[axis], CompactValue::ofZero()),
+          style_->padding(), leading[axis], CompactValue::ofZero()),
       widthSize);
   return YGFloatOptionalMax(resolvedValue, YGFloatOptional(0.0f));
 }
@@ -490,14 +496,14 @@ YGFloatOptional YGNode::getTrailingPadding(
     const YGFlexDirection axis,
     const float widthSize) const {
   const YGFloatOptional paddingEdgeEnd =
-      YGResolveValue(style_.padding()[YGEdgeEnd], widthSize);
+      YGResolveValue(style_->padding()[YGEdgeEnd], widthSize);
   if (YGFlexDirectionIsRow(axis) && paddingEdgeEnd >= YGFloatOptional{0.0f}) {
     return paddingEdgeEnd;
   }
 
   YGFloatOptional resolvedValue = YGResolveValue(
       YGComputedEdgeValue(
-          style_.padding(), trailing[axis], CompactValue::ofZero()),
+          style_->padding(), trailing[axis], CompactValue::ofZero()),
       widthSize);
 
   return YGFloatOptionalMax(resolvedValue, YGFloatOptional(0.0f));
@@ -584,8 +590,8 @@ void YGNode::reset() {
   auto config = getConfig();
   *this = YGNode{};
   if (config->useWebDefaults) {
-    style_.flexDirection() = YGFlexDirectionRow;
-    style_.alignContent() = YGAlignStretch;
+    style_.mutate().flexDirection() = YGFlexDirectionRow;
+    style_.mutate().alignContent() = YGAlignStretch;
   }
   setConfig(config);
 }
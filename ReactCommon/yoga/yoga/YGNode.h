@@ -42,7 +42,8 @@ private:
     PrintWithContextFn withContext;
   } print_ = {nullptr};
   YGDirtiedFunc dirtied_ = nullptr;
-  YGStyle style_ = {};
+  // Shared between clones of the node until one of them changes it.
+  facebook::yoga::detail::CopyOnWrite<YGStyle> style_ = {};
   YGLayout layout_ = {};
   uint32_t lineIndex_ = 0;
   YGNodeRef owner_ = nullptr;
@@ -115,9 +116,10 @@ public:
   YGDirtiedFunc getDirtied() const { return dirtied_; }
 
   // For Performance reasons passing as reference.
-  YGStyle& getStyle() { return style_; }
+  const YGStyle& getStyle() const { return *style_; }
 
-  const YGStyle& getStyle() const { return style_; }
+  // Returns the style for modification; the node stops sharing it.
+  YGStyle& getMutableStyle() { return style_.mutate(); }
 
   // For Performance reasons passing as reference.
   YGLayout& getLayout() { return layout_; }
@@ -239,7 +241,11 @@ public:
 
   void setDirtiedFunc(YGDirtiedFunc dirtiedFunc) { dirtied_ = dirtiedFunc; }
 
-  void setStyle(const YGStyle& style) { style_ = style; }
+  void setStyle(const YGStyle& style) {
+    if (!(*style_ == style)) {
+      style_.set(style);
+    }
+  }
 
   void setLayout(const YGLayout& layout) { layout_ = layout; }
 
@@ -270,6 +276,7 @@ public:
   void setLayoutBorder(float border, int index);
   void setLayoutPadding(float padding, int index);
   void setLayoutPosition(float position, int index);
+  void setLayoutAbsolutePosition(std::array<float, 2> absolutePosition);
   void setPosition(
       const YGDirection direction,
       const float mainSize,
@@ -59,6 +59,7 @@ public:
   template <typename T, T YGStyle::*Prop, int PropBit>
   struct Ref {
     YGStyle& style;
+    static T get(const YGStyle& style) { return style.*Prop; }
     operator T() const { return style.*Prop; }
     Ref<T, Prop, PropBit>& operator=(T value) {
       style.*Prop = value;
@@ -82,6 +83,9 @@ public:
     };
 
     YGStyle& style;
+    static const Values<Idx>& get(const YGStyle& style) {
+      return style.*Prop;
+    }
     IdxRef<Idx, Prop, PropBit>& operator=(const Values<Idx>& values) {
       style.*Prop = values;
       style.assignedProps_ |=
@@ -101,6 +105,7 @@ public:
   struct BitfieldRef {
     YGStyle& style;
 
+    static T get(const YGStyle& style) { return (style.*Get)(); }
     operator T() const { return (style.*Get)(); }
     BitfieldRef<T, Get, Set, PropBit>& operator=(T x) {
       (style.*Set)(x);
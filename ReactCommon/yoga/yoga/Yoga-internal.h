@@ -8,8 +8,10 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <memory>
 #include <vector>
 #include "CompactValue.h"
+#include "YGMarker.h"
 #include "Yoga.h"
 
 using YGVector = std::vector<YGNodeRef>;
@@ -91,9 +93,27 @@ struct YGCachedMeasurement {
   }
 };
 
+// State of a single layout pass (one `YGNodeCalculateLayout` call).
+// Layout functions receive it instead of reading process-wide globals, so
+// independent trees can be laid out on different threads at the same time.
+struct YGLayoutPassContext {
+  YGMarkerLayoutData& markerData;
+  // Unique per pass; nodes and computed flex bases stamped with it were
+  // already visited in this pass and their cached results are current.
+  const uint32_t generationCount;
+  // Current recursion depth (used for debug output).
+  uint32_t depth{0};
+
+  YGLayoutPassContext(YGMarkerLayoutData& markerData, uint32_t generationCount)
+      : markerData(markerData), generationCount(generationCount) {}
+};
+
+// Default size of the measurement cache of a node (see `YGConfig`).
 // This value was chosen based on empirical data:
 // 98% of analyzed layouts require less than 8 entries.
+#ifndef YG_MAX_CACHED_RESULT_COUNT
 #define YG_MAX_CACHED_RESULT_COUNT 8
+#endif
 
 namespace facebook {
 namespace yoga {
@@ -140,10 +160,107 @@ public:
   Values& operator=(const Values& other) = default;
 };
 
+// Value which is shared between copies until one of them is modified. Copying
+// only bumps a reference count. Default-constructed instances share a single
+// default value, so they don't allocate until they are modified.
+template <typename T>
+class CopyOnWrite {
+public:
+  CopyOnWrite() : value_(defaultValue()) {}
+
+  const T& operator*() const noexcept { return *value_; }
+  const T* operator->() const noexcept { return value_.get(); }
+
+  // Returns the value for modification, copying it first if it's shared.
+  T& mutate() {
+    if (value_.use_count() != 1) {
+      value_ = std::make_shared<T>(*value_);
+    }
+    return *value_;
+  }
+
+  void set(const T& value) {
+    if (value_.use_count() == 1) {
+      *value_ = value;
+    } else {
+      value_ = std::make_shared<T>(value);
+    }
+  }
+
+private:
+  static const std::shared_ptr<T>& defaultValue() {
+    static const auto value = std::make_shared<T>();
+    return value;
+  }
+
+  std::shared_ptr<T> value_;
+};
+
 } // namespace detail
 } // namespace yoga
 } // namespace facebook
 
+// Measurement cache of a node. Entries are stored out of line and shared
+// between copies of the node (e.g. clones of a node whose layout did not
+// change) until one of them stores a new measurement.
+class YGCachedMeasurements {
+public:
+  uint32_t size() const { return count_; }
+
+  const YGCachedMeasurement& operator[](uint32_t index) const {
+    return (*entries_)[index];
+  }
+
+  // Returns the entry of the most recent measurement, or null if there is
+  // none.
+  const YGCachedMeasurement* latest() const {
+    return count_ > 0 ? &(*entries_)[nextIndex_ - 1] : nullptr;
+  }
+
+  // Invalidates all entries.
+  void clear() {
+    count_ = 0;
+    nextIndex_ = 0;
+  }
+
+  // Returns an entry for a new measurement. Once `maxCount` entries are in
+  // use, the oldest one is replaced; the others stay valid.
+  YGCachedMeasurement& add(uint32_t maxCount) {
+    if (nextIndex_ >= maxCount) {
+      nextIndex_ = 0;
+    }
+    auto& entries = entries_.mutate();
+    if (entries.size() <= nextIndex_) {
+      entries.resize(nextIndex_ + 1);
+    }
+    auto& entry = entries[nextIndex_];
+    nextIndex_++;
+    count_ = std::max(count_, nextIndex_);
+    return entry;
+  }
+
+  // Number of entries the storage of this instance has room for.
+  size_t capacity() const { return entries_->capacity(); }
+
+  bool operator==(const YGCachedMeasurements& other) const {
+    if (count_ != other.count_ || nextIndex_ != other.nextIndex_) {
+      return false;
+    }
+    for (uint32_t i = 0; i < count_; i++) {
+      if (!((*this)[i] == other[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  facebook::yoga::detail::CopyOnWrite<std::vector<YGCachedMeasurement>>
+      entries_;
+  uint32_t count_ = 0;
+  uint32_t nextIndex_ = 0;
+};
+
 static const float kDefaultFlexGrow = 0.0f;
 static const float kDefaultFlexShrink = 0.0f;
 static const float kWebDefaultFlexShrink = 1.0f;
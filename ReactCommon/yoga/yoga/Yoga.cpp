@@ -9,6 +9,7 @@
 #include <float.h>
 #include <string.h>
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include "Utils.h"
 #include "YGNode.h"
@@ -218,8 +219,8 @@ WIN_EXPORT YGNodeRef YGNodeNewWithConfig(const YGConfigRef config) {
 #endif
 
   if (config->useWebDefaults) {
-    node->getStyle().flexDirection() = YGFlexDirectionRow;
-    node->getStyle().alignContent() = YGAlignStretch;
+    node->getMutableStyle().flexDirection() = YGFlexDirectionRow;
+    node->getMutableStyle().alignContent() = YGAlignStretch;
   }
   node->setConfig(config);
   return node;
@@ -537,8 +538,10 @@ void updateStyle(
     T value,
     NeedsUpdate&& needsUpdate,
     Update&& update) {
+  // `needsUpdate` only reads the style, so the node keeps sharing it with its
+  // clones unless the value actually changes.
   if (needsUpdate(node->getStyle(), value)) {
-    update(node->getStyle(), value);
+    update(node->getMutableStyle(), value);
     node->markDirtyAndPropogate();
   }
 }
@@ -548,7 +551,7 @@ void updateStyle(YGNode* node, Ref (YGStyle::*prop)(), T value) {
   updateStyle(
       node,
       value,
-      [prop](YGStyle& s, T x) { return (s.*prop)() != x; },
+      [](const YGStyle& s, T x) { return Ref::get(s) != x; },
       [prop](YGStyle& s, T x) { (s.*prop)() = x; });
 }
 
@@ -562,7 +565,7 @@ void updateIndexedStyleProp(
   updateStyle(
       node,
       value,
-      [idx, prop](YGStyle& s, CompactValue x) { return (s.*prop)()[idx] != x; },
+      [idx](const YGStyle& s, CompactValue x) { return Ref::get(s)[idx] != x; },
       [idx, prop](YGStyle& s, CompactValue x) { (s.*prop)()[idx] = x; });
 }
 
@@ -938,7 +941,9 @@ bool YGNodeLayoutGetDidLegacyStretchFlagAffectLayout(const YGNodeRef node) {
   return node->getLayout().doesLegacyStretchFlagAffectsLayout;
 }
 
-uint32_t gCurrentGenerationCount = 0;
+// Generation counts are handed out to layout passes, which may run
+// concurrently on independent trees, so the counter itself is atomic.
+static std::atomic<uint32_t> gCurrentGenerationCount{0};
 
 bool YGLayoutNodeInternal(
     const YGNodeRef node,
@@ -952,7 +957,7 @@ bool YGLayoutNodeInternal(
     const bool performLayout,
     const char* reason,
     const YGConfigRef config,
-    YGMarkerLayoutData& layoutMarkerData,
+    YGLayoutPassContext& layoutPass,
     void* const layoutContext);
 
 #ifdef DEBUG
@@ -1196,7 +1201,7 @@ static void YGNodeComputeFlexBasisForChild(
     const YGMeasureMode heightMode,
     const YGDirection direction,
     const YGConfigRef config,
-    YGMarkerLayoutData& layoutMarkerData,
+    YGLayoutPassContext& layoutPass,
     void* const layoutContext) {
   const YGFlexDirection mainAxis =
       YGResolveFlexDirection(node->getStyle().flexDirection(), direction);
@@ -1221,7 +1226,7 @@ static void YGNodeComputeFlexBasisForChild(
         (YGConfigIsExperimentalFeatureEnabled(
              child->getConfig(), YGExperimentalFeatureWebFlexBasis) &&
          child->getLayout().computedFlexBasisGeneration !=
-             gCurrentGenerationCount)) {
+             layoutPass.generationCount)) {
       const YGFloatOptional paddingAndBorder = YGFloatOptional(
           YGNodePaddingAndBorderForAxis(child, mainAxis, ownerWidth));
       child->setLayoutComputedFlexBasis(
@@ -1371,14 +1376,14 @@ static void YGNodeComputeFlexBasisForChild(
         false,
         "measure",
         config,
-        layoutMarkerData,
+        layoutPass,
         layoutContext);
 
     child->setLayoutComputedFlexBasis(YGFloatOptional(YGFloatMax(
         child->getLayout().measuredDimensions[dim[mainAxis]],
         YGNodePaddingAndBorderForAxis(child, mainAxis, ownerWidth))));
   }
-  child->setLayoutComputedFlexBasisGeneration(gCurrentGenerationCount);
+  child->setLayoutComputedFlexBasisGeneration(layoutPass.generationCount);
 }
 
 static void YGNodeAbsoluteLayoutChild(
@@ -1389,7 +1394,7 @@ static void YGNodeAbsoluteLayoutChild(
     const float height,
     const YGDirection direction,
     const YGConfigRef config,
-    YGMarkerLayoutData& layoutMarkerData,
+    YGLayoutPassContext& layoutPass,
     void* const layoutContext) {
   const YGFlexDirection mainAxis =
       YGResolveFlexDirection(node->getStyle().flexDirection(), direction);
@@ -1495,7 +1500,7 @@ static void YGNodeAbsoluteLayoutChild(
         false,
         "abs-measure",
         config,
-        layoutMarkerData,
+        layoutPass,
         layoutContext);
     childWidth = child->getLayout().measuredDimensions[YGDimensionWidth] +
         child->getMarginForAxis(YGFlexDirectionRow, width).unwrap();
@@ -1515,7 +1520,7 @@ static void YGNodeAbsoluteLayoutChild(
       true,
       "abs-layout",
       config,
-      layoutMarkerData,
+      layoutPass,
       layoutContext);
 
   if (child->isTrailingPosDefined(mainAxis) &&
@@ -1807,6 +1812,46 @@ static float YGNodeCalculateAvailableInnerDim(
   return availableInnerDim;
 }
 
+// Calls `layout(index, layoutPass)` for every index in [0, count) through
+// `config->runTasks`. Every call gets its own copy of the pass context; the
+// marker data they collect is merged back into `layoutPass` afterwards.
+template <typename Layout>
+static void YGRunIndependentLayouts(
+    const YGConfigRef config,
+    const size_t count,
+    YGLayoutPassContext& layoutPass,
+    const Layout& layout) {
+  struct Task {
+    const Layout& layout;
+    const YGLayoutPassContext& layoutPass;
+    std::vector<YGMarkerLayoutData> markerData;
+  } task{layout, layoutPass, std::vector<YGMarkerLayoutData>(count)};
+
+  config->runTasks(
+      config,
+      count,
+      [](size_t index, void* taskContext) {
+        auto& task = *static_cast<Task*>(taskContext);
+        YGLayoutPassContext layoutPass{task.markerData[index],
+                                       task.layoutPass.generationCount};
+        layoutPass.depth = task.layoutPass.depth;
+        task.layout(index, layoutPass);
+      },
+      &task);
+
+  auto& markerData = layoutPass.markerData;
+  for (const auto& taskMarkerData : task.markerData) {
+    markerData.layouts += taskMarkerData.layouts;
+    markerData.measures += taskMarkerData.measures;
+    markerData.maxMeasureCache =
+        std::max(markerData.maxMeasureCache, taskMarkerData.maxMeasureCache);
+    markerData.cachedLayouts += taskMarkerData.cachedLayouts;
+    markerData.cachedMeasures += taskMarkerData.cachedMeasures;
+    markerData.textMeasures += taskMarkerData.textMeasures;
+    markerData.textCachedMeasures += taskMarkerData.textCachedMeasures;
+  }
+}
+
 static float YGNodeComputeFlexBasisForChildren(
     const YGNodeRef node,
     const float availableInnerWidth,
@@ -1817,7 +1862,7 @@ static float YGNodeComputeFlexBasisForChildren(
     YGFlexDirection mainAxis,
     const YGConfigRef config,
     bool performLayout,
-    YGMarkerLayoutData& layoutMarkerData,
+    YGLayoutPassContext& layoutPass,
     void* const layoutContext) {
   float totalOuterFlexBasis = 0.0f;
   YGNodeRef singleFlexChild = nullptr;
@@ -1869,7 +1914,7 @@ static float YGNodeComputeFlexBasisForChildren(
       continue;
     }
     if (child == singleFlexChild) {
-      child->setLayoutComputedFlexBasisGeneration(gCurrentGenerationCount);
+      child->setLayoutComputedFlexBasisGeneration(layoutPass.generationCount);
       child->setLayoutComputedFlexBasis(YGFloatOptional(0));
     } else {
       YGNodeComputeFlexBasisForChild(
@@ -1883,7 +1928,7 @@ static float YGNodeComputeFlexBasisForChildren(
           heightMeasureMode,
           direction,
           config,
-          layoutMarkerData,
+          layoutPass,
           layoutContext);
     }
 
@@ -1997,7 +2042,7 @@ static float YGDistributeFreeSpaceSecondPass(
     const YGMeasureMode measureModeCrossDim,
     const bool performLayout,
     const YGConfigRef config,
-    YGMarkerLayoutData& layoutMarkerData,
+    YGLayoutPassContext& layoutPass,
     void* const layoutContext) {
   float childFlexBasis = 0;
   float flexShrinkScaledFactor = 0;
@@ -2005,6 +2050,21 @@ static float YGDistributeFreeSpaceSecondPass(
   float deltaFreeSpace = 0;
   const bool isMainAxisRow = YGFlexDirectionIsRow(mainAxis);
   const bool isNodeFlexWrap = node->getStyle().flexWrap() != YGWrapNoWrap;
+  // A child which gets exact constraints on both axes is an independent
+  // subtree: nothing in its layout depends on its siblings. With `runTasks`
+  // set, the layouts of such children are collected here and run
+  // concurrently once the loop is done.
+  const bool canDeferLayout = config->runTasks != nullptr &&
+      collectedFlexItemsValues.relativeChildren.size() > 1;
+  struct DeferredLayout {
+    YGNodeRef child;
+    float width;
+    float height;
+    YGMeasureMode widthMeasureMode;
+    YGMeasureMode heightMeasureMode;
+    bool performLayout;
+  };
+  std::vector<DeferredLayout> deferredLayouts;
 
   for (auto currentRelativeChild : collectedFlexItemsValues.relativeChildren) {
     childFlexBasis = YGNodeBoundAxisWithinMinAndMax(
@@ -2149,6 +2209,17 @@ static float YGDistributeFreeSpaceSecondPass(
     const YGMeasureMode childHeightMeasureMode =
         !isMainAxisRow ? childMainMeasureMode : childCrossMeasureMode;
 
+    if (canDeferLayout && childWidthMeasureMode == YGMeasureModeExactly &&
+        childHeightMeasureMode == YGMeasureModeExactly) {
+      deferredLayouts.push_back({currentRelativeChild,
+                                 childWidth,
+                                 childHeight,
+                                 childWidthMeasureMode,
+                                 childHeightMeasureMode,
+                                 performLayout && !requiresStretchLayout});
+      continue;
+    }
+
     // Recursively call the layout algorithm for this child with the updated
     // main size.
     YGLayoutNodeInternal(
@@ -2163,12 +2234,47 @@ static float YGDistributeFreeSpaceSecondPass(
         performLayout && !requiresStretchLayout,
         "flex",
         config,
-        layoutMarkerData,
+        layoutPass,
         layoutContext);
     node->setLayoutHadOverflow(
         node->getLayout().hadOverflow |
         currentRelativeChild->getLayout().hadOverflow);
   }
+
+  if (!deferredLayouts.empty()) {
+    const auto layoutDeferred = [&](size_t index,
+                                    YGLayoutPassContext& childLayoutPass) {
+      const auto& deferredLayout = deferredLayouts[index];
+      YGLayoutNodeInternal(
+          deferredLayout.child,
+          deferredLayout.width,
+          deferredLayout.height,
+          node->getLayout().direction,
+          deferredLayout.widthMeasureMode,
+          deferredLayout.heightMeasureMode,
+          availableInnerWidth,
+          availableInnerHeight,
+          deferredLayout.performLayout,
+          "flex",
+          config,
+          childLayoutPass,
+          layoutContext);
+    };
+
+    if (deferredLayouts.size() == 1) {
+      layoutDeferred(0, layoutPass);
+    } else {
+      YGRunIndependentLayouts(
+          config, deferredLayouts.size(), layoutPass, layoutDeferred);
+    }
+
+    for (const auto& deferredLayout : deferredLayouts) {
+      node->setLayoutHadOverflow(
+          node->getLayout().hadOverflow |
+          deferredLayout.child->getLayout().hadOverflow);
+    }
+  }
+
   return deltaFreeSpace;
 }
 
@@ -2294,7 +2400,7 @@ static void YGResolveFlexibleLength(
     const YGMeasureMode measureModeCrossDim,
     const bool performLayout,
     const YGConfigRef config,
-    YGMarkerLayoutData& layoutMarkerData,
+    YGLayoutPassContext& layoutPass,
     void* const layoutContext) {
   const float originalFreeSpace = collectedFlexItemsValues.remainingFreeSpace;
   // First pass: detect the flex items whose min/max constraints trigger
@@ -2320,7 +2426,7 @@ static void YGResolveFlexibleLength(
       measureModeCrossDim,
       performLayout,
       config,
-      layoutMarkerData,
+      layoutPass,
       layoutContext);
 
   collectedFlexItemsValues.remainingFreeSpace =
@@ -2620,7 +2726,7 @@ static void YGNodelayoutImpl(
     const float ownerHeight,
     const bool performLayout,
     const YGConfigRef config,
-    YGMarkerLayoutData& layoutMarkerData,
+    YGLayoutPassContext& layoutPass,
     void* const layoutContext) {
   YGAssertWithNode(
       node,
@@ -2637,7 +2743,11 @@ static void YGNodelayoutImpl(
       "availableHeight is indefinite so heightMeasureMode must be "
       "YGMeasureModeUndefined");
 
-  (performLayout ? layoutMarkerData.layouts : layoutMarkerData.measures) += 1;
+  (performLayout ? layoutPass.markerData.layouts
+                 : layoutPass.markerData.measures) += 1;
+  if (!performLayout && node->getNodeType() == YGNodeTypeText) {
+    layoutPass.markerData.textMeasures += 1;
+  }
 
   // Set the resolved resolution in the node's layout.
   const YGDirection direction = node->resolveDirection(ownerDirection);
@@ -2800,7 +2910,7 @@ static void YGNodelayoutImpl(
       mainAxis,
       config,
       performLayout,
-      layoutMarkerData,
+      layoutPass,
       layoutContext);
 
   const bool flexBasisOverflows = measureModeMainDim == YGMeasureModeUndefined
@@ -2908,7 +3018,7 @@ static void YGNodelayoutImpl(
           measureModeCrossDim,
           performLayout,
           config,
-          layoutMarkerData,
+          layoutPass,
           layoutContext);
     }
 
@@ -3082,7 +3192,7 @@ static void YGNodelayoutImpl(
                   true,
                   "stretch",
                   config,
-                  layoutMarkerData,
+                  layoutPass,
                   layoutContext);
             }
           } else {
@@ -3290,7 +3400,7 @@ static void YGNodelayoutImpl(
                         true,
                         "multiline-stretch",
                         config,
-                        layoutMarkerData,
+                        layoutPass,
                         layoutContext);
                   }
                 }
@@ -3430,7 +3540,7 @@ static void YGNodelayoutImpl(
           availableInnerHeight,
           direction,
           config,
-          layoutMarkerData,
+          layoutPass,
           layoutContext);
     }
 
@@ -3459,7 +3569,6 @@ static void YGNodelayoutImpl(
   }
 }
 
-uint32_t gDepth = 0;
 bool gPrintChanges = false;
 bool gPrintSkips = false;
 
@@ -3664,29 +3773,30 @@ bool YGLayoutNodeInternal(
     const bool performLayout,
     const char* reason,
     const YGConfigRef config,
-    YGMarkerLayoutData& layoutMarkerData,
+    YGLayoutPassContext& layoutPass,
     void* const layoutContext) {
 #ifdef YG_ENABLE_EVENTS
   Event::publish<Event::NodeLayout>(node);
 #endif
   YGLayout* layout = &node->getLayout();
 
-  gDepth++;
+  layoutPass.depth++;
 
   const bool needToVisitNode =
-      (node->isDirty() && layout->generationCount != gCurrentGenerationCount) ||
+      (node->isDirty() &&
+       layout->generationCount != layoutPass.generationCount) ||
       layout->lastOwnerDirection != ownerDirection;
 
   if (needToVisitNode) {
     // Invalidate the cached results.
-    layout->nextCachedMeasurementsIndex = 0;
+    layout->cachedMeasurements.clear();
     layout->cachedLayout.widthMeasureMode = (YGMeasureMode) -1;
     layout->cachedLayout.heightMeasureMode = (YGMeasureMode) -1;
     layout->cachedLayout.computedWidth = -1;
     layout->cachedLayout.computedHeight = -1;
   }
 
-  YGCachedMeasurement* cachedResults = nullptr;
+  const YGCachedMeasurement* cachedResults = nullptr;
 
   // Determine whether the results are already cached. We maintain a separate
   // cache for layouts and measurements. A layout operation modifies the
@@ -3720,7 +3830,7 @@ bool YGLayoutNodeInternal(
       cachedResults = &layout->cachedLayout;
     } else {
       // Try to use the measurement cache.
-      for (uint32_t i = 0; i < layout->nextCachedMeasurementsIndex; i++) {
+      for (uint32_t i = 0; i < layout->cachedMeasurements.size(); i++) {
         if (YGNodeCanUseCachedMeasurement(
                 widthMeasureMode,
                 availableWidth,
@@ -3748,7 +3858,7 @@ bool YGLayoutNodeInternal(
       cachedResults = &layout->cachedLayout;
     }
   } else {
-    for (uint32_t i = 0; i < layout->nextCachedMeasurementsIndex; i++) {
+    for (uint32_t i = 0; i < layout->cachedMeasurements.size(); i++) {
       if (YGFloatsEqual(
               layout->cachedMeasurements[i].availableWidth, availableWidth) &&
           YGFloatsEqual(
@@ -3767,8 +3877,11 @@ bool YGLayoutNodeInternal(
     layout->measuredDimensions[YGDimensionHeight] =
         cachedResults->computedHeight;
 
-    (performLayout ? layoutMarkerData.cachedLayouts
-                   : layoutMarkerData.cachedMeasures) += 1;
+    (performLayout ? layoutPass.markerData.cachedLayouts
+                   : layoutPass.markerData.cachedMeasures) += 1;
+    if (!performLayout && node->getNodeType() == YGNodeTypeText) {
+      layoutPass.markerData.textCachedMeasures += 1;
+    }
 
     if (gPrintChanges && gPrintSkips) {
       Log::log(
@@ -3776,8 +3889,8 @@ bool YGLayoutNodeInternal(
           YGLogLevelVerbose,
           nullptr,
           "%s%d.{[skipped] ",
-          YGSpacer(gDepth),
-          gDepth);
+          YGSpacer(layoutPass.depth),
+          layoutPass.depth);
       node->print(layoutContext);
       Log::log(
           node,
@@ -3799,8 +3912,8 @@ bool YGLayoutNodeInternal(
           YGLogLevelVerbose,
           nullptr,
           "%s%d.{%s",
-          YGSpacer(gDepth),
-          gDepth,
+          YGSpacer(layoutPass.depth),
+          layoutPass.depth,
           needToVisitNode ? "*" : "");
       node->print(layoutContext);
       Log::log(
@@ -3826,7 +3939,7 @@ bool YGLayoutNodeInternal(
         ownerHeight,
         performLayout,
         config,
-        layoutMarkerData,
+        layoutPass,
         layoutContext);
 
     if (gPrintChanges) {
@@ -3835,8 +3948,8 @@ bool YGLayoutNodeInternal(
           YGLogLevelVerbose,
           nullptr,
           "%s%d.}%s",
-          YGSpacer(gDepth),
-          gDepth,
+          YGSpacer(layoutPass.depth),
+          layoutPass.depth,
           needToVisitNode ? "*" : "");
       node->print(layoutContext);
       Log::log(
@@ -3854,16 +3967,10 @@ bool YGLayoutNodeInternal(
     layout->lastOwnerDirection = ownerDirection;
 
     if (cachedResults == nullptr) {
-      if (layout->nextCachedMeasurementsIndex + 1 >
-          (uint32_t) layoutMarkerData.maxMeasureCache) {
-        layoutMarkerData.maxMeasureCache =
-            layout->nextCachedMeasurementsIndex + 1;
-      }
-      if (layout->nextCachedMeasurementsIndex == YG_MAX_CACHED_RESULT_COUNT) {
-        if (gPrintChanges) {
-          Log::log(node, YGLogLevelVerbose, nullptr, "Out of cache entries!\n");
-        }
-        layout->nextCachedMeasurementsIndex = 0;
+      if (layout->cachedMeasurements.size() + 1 >
+          (uint32_t) layoutPass.markerData.maxMeasureCache) {
+        layoutPass.markerData.maxMeasureCache =
+            layout->cachedMeasurements.size() + 1;
       }
 
       YGCachedMeasurement* newCacheEntry;
@@ -3871,10 +3978,15 @@ bool YGLayoutNodeInternal(
         // Use the single layout cache entry.
         newCacheEntry = &layout->cachedLayout;
       } else {
-        // Allocate a new measurement cache entry.
-        newCacheEntry =
-            &layout->cachedMeasurements[layout->nextCachedMeasurementsIndex];
-        layout->nextCachedMeasurementsIndex++;
+        // Allocate a new measurement cache entry. Once all entries are in use,
+        // the oldest one is replaced; the others stay valid.
+        const uint32_t maxCachedMeasurements =
+            std::max<uint32_t>(config->maxCachedMeasurements, 1);
+        if (gPrintChanges &&
+            layout->cachedMeasurements.size() >= maxCachedMeasurements) {
+          Log::log(node, YGLogLevelVerbose, nullptr, "Out of cache entries!\n");
+        }
+        newCacheEntry = &layout->cachedMeasurements.add(maxCachedMeasurements);
       }
 
       newCacheEntry->availableWidth = availableWidth;
@@ -3900,8 +4012,8 @@ bool YGLayoutNodeInternal(
     node->setDirty(false);
   }
 
-  gDepth--;
-  layout->generationCount = gCurrentGenerationCount;
+  layoutPass.depth--;
+  layout->generationCount = layoutPass.generationCount;
   return (needToVisitNode || cachedResults == nullptr);
 }
 
@@ -3922,6 +4034,16 @@ void YGConfigSetPointScaleFactor(
   }
 }
 
+void YGConfigSetMaxCachedMeasurements(
+    const YGConfigRef config,
+    const uint32_t maxCachedMeasurements) {
+  YGAssertWithConfig(
+      config,
+      maxCachedMeasurements >= 1,
+      "Number of cached measurements should be at least 1");
+  config->maxCachedMeasurements = maxCachedMeasurements;
+}
+
 static void YGRoundToPixelGrid(
     const YGNodeRef node,
     const float pointScaleFactor,
@@ -3943,6 +4065,8 @@ static void YGRoundToPixelGrid(
   const float absoluteNodeRight = absoluteNodeLeft + nodeWidth;
   const float absoluteNodeBottom = absoluteNodeTop + nodeHeight;
 
+  node->setLayoutAbsolutePosition({{absoluteNodeLeft, absoluteNodeTop}});
+
   // If a node has a custom measure function we never want to round down its
   // size as this could lead to unwanted text truncation.
   const bool textRounding = node->getNodeType() == YGNodeTypeText;
@@ -3995,6 +4119,14 @@ static void YGRoundToPixelGrid(
   }
 }
 
+void YGNodeRoundToPixelGrid(
+    const YGNodeRef node,
+    const float absoluteLeft,
+    const float absoluteTop) {
+  YGRoundToPixelGrid(
+      node, node->getConfig()->pointScaleFactor, absoluteLeft, absoluteTop);
+}
+
 void YGNodeCalculateLayoutWithContext(
     const YGNodeRef node,
     const float ownerWidth,
@@ -4009,10 +4141,10 @@ void YGNodeCalculateLayoutWithContext(
   std::unique_ptr<marker::MarkerSection<YGMarkerLayout>> marker{
       new marker::MarkerSection<YGMarkerLayout>{node}};
 
-  // Increment the generation count. This will force the recursive routine to
+  // Take a new generation count. This will force the recursive routine to
   // visit all dirty nodes at least once. Subsequent visits will be skipped if
   // the input parameters don't change.
-  gCurrentGenerationCount++;
+  YGLayoutPassContext layoutPass{marker->data, ++gCurrentGenerationCount};
   node->resolveDimension();
   float width = YGUndefined;
   YGMeasureMode widthMeasureMode = YGMeasureModeUndefined;
@@ -4066,7 +4198,7 @@ void YGNodeCalculateLayoutWithContext(
           true,
           "initial",
           node->getConfig(),
-          marker->data,
+          layoutPass,
           layoutContext)) {
     node->setPosition(
         node->getLayout().direction, ownerWidth, ownerHeight, ownerWidth);
@@ -4103,10 +4235,11 @@ void YGNodeCalculateLayoutWithContext(
     originalNode->resolveDimension();
     // Recursively mark nodes as dirty
     originalNode->markDirtyAndPropogateDownwards();
-    gCurrentGenerationCount++;
     // Rerun the layout, and calculate the diff
     originalNode->setAndPropogateUseLegacyFlag(false);
     YGMarkerLayoutData layoutMarkerData;
+    YGLayoutPassContext originalLayoutPass{layoutMarkerData,
+                                           ++gCurrentGenerationCount};
     if (YGLayoutNodeInternal(
             originalNode,
             width,
@@ -4119,7 +4252,7 @@ void YGNodeCalculateLayoutWithContext(
             true,
             "initial",
             originalNode->getConfig(),
-            layoutMarkerData,
+            originalLayoutPass,
             layoutContext)) {
       originalNode->setPosition(
           originalNode->getLayout().direction,
@@ -91,6 +91,15 @@ WIN_EXPORT void YGNodeCalculateLayout(
     float availableHeight,
     YGDirection ownerDirection);
 
+// Rounds the layout of a node and its descendants to the pixel grid, as
+// YGNodeCalculateLayout does for the whole tree. `absoluteLeft` and
+// `absoluteTop` are the position of the owner relative to the root, before
+// rounding.
+WIN_EXPORT void YGNodeRoundToPixelGrid(
+    YGNodeRef node,
+    float absoluteLeft,
+    float absoluteTop);
+
 // Mark a node as dirty. Only valid for nodes with a custom measure function
 // set.
 //
@@ -303,6 +312,11 @@ WIN_EXPORT void YGAssertWithConfig(
 WIN_EXPORT void YGConfigSetPointScaleFactor(
     YGConfigRef config,
     float pixelsInPoint);
+// Sets the number of measurements each node keeps cached (at least 1).
+// Only the config of the root node is consulted.
+WIN_EXPORT void YGConfigSetMaxCachedMeasurements(
+    YGConfigRef config,
+    uint32_t maxCachedMeasurements);
 void YGConfigSetShouldDiffLayoutWithoutLegacyStretchBehaviour(
     YGConfigRef config,
     bool shouldDiffLayout);
@@ -40,6 +40,8 @@ ANDROID = "Android"
 
 APPLE = ""
 
+CXX = "Default"
+
 YOGA_TARGET = "//ReactAndroid/src/main/java/com/facebook:yoga"
 
 FBGLOGINIT_TARGET = "//ReactAndroid/src/main/jni/first-party/fbgloginit:fbgloginit"